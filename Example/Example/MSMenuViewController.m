@@ -185,23 +185,25 @@ typedef NS_ENUM(NSUInteger, MSMenuViewControllerTableViewSectionType) {
     
     BOOL animateTransition = self.dynamicsDrawerViewController.paneViewController != nil;
     
+    // Pane view controllers are cached by type, so that switching back to one doesn't rebuild it
+    [self.dynamicsDrawerViewController setPaneViewControllerForKey:@(paneViewControllerType) builder:^UIViewController *{
 #if defined(STORYBOARD)
-    UIViewController *paneViewController = [self.storyboard instantiateViewControllerWithIdentifier:self.paneViewControllerIdentifiers[@(paneViewControllerType)]];
+        UIViewController *paneViewController = [self.storyboard instantiateViewControllerWithIdentifier:self.paneViewControllerIdentifiers[@(paneViewControllerType)]];
 #else
-    Class paneViewControllerClass = self.paneViewControllerClasses[@(paneViewControllerType)];
-    UIViewController *paneViewController = (UIViewController *)[paneViewControllerClass new];
+        Class paneViewControllerClass = self.paneViewControllerClasses[@(paneViewControllerType)];
+        UIViewController *paneViewController = (UIViewController *)[paneViewControllerClass new];
 #endif
-    
-    paneViewController.navigationItem.title = self.paneViewControllerTitles[@(paneViewControllerType)];
-    
-    self.paneRevealLeftBarButtonItem = [[UIBarButtonItem alloc] initWithImage:[UIImage imageNamed:@"Left Reveal Icon"] style:UIBarButtonItemStyleBordered target:self action:@selector(dynamicsDrawerRevealLeftBarButtonItemTapped:)];
-    paneViewController.navigationItem.leftBarButtonItem = self.paneRevealLeftBarButtonItem;
-    
-    self.paneRevealRightBarButtonItem = [[UIBarButtonItem alloc] initWithImage:[UIImage imageNamed:@"Right Reveal Icon"] style:UIBarButtonItemStyleBordered target:self action:@selector(dynamicsDrawerRevealRightBarButtonItemTapped:)];
-    paneViewController.navigationItem.rightBarButtonItem = self.paneRevealRightBarButtonItem;
-    
-    UINavigationController *paneNavigationViewController = [[UINavigationController alloc] initWithRootViewController:paneViewController];
-    [self.dynamicsDrawerViewController setPaneViewController:paneNavigationViewController animated:animateTransition completion:nil];
+        
+        paneViewController.navigationItem.title = self.paneViewControllerTitles[@(paneViewControllerType)];
+        
+        self.paneRevealLeftBarButtonItem = [[UIBarButtonItem alloc] initWithImage:[UIImage imageNamed:@"Left Reveal Icon"] style:UIBarButtonItemStyleBordered target:self action:@selector(dynamicsDrawerRevealLeftBarButtonItemTapped:)];
+        paneViewController.navigationItem.leftBarButtonItem = self.paneRevealLeftBarButtonItem;
+        
+        self.paneRevealRightBarButtonItem = [[UIBarButtonItem alloc] initWithImage:[UIImage imageNamed:@"Right Reveal Icon"] style:UIBarButtonItemStyleBordered target:self action:@selector(dynamicsDrawerRevealRightBarButtonItemTapped:)];
+        paneViewController.navigationItem.rightBarButtonItem = self.paneRevealRightBarButtonItem;
+        
+        return [[UINavigationController alloc] initWithRootViewController:paneViewController];
+    } animated:animateTransition completion:nil];
     
     self.paneViewControllerType = paneViewControllerType;
 }
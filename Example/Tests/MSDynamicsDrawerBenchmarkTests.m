@@ -0,0 +1,145 @@
+//
+//  MSDynamicsDrawerBenchmarkTests.m
+//  MSDynamicsDrawerViewController
+//
+//  Copyright (c) 2013 Monospace Ltd. All rights reserved.
+//
+//  This code is distributed under the terms and conditions of the MIT license.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#import "MSDynamicsDrawerViewController.h"
+
+// The private pane update methods that are benchmarked
+@interface MSDynamicsDrawerViewController (MSDynamicsDrawerBenchmarkTests)
+
+- (void)updateStylers;
+- (MSDynamicsDrawerPaneState)nearestPaneState;
+- (CGRect)paneViewFrameForPanWithStartLocation:(CGPoint)startLocation currentLocation:(CGPoint)currentLocation bounded:(inout BOOL *)bounded;
+
+@end
+
+// The number of pane updates per measurement, roughly ten seconds of dragging at 120 Hz
+static const NSUInteger MSBenchmarkIterationCount = 1200;
+
+// The pan start location of the benchmarked drags, in the coordinate space of the pane view
+static const CGPoint MSBenchmarkPanStartLocation = {20.0, 300.0};
+
+@interface MSDynamicsDrawerBenchmarkTests : XCTestCase
+
+@property (nonatomic, strong) MSDynamicsDrawerViewController *dynamicsDrawerViewController;
+
+@end
+
+@implementation MSDynamicsDrawerBenchmarkTests
+
+#pragma mark - XCTestCase
+
+- (void)setUp
+{
+    [super setUp];
+    
+    // A headless drawer, which is never added to a window
+    self.dynamicsDrawerViewController = [MSDynamicsDrawerViewController new];
+    self.dynamicsDrawerViewController.view.frame = (CGRect){CGPointZero, {320.0, 568.0}};
+    self.dynamicsDrawerViewController.paneViewController = [UIViewController new];
+    [self.dynamicsDrawerViewController setDrawerViewController:[UIViewController new] forDirection:MSDynamicsDrawerDirectionLeft];
+    [self.dynamicsDrawerViewController addStylersFromArray:@[[MSDynamicsDrawerParallaxStyler styler], [MSDynamicsDrawerFadeStyler styler], [MSDynamicsDrawerScaleStyler styler], [MSDynamicsDrawerShadowStyler styler]] forDirection:MSDynamicsDrawerDirectionLeft];
+    [self.dynamicsDrawerViewController setPaneState:MSDynamicsDrawerPaneStateOpen inDirection:MSDynamicsDrawerDirectionLeft];
+}
+
+- (void)tearDown
+{
+    self.dynamicsDrawerViewController = nil;
+    [super tearDown];
+}
+
+#pragma mark - Helpers
+
+// The pane view origin of the iteration at `index`, which sweeps the pane back and forth between closed and open
+- (CGPoint)paneViewOriginForIterationAtIndex:(NSUInteger)index
+{
+    CGFloat revealWidth = [self.dynamicsDrawerViewController revealWidthForDirection:MSDynamicsDrawerDirectionLeft];
+    NSUInteger sweepLength = (NSUInteger)revealWidth;
+    NSUInteger step = (index % (sweepLength * 2));
+    return (CGPoint){((step < sweepLength) ? step : ((sweepLength * 2) - step)), 0.0};
+}
+
+#pragma mark - Benchmarks
+
+- (void)testNearestPaneStatePerformance
+{
+    MSDynamicsDrawerViewController *dynamicsDrawerViewController = self.dynamicsDrawerViewController;
+    dynamicsDrawerViewController.paneView.frame = (CGRect){{200.0, 0.0}, dynamicsDrawerViewController.paneView.frame.size};
+    XCTAssertEqual([dynamicsDrawerViewController nearestPaneState], MSDynamicsDrawerPaneStateOpen);
+    [self measureBlock:^{
+        for (NSUInteger index = 0; index < MSBenchmarkIterationCount; index++) {
+            [dynamicsDrawerViewController nearestPaneState];
+        }
+    }];
+}
+
+- (void)testUpdateStylersPerformance
+{
+    MSDynamicsDrawerViewController *dynamicsDrawerViewController = self.dynamicsDrawerViewController;
+    // With coalescing, moving the pane only marks it as needing an update, so that the explicit update is the only styler update measured
+    dynamicsDrawerViewController.paneUpdateCoalescingEnabled = YES;
+    CGSize paneViewSize = dynamicsDrawerViewController.paneView.frame.size;
+    [self measureBlock:^{
+        for (NSUInteger index = 0; index < MSBenchmarkIterationCount; index++) {
+            dynamicsDrawerViewController.paneView.frame = (CGRect){[self paneViewOriginForIterationAtIndex:index], paneViewSize};
+            [dynamicsDrawerViewController updateStylers];
+        }
+    }];
+    dynamicsDrawerViewController.paneUpdateCoalescingEnabled = NO;
+}
+
+- (void)testPaneViewFrameUpdatePerformance
+{
+    MSDynamicsDrawerViewController *dynamicsDrawerViewController = self.dynamicsDrawerViewController;
+    // Without coalescing, each frame change is observed and updates the stylers synchronously, as when the pane is dragged
+    CGSize paneViewSize = dynamicsDrawerViewController.paneView.frame.size;
+    [self measureBlock:^{
+        for (NSUInteger index = 0; index < MSBenchmarkIterationCount; index++) {
+            dynamicsDrawerViewController.paneView.frame = (CGRect){[self paneViewOriginForIterationAtIndex:index], paneViewSize};
+        }
+    }];
+}
+
+- (void)testPaneViewFrameForPanPerformance
+{
+    MSDynamicsDrawerViewController *dynamicsDrawerViewController = self.dynamicsDrawerViewController;
+    dynamicsDrawerViewController.paneView.frame = (CGRect){CGPointZero, dynamicsDrawerViewController.paneView.frame.size};
+    BOOL bounded;
+    CGRect paneViewFrame = [dynamicsDrawerViewController paneViewFrameForPanWithStartLocation:MSBenchmarkPanStartLocation currentLocation:(CGPoint){120.0, 300.0} bounded:&bounded];
+    XCTAssertEqualWithAccuracy(paneViewFrame.origin.x, 100.0, FLT_EPSILON);
+    XCTAssertFalse(bounded);
+    [self measureBlock:^{
+        for (NSUInteger index = 0; index < MSBenchmarkIterationCount; index++) {
+            CGPoint paneViewOrigin = [self paneViewOriginForIterationAtIndex:index];
+            CGPoint currentLocation = (CGPoint){(MSBenchmarkPanStartLocation.x + paneViewOrigin.x), MSBenchmarkPanStartLocation.y};
+            BOOL iterationBounded;
+            [dynamicsDrawerViewController paneViewFrameForPanWithStartLocation:MSBenchmarkPanStartLocation currentLocation:currentLocation bounded:&iterationBounded];
+        }
+    }];
+}
+
+@end
@@ -0,0 +1,339 @@
+//
+//  MSDynamicsDrawerGeometryTests.m
+//  MSDynamicsDrawerViewController
+//
+//  Copyright (c) 2013 Monospace Ltd. All rights reserved.
+//
+//  This code is distributed under the terms and conditions of the MIT license.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#import "MSDynamicsDrawerViewController.h"
+
+// The size of the pane view in every geometry under test, that of a 4-inch iPhone
+static const CGSize MSTestPaneViewSize = {320.0, 568.0};
+
+// The default `paneStateOpenWideEdgeOffset`
+static const CGFloat MSTestOpenWideEdgeOffset = 20.0;
+
+enum {
+    MSTestDirectionCount = 4,
+    MSTestPaneStateCount = (MSDynamicsDrawerPaneStateOpenWide + 1)
+};
+
+// The cardinal directions, which the pane can move in
+static const MSDynamicsDrawerDirection MSTestDirections[MSTestDirectionCount] = {MSDynamicsDrawerDirectionTop, MSDynamicsDrawerDirectionLeft, MSDynamicsDrawerDirectionBottom, MSDynamicsDrawerDirectionRight};
+
+// A geometry with the default reveal width of `direction`
+static MSDynamicsDrawerGeometry MSTestGeometry(MSDynamicsDrawerDirection direction)
+{
+    CGFloat revealWidth = 0.0;
+    if (direction & MSDynamicsDrawerDirectionHorizontal) {
+        revealWidth = MSDynamicsDrawerDefaultOpenStateRevealWidthHorizontal;
+    } else if (direction & MSDynamicsDrawerDirectionVertical) {
+        revealWidth = MSDynamicsDrawerDefaultOpenStateRevealWidthVertical;
+    }
+    return MSDynamicsDrawerGeometryMake(direction, MSTestPaneViewSize, revealWidth, MSTestOpenWideEdgeOffset);
+}
+
+#define MSAssertEqualPoints(point, expectedPoint) XCTAssertTrue(CGPointEqualToPoint((point), (expectedPoint)), @"%@ is not equal to %@", NSStringFromCGPoint(point), NSStringFromCGPoint(expectedPoint))
+#define MSAssertEqualRects(rect, expectedRect) XCTAssertTrue(CGRectEqualToRect((rect), (expectedRect)), @"%@ is not equal to %@", NSStringFromCGRect(rect), NSStringFromCGRect(expectedRect))
+
+@interface MSDynamicsDrawerGeometryTests : XCTestCase
+
+@end
+
+@implementation MSDynamicsDrawerGeometryTests
+
+#pragma mark - Pane View Origins
+
+- (void)testPaneViewOriginsInHorizontalDirections
+{
+    MSDynamicsDrawerGeometry left = MSTestGeometry(MSDynamicsDrawerDirectionLeft);
+    MSAssertEqualPoints(MSDynamicsDrawerGeometryPaneViewOrigin(left, MSDynamicsDrawerPaneStateClosed), CGPointZero);
+    MSAssertEqualPoints(MSDynamicsDrawerGeometryPaneViewOrigin(left, MSDynamicsDrawerPaneStateOpen), ((CGPoint){267.0, 0.0}));
+    // The pane width plus the edge offset
+    MSAssertEqualPoints(MSDynamicsDrawerGeometryPaneViewOrigin(left, MSDynamicsDrawerPaneStateOpenWide), ((CGPoint){340.0, 0.0}));
+    
+    MSDynamicsDrawerGeometry right = MSTestGeometry(MSDynamicsDrawerDirectionRight);
+    MSAssertEqualPoints(MSDynamicsDrawerGeometryPaneViewOrigin(right, MSDynamicsDrawerPaneStateClosed), CGPointZero);
+    MSAssertEqualPoints(MSDynamicsDrawerGeometryPaneViewOrigin(right, MSDynamicsDrawerPaneStateOpen), ((CGPoint){-267.0, 0.0}));
+    MSAssertEqualPoints(MSDynamicsDrawerGeometryPaneViewOrigin(right, MSDynamicsDrawerPaneStateOpenWide), ((CGPoint){-340.0, 0.0}));
+}
+
+- (void)testPaneViewOriginsInVerticalDirections
+{
+    MSDynamicsDrawerGeometry top = MSTestGeometry(MSDynamicsDrawerDirectionTop);
+    MSAssertEqualPoints(MSDynamicsDrawerGeometryPaneViewOrigin(top, MSDynamicsDrawerPaneStateClosed), CGPointZero);
+    MSAssertEqualPoints(MSDynamicsDrawerGeometryPaneViewOrigin(top, MSDynamicsDrawerPaneStateOpen), ((CGPoint){0.0, 300.0}));
+    // The pane height plus the edge offset
+    MSAssertEqualPoints(MSDynamicsDrawerGeometryPaneViewOrigin(top, MSDynamicsDrawerPaneStateOpenWide), ((CGPoint){0.0, 588.0}));
+    
+    MSDynamicsDrawerGeometry bottom = MSTestGeometry(MSDynamicsDrawerDirectionBottom);
+    MSAssertEqualPoints(MSDynamicsDrawerGeometryPaneViewOrigin(bottom, MSDynamicsDrawerPaneStateClosed), CGPointZero);
+    MSAssertEqualPoints(MSDynamicsDrawerGeometryPaneViewOrigin(bottom, MSDynamicsDrawerPaneStateOpen), ((CGPoint){0.0, -300.0}));
+    MSAssertEqualPoints(MSDynamicsDrawerGeometryPaneViewOrigin(bottom, MSDynamicsDrawerPaneStateOpenWide), ((CGPoint){0.0, -588.0}));
+}
+
+- (void)testPaneViewOriginsWithoutDirection
+{
+    MSDynamicsDrawerGeometry none = MSTestGeometry(MSDynamicsDrawerDirectionNone);
+    for (MSDynamicsDrawerPaneState paneState = MSDynamicsDrawerPaneStateClosed; paneState <= MSDynamicsDrawerPaneStateOpenWide; paneState++) {
+        MSAssertEqualPoints(MSDynamicsDrawerGeometryPaneViewOrigin(none, paneState), CGPointZero);
+    }
+}
+
+#pragma mark - Pane Closed Fraction
+
+- (void)testPaneClosedFractionIsClampedInHorizontalDirections
+{
+    MSDynamicsDrawerGeometry left = MSTestGeometry(MSDynamicsDrawerDirectionLeft);
+    XCTAssertEqualWithAccuracy(MSDynamicsDrawerGeometryPaneClosedFraction(left, CGPointZero), 1.0, FLT_EPSILON);
+    XCTAssertEqualWithAccuracy(MSDynamicsDrawerGeometryPaneClosedFraction(left, ((CGPoint){133.5, 0.0})), 0.5, FLT_EPSILON);
+    XCTAssertEqualWithAccuracy(MSDynamicsDrawerGeometryPaneClosedFraction(left, ((CGPoint){267.0, 0.0})), 0.0, FLT_EPSILON);
+    // Past the closed and open origins
+    XCTAssertEqualWithAccuracy(MSDynamicsDrawerGeometryPaneClosedFraction(left, ((CGPoint){-10.0, 0.0})), 1.0, FLT_EPSILON);
+    XCTAssertEqualWithAccuracy(MSDynamicsDrawerGeometryPaneClosedFraction(left, ((CGPoint){340.0, 0.0})), 0.0, FLT_EPSILON);
+    // Only the axis of the direction contributes
+    XCTAssertEqualWithAccuracy(MSDynamicsDrawerGeometryPaneClosedFraction(left, ((CGPoint){133.5, 50.0})), 0.5, FLT_EPSILON);
+    
+    MSDynamicsDrawerGeometry right = MSTestGeometry(MSDynamicsDrawerDirectionRight);
+    XCTAssertEqualWithAccuracy(MSDynamicsDrawerGeometryPaneClosedFraction(right, CGPointZero), 1.0, FLT_EPSILON);
+    XCTAssertEqualWithAccuracy(MSDynamicsDrawerGeometryPaneClosedFraction(right, ((CGPoint){-133.5, 0.0})), 0.5, FLT_EPSILON);
+    XCTAssertEqualWithAccuracy(MSDynamicsDrawerGeometryPaneClosedFraction(right, ((CGPoint){-267.0, 0.0})), 0.0, FLT_EPSILON);
+    XCTAssertEqualWithAccuracy(MSDynamicsDrawerGeometryPaneClosedFraction(right, ((CGPoint){10.0, 0.0})), 1.0, FLT_EPSILON);
+    XCTAssertEqualWithAccuracy(MSDynamicsDrawerGeometryPaneClosedFraction(right, ((CGPoint){-340.0, 0.0})), 0.0, FLT_EPSILON);
+}
+
+- (void)testPaneClosedFractionIsClampedInVerticalDirections
+{
+    MSDynamicsDrawerGeometry top = MSTestGeometry(MSDynamicsDrawerDirectionTop);
+    XCTAssertEqualWithAccuracy(MSDynamicsDrawerGeometryPaneClosedFraction(top, CGPointZero), 1.0, FLT_EPSILON);
+    XCTAssertEqualWithAccuracy(MSDynamicsDrawerGeometryPaneClosedFraction(top, ((CGPoint){0.0, 75.0})), 0.75, FLT_EPSILON);
+    XCTAssertEqualWithAccuracy(MSDynamicsDrawerGeometryPaneClosedFraction(top, ((CGPoint){0.0, 300.0})), 0.0, FLT_EPSILON);
+    XCTAssertEqualWithAccuracy(MSDynamicsDrawerGeometryPaneClosedFraction(top, ((CGPoint){0.0, -10.0})), 1.0, FLT_EPSILON);
+    XCTAssertEqualWithAccuracy(MSDynamicsDrawerGeometryPaneClosedFraction(top, ((CGPoint){0.0, 588.0})), 0.0, FLT_EPSILON);
+    
+    MSDynamicsDrawerGeometry bottom = MSTestGeometry(MSDynamicsDrawerDirectionBottom);
+    XCTAssertEqualWithAccuracy(MSDynamicsDrawerGeometryPaneClosedFraction(bottom, CGPointZero), 1.0, FLT_EPSILON);
+    XCTAssertEqualWithAccuracy(MSDynamicsDrawerGeometryPaneClosedFraction(bottom, ((CGPoint){0.0, -75.0})), 0.75, FLT_EPSILON);
+    XCTAssertEqualWithAccuracy(MSDynamicsDrawerGeometryPaneClosedFraction(bottom, ((CGPoint){0.0, -300.0})), 0.0, FLT_EPSILON);
+    XCTAssertEqualWithAccuracy(MSDynamicsDrawerGeometryPaneClosedFraction(bottom, ((CGPoint){0.0, 10.0})), 1.0, FLT_EPSILON);
+    XCTAssertEqualWithAccuracy(MSDynamicsDrawerGeometryPaneClosedFraction(bottom, ((CGPoint){0.0, -588.0})), 0.0, FLT_EPSILON);
+}
+
+- (void)testPaneClosedFractionWithoutDirection
+{
+    // The pane is always closed without a direction
+    MSDynamicsDrawerGeometry none = MSTestGeometry(MSDynamicsDrawerDirectionNone);
+    XCTAssertEqualWithAccuracy(MSDynamicsDrawerGeometryPaneClosedFraction(none, CGPointZero), 1.0, FLT_EPSILON);
+    XCTAssertEqualWithAccuracy(MSDynamicsDrawerGeometryPaneClosedFraction(none, ((CGPoint){133.5, 75.0})), 1.0, FLT_EPSILON);
+}
+
+#pragma mark - Current Reveal Width
+
+- (void)testCurrentRevealWidth
+{
+    XCTAssertEqualWithAccuracy(MSDynamicsDrawerGeometryCurrentRevealWidth(MSTestGeometry(MSDynamicsDrawerDirectionLeft), ((CGPoint){100.0, 20.0})), 100.0, FLT_EPSILON);
+    XCTAssertEqualWithAccuracy(MSDynamicsDrawerGeometryCurrentRevealWidth(MSTestGeometry(MSDynamicsDrawerDirectionRight), ((CGPoint){-100.0, 20.0})), 100.0, FLT_EPSILON);
+    XCTAssertEqualWithAccuracy(MSDynamicsDrawerGeometryCurrentRevealWidth(MSTestGeometry(MSDynamicsDrawerDirectionTop), ((CGPoint){20.0, 50.0})), 50.0, FLT_EPSILON);
+    XCTAssertEqualWithAccuracy(MSDynamicsDrawerGeometryCurrentRevealWidth(MSTestGeometry(MSDynamicsDrawerDirectionBottom), ((CGPoint){20.0, -50.0})), 50.0, FLT_EPSILON);
+    // Unlike the closed fraction, the reveal width isn't clamped to the open origin
+    XCTAssertEqualWithAccuracy(MSDynamicsDrawerGeometryCurrentRevealWidth(MSTestGeometry(MSDynamicsDrawerDirectionLeft), ((CGPoint){340.0, 0.0})), 340.0, FLT_EPSILON);
+    XCTAssertEqualWithAccuracy(MSDynamicsDrawerGeometryCurrentRevealWidth(MSTestGeometry(MSDynamicsDrawerDirectionNone), ((CGPoint){100.0, 50.0})), 0.0, FLT_EPSILON);
+}
+
+#pragma mark - Pane State At Pane View Origin
+
+- (void)testPaneStateAtPaneViewOriginMatchesWithinEpsilon
+{
+    MSDynamicsDrawerGeometry left = MSTestGeometry(MSDynamicsDrawerDirectionLeft);
+    MSDynamicsDrawerPaneState paneState = NSIntegerMax;
+    XCTAssertTrue(MSDynamicsDrawerGeometryPaneStateAtPaneViewOrigin(left, CGPointZero, &paneState));
+    XCTAssertEqual(paneState, MSDynamicsDrawerPaneStateClosed);
+    XCTAssertTrue(MSDynamicsDrawerGeometryPaneStateAtPaneViewOrigin(left, ((CGPoint){267.0, 0.0}), &paneState));
+    XCTAssertEqual(paneState, MSDynamicsDrawerPaneStateOpen);
+    XCTAssertTrue(MSDynamicsDrawerGeometryPaneStateAtPaneViewOrigin(left, ((CGPoint){340.0, 0.0}), &paneState));
+    XCTAssertEqual(paneState, MSDynamicsDrawerPaneStateOpenWide);
+    // 268.4 and 265.6 round to within a point of the open origin
+    XCTAssertTrue(MSDynamicsDrawerGeometryPaneStateAtPaneViewOrigin(left, ((CGPoint){268.4, 0.0}), &paneState));
+    XCTAssertEqual(paneState, MSDynamicsDrawerPaneStateOpen);
+    XCTAssertTrue(MSDynamicsDrawerGeometryPaneStateAtPaneViewOrigin(left, ((CGPoint){265.6, 0.0}), &paneState));
+    XCTAssertEqual(paneState, MSDynamicsDrawerPaneStateOpen);
+    XCTAssertTrue(MSDynamicsDrawerGeometryPaneStateAtPaneViewOrigin(left, ((CGPoint){267.0, 1.4}), &paneState));
+    XCTAssertEqual(paneState, MSDynamicsDrawerPaneStateOpen);
+    // The pane state is optional
+    XCTAssertTrue(MSDynamicsDrawerGeometryPaneStateAtPaneViewOrigin(left, ((CGPoint){0.4, 0.0}), NULL));
+}
+
+- (void)testPaneStateAtPaneViewOriginDoesNotMatchAtEpsilon
+{
+    MSDynamicsDrawerGeometry left = MSTestGeometry(MSDynamicsDrawerDirectionLeft);
+    MSDynamicsDrawerPaneState paneState = NSIntegerMax;
+    // Each of these rounds to exactly two points from the open origin, which is outside of the epsilon
+    XCTAssertFalse(MSDynamicsDrawerGeometryPaneStateAtPaneViewOrigin(left, ((CGPoint){269.0, 0.0}), &paneState));
+    XCTAssertFalse(MSDynamicsDrawerGeometryPaneStateAtPaneViewOrigin(left, ((CGPoint){268.5, 0.0}), &paneState));
+    XCTAssertFalse(MSDynamicsDrawerGeometryPaneStateAtPaneViewOrigin(left, ((CGPoint){265.4, 0.0}), &paneState));
+    XCTAssertFalse(MSDynamicsDrawerGeometryPaneStateAtPaneViewOrigin(left, ((CGPoint){267.0, 1.5}), &paneState));
+    XCTAssertFalse(MSDynamicsDrawerGeometryPaneStateAtPaneViewOrigin(left, ((CGPoint){1.5, 0.0}), &paneState));
+    // Between pane states
+    XCTAssertFalse(MSDynamicsDrawerGeometryPaneStateAtPaneViewOrigin(left, ((CGPoint){133.5, 0.0}), &paneState));
+    // An unmatched pane state is left untouched
+    XCTAssertEqual(paneState, (MSDynamicsDrawerPaneState)NSIntegerMax);
+}
+
+- (void)testPaneStateAtPaneViewOriginInOtherDirections
+{
+    MSDynamicsDrawerPaneState paneState = NSIntegerMax;
+    XCTAssertTrue(MSDynamicsDrawerGeometryPaneStateAtPaneViewOrigin(MSTestGeometry(MSDynamicsDrawerDirectionRight), ((CGPoint){-268.4, 0.0}), &paneState));
+    XCTAssertEqual(paneState, MSDynamicsDrawerPaneStateOpen);
+    XCTAssertTrue(MSDynamicsDrawerGeometryPaneStateAtPaneViewOrigin(MSTestGeometry(MSDynamicsDrawerDirectionTop), ((CGPoint){0.0, 588.6}), &paneState));
+    XCTAssertEqual(paneState, MSDynamicsDrawerPaneStateOpenWide);
+    XCTAssertTrue(MSDynamicsDrawerGeometryPaneStateAtPaneViewOrigin(MSTestGeometry(MSDynamicsDrawerDirectionBottom), ((CGPoint){0.0, -299.0}), &paneState));
+    XCTAssertEqual(paneState, MSDynamicsDrawerPaneStateOpen);
+    // Without a direction, every pane state is at the closed origin, so the pane is closed
+    XCTAssertTrue(MSDynamicsDrawerGeometryPaneStateAtPaneViewOrigin(MSTestGeometry(MSDynamicsDrawerDirectionNone), CGPointZero, &paneState));
+    XCTAssertEqual(paneState, MSDynamicsDrawerPaneStateClosed);
+    XCTAssertFalse(MSDynamicsDrawerGeometryPaneStateAtPaneViewOrigin(MSTestGeometry(MSDynamicsDrawerDirectionNone), ((CGPoint){2.0, 0.0}), &paneState));
+}
+
+#pragma mark - Nearest Pane State
+
+- (void)testNearestPaneStateInHorizontalDirections
+{
+    MSDynamicsDrawerGeometry left = MSTestGeometry(MSDynamicsDrawerDirectionLeft);
+    XCTAssertEqual(MSDynamicsDrawerGeometryNearestPaneState(left, ((CGPoint){-50.0, 0.0})), MSDynamicsDrawerPaneStateClosed);
+    XCTAssertEqual(MSDynamicsDrawerGeometryNearestPaneState(left, ((CGPoint){133.0, 0.0})), MSDynamicsDrawerPaneStateClosed);
+    XCTAssertEqual(MSDynamicsDrawerGeometryNearestPaneState(left, ((CGPoint){134.0, 0.0})), MSDynamicsDrawerPaneStateOpen);
+    // The midpoint between closed and open rounds towards open
+    XCTAssertEqual(MSDynamicsDrawerGeometryNearestPaneState(left, ((CGPoint){133.5, 0.0})), MSDynamicsDrawerPaneStateOpen);
+    // The midpoint between open (267) and open wide (340) is 303.5
+    XCTAssertEqual(MSDynamicsDrawerGeometryNearestPaneState(left, ((CGPoint){303.4, 0.0})), MSDynamicsDrawerPaneStateOpen);
+    XCTAssertEqual(MSDynamicsDrawerGeometryNearestPaneState(left, ((CGPoint){303.6, 0.0})), MSDynamicsDrawerPaneStateOpenWide);
+    XCTAssertEqual(MSDynamicsDrawerGeometryNearestPaneState(left, ((CGPoint){500.0, 0.0})), MSDynamicsDrawerPaneStateOpenWide);
+    // An offset across the axis is shared by the distances to every pane state, so it doesn't change the nearest one
+    XCTAssertEqual(MSDynamicsDrawerGeometryNearestPaneState(left, ((CGPoint){200.0, 100.0})), MSDynamicsDrawerPaneStateOpen);
+    
+    MSDynamicsDrawerGeometry right = MSTestGeometry(MSDynamicsDrawerDirectionRight);
+    XCTAssertEqual(MSDynamicsDrawerGeometryNearestPaneState(right, ((CGPoint){-133.0, 0.0})), MSDynamicsDrawerPaneStateClosed);
+    XCTAssertEqual(MSDynamicsDrawerGeometryNearestPaneState(right, ((CGPoint){-134.0, 0.0})), MSDynamicsDrawerPaneStateOpen);
+    XCTAssertEqual(MSDynamicsDrawerGeometryNearestPaneState(right, ((CGPoint){-303.0, 0.0})), MSDynamicsDrawerPaneStateOpen);
+    XCTAssertEqual(MSDynamicsDrawerGeometryNearestPaneState(right, ((CGPoint){-304.0, 0.0})), MSDynamicsDrawerPaneStateOpenWide);
+    // Positions past the closed origin are nearest to closed
+    XCTAssertEqual(MSDynamicsDrawerGeometryNearestPaneState(right, ((CGPoint){50.0, 0.0})), MSDynamicsDrawerPaneStateClosed);
+}
+
+- (void)testNearestPaneStateBreaksTiesTowardsTheLessOpenPaneState
+{
+    // The top drawer opens to 300 and opens wide to 588, so 150 and 444 are equidistant from two pane states
+    MSDynamicsDrawerGeometry top = MSTestGeometry(MSDynamicsDrawerDirectionTop);
+    XCTAssertEqual(MSDynamicsDrawerGeometryNearestPaneState(top, ((CGPoint){0.0, 150.0})), MSDynamicsDrawerPaneStateClosed);
+    XCTAssertEqual(MSDynamicsDrawerGeometryNearestPaneState(top, ((CGPoint){0.0, 151.0})), MSDynamicsDrawerPaneStateOpen);
+    XCTAssertEqual(MSDynamicsDrawerGeometryNearestPaneState(top, ((CGPoint){0.0, 444.0})), MSDynamicsDrawerPaneStateOpen);
+    XCTAssertEqual(MSDynamicsDrawerGeometryNearestPaneState(top, ((CGPoint){0.0, 445.0})), MSDynamicsDrawerPaneStateOpenWide);
+    
+    MSDynamicsDrawerGeometry bottom = MSTestGeometry(MSDynamicsDrawerDirectionBottom);
+    XCTAssertEqual(MSDynamicsDrawerGeometryNearestPaneState(bottom, ((CGPoint){0.0, -150.0})), MSDynamicsDrawerPaneStateClosed);
+    XCTAssertEqual(MSDynamicsDrawerGeometryNearestPaneState(bottom, ((CGPoint){0.0, -444.0})), MSDynamicsDrawerPaneStateOpen);
+    XCTAssertEqual(MSDynamicsDrawerGeometryNearestPaneState(bottom, ((CGPoint){0.0, -445.0})), MSDynamicsDrawerPaneStateOpenWide);
+}
+
+- (void)testNearestPaneStateWithoutDirection
+{
+    MSDynamicsDrawerGeometry none = MSTestGeometry(MSDynamicsDrawerDirectionNone);
+    XCTAssertEqual(MSDynamicsDrawerGeometryNearestPaneState(none, ((CGPoint){300.0, 0.0})), MSDynamicsDrawerPaneStateClosed);
+    XCTAssertEqual(MSDynamicsDrawerGeometryNearestPaneState(none, ((CGPoint){0.0, -600.0})), MSDynamicsDrawerPaneStateClosed);
+}
+
+#pragma mark - Boundary
+
+- (void)testBoundaryForPaneState
+{
+    // A point of slack on either side, spanning from the closed pane to the pane in the pane state along the axis
+    MSAssertEqualRects(MSDynamicsDrawerGeometryBoundaryForPaneState(MSTestGeometry(MSDynamicsDrawerDirectionLeft), MSDynamicsDrawerPaneStateOpen), ((CGRect){{-1.0, -1.0}, {589.0, 569.0}}));
+    MSAssertEqualRects(MSDynamicsDrawerGeometryBoundaryForPaneState(MSTestGeometry(MSDynamicsDrawerDirectionLeft), MSDynamicsDrawerPaneStateOpenWide), ((CGRect){{-1.0, -1.0}, {662.0, 569.0}}));
+    MSAssertEqualRects(MSDynamicsDrawerGeometryBoundaryForPaneState(MSTestGeometry(MSDynamicsDrawerDirectionRight), MSDynamicsDrawerPaneStateOpen), ((CGRect){{-268.0, -1.0}, {589.0, 569.0}}));
+    MSAssertEqualRects(MSDynamicsDrawerGeometryBoundaryForPaneState(MSTestGeometry(MSDynamicsDrawerDirectionTop), MSDynamicsDrawerPaneStateOpen), ((CGRect){{-1.0, -1.0}, {321.0, 870.0}}));
+    MSAssertEqualRects(MSDynamicsDrawerGeometryBoundaryForPaneState(MSTestGeometry(MSDynamicsDrawerDirectionBottom), MSDynamicsDrawerPaneStateOpen), ((CGRect){{-1.0, -301.0}, {321.0, 870.0}}));
+    MSAssertEqualRects(MSDynamicsDrawerGeometryBoundaryForPaneState(MSTestGeometry(MSDynamicsDrawerDirectionNone), MSDynamicsDrawerPaneStateOpen), CGRectZero);
+}
+
+#pragma mark - Layout
+
+- (void)testLayout
+{
+    MSDynamicsDrawerLayout layout = MSDynamicsDrawerGeometryLayout(MSTestGeometry(MSDynamicsDrawerDirectionLeft), ((CGPoint){133.5, 0.0}), YES);
+    XCTAssertEqual(layout.direction, MSDynamicsDrawerDirectionLeft);
+    MSAssertEqualRects(layout.paneViewFrame, ((CGRect){{133.5, 0.0}, MSTestPaneViewSize}));
+    XCTAssertEqualWithAccuracy(layout.paneClosedFraction, 0.5, FLT_EPSILON);
+    XCTAssertEqualWithAccuracy(layout.revealWidth, 267.0, FLT_EPSILON);
+    XCTAssertEqualWithAccuracy(layout.currentRevealWidth, 133.5, FLT_EPSILON);
+    MSAssertEqualPoints(layout.closedPaneViewOrigin, CGPointZero);
+    MSAssertEqualPoints(layout.openPaneViewOrigin, ((CGPoint){267.0, 0.0}));
+    MSAssertEqualPoints(layout.openWidePaneViewOrigin, ((CGPoint){340.0, 0.0}));
+    XCTAssertTrue(layout.paneViewResting);
+    
+    XCTAssertFalse(MSDynamicsDrawerGeometryLayout(MSTestGeometry(MSDynamicsDrawerDirectionLeft), CGPointZero, NO).paneViewResting);
+}
+
+#pragma mark - Threading
+
+- (void)testGeometryOffTheMainThread
+{
+    // Every pane state of every direction, resolved from its own origin concurrently on a background queue
+    BOOL resolvedPaneStateStorage[MSTestDirectionCount * MSTestPaneStateCount] = {NO};
+    BOOL *resolvedPaneStates = resolvedPaneStateStorage;
+    dispatch_apply((MSTestDirectionCount * MSTestPaneStateCount), dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t index) {
+        MSDynamicsDrawerGeometry geometry = MSTestGeometry(MSTestDirections[index / MSTestPaneStateCount]);
+        MSDynamicsDrawerPaneState paneState = (MSDynamicsDrawerPaneState)(index % MSTestPaneStateCount);
+        CGPoint paneViewOrigin = MSDynamicsDrawerGeometryPaneViewOrigin(geometry, paneState);
+        CGFloat expectedPaneClosedFraction = ((paneState == MSDynamicsDrawerPaneStateClosed) ? 1.0 : 0.0);
+        resolvedPaneStates[index] = ((MSDynamicsDrawerGeometryNearestPaneState(geometry, paneViewOrigin) == paneState) && (MSDynamicsDrawerGeometryLayout(geometry, paneViewOrigin, YES).paneClosedFraction == expectedPaneClosedFraction));
+    });
+    for (size_t index = 0; index < (MSTestDirectionCount * MSTestPaneStateCount); index++) {
+        XCTAssertTrue(resolvedPaneStates[index], @"Pane state %ld in direction %ld wasn't resolved", (long)(index % MSTestPaneStateCount), (long)MSTestDirections[index / MSTestPaneStateCount]);
+    }
+}
+
+#pragma mark - MSDynamicsDrawerViewController
+
+- (void)testDynamicsDrawerViewControllerGeometry
+{
+    MSDynamicsDrawerViewController *dynamicsDrawerViewController = [MSDynamicsDrawerViewController new];
+    dynamicsDrawerViewController.view.frame = (CGRect){CGPointZero, MSTestPaneViewSize};
+    dynamicsDrawerViewController.paneViewController = [UIViewController new];
+    [dynamicsDrawerViewController setDrawerViewController:[UIViewController new] forDirection:MSDynamicsDrawerDirectionLeft];
+    [dynamicsDrawerViewController setRevealWidth:200.0 forDirection:MSDynamicsDrawerDirectionLeft];
+    dynamicsDrawerViewController.paneStateOpenWideEdgeOffset = 10.0;
+    
+    MSDynamicsDrawerGeometry geometry = [dynamicsDrawerViewController geometryForDirection:MSDynamicsDrawerDirectionLeft];
+    XCTAssertEqual(geometry.direction, MSDynamicsDrawerDirectionLeft);
+    XCTAssertTrue(CGSizeEqualToSize(geometry.paneViewSize, MSTestPaneViewSize), @"%@", NSStringFromCGSize(geometry.paneViewSize));
+    XCTAssertEqualWithAccuracy(geometry.revealWidth, 200.0, FLT_EPSILON);
+    XCTAssertEqualWithAccuracy(geometry.openWideEdgeOffset, 10.0, FLT_EPSILON);
+    
+    // The pane is positioned from the same geometry
+    [dynamicsDrawerViewController setPaneState:MSDynamicsDrawerPaneStateOpen inDirection:MSDynamicsDrawerDirectionLeft];
+    MSAssertEqualPoints(dynamicsDrawerViewController.paneView.frame.origin, MSDynamicsDrawerGeometryPaneViewOrigin(geometry, MSDynamicsDrawerPaneStateOpen));
+    XCTAssertEqualWithAccuracy([dynamicsDrawerViewController currentRevealWidth], 200.0, FLT_EPSILON);
+}
+
+@end
@@ -0,0 +1,539 @@
+//
+//  MSDynamicsDrawerGestureReplayTests.m
+//  MSDynamicsDrawerViewController
+//
+//  Copyright (c) 2013 Monospace Ltd. All rights reserved.
+//
+//  This code is distributed under the terms and conditions of the MIT license.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#import "MSDynamicsDrawerViewController.h"
+
+// Declared in MSDynamicsDrawerViewController.m, which is compiled into this bundle
+@interface MSDynamicsDrawerPanGestureRecognizer : UIPanGestureRecognizer
+
+@property (nonatomic, assign) BOOL capturesCoalescedAndPredictedTouches;
+@property (nonatomic, assign, readonly) NSTimeInterval latestTouchTimestamp;
+@property (nonatomic, copy, readonly) NSArray *coalescedTouches;
+@property (nonatomic, copy, readonly) NSArray *predictedTouches;
+
+@end
+
+// The private pan handling that traces are replayed through
+@interface MSDynamicsDrawerViewController (MSDynamicsDrawerGestureReplayTests)
+
+@property (nonatomic, strong) MSDynamicsDrawerPanGestureRecognizer *panePanGestureRecognizer;
+
+- (void)panePanned:(MSDynamicsDrawerPanGestureRecognizer *)gestureRecognizer;
+
+@end
+
+// The private frame recording that hitches are measured by
+@interface MSDynamicsDrawerTransitionMetrics (MSDynamicsDrawerGestureReplayTests)
+
+- (instancetype)initWithKind:(MSDynamicsDrawerTransitionKind)kind direction:(MSDynamicsDrawerDirection)direction startTimestamp:(CFTimeInterval)startTimestamp;
+- (void)recordFrameAtTimestamp:(CFTimeInterval)timestamp refreshInterval:(CFTimeInterval)refreshInterval;
+
+@end
+
+// Trace sample timestamps are relative to the start of the trace, and are offset by this so that they're never mistaken for a missing touch timestamp
+static const NSTimeInterval MSReplayTimestampOrigin = 1000.0;
+
+#pragma mark - MSReplayPanGestureRecognizer
+
+// Reports the state, location, and timestamp of the trace sample being replayed, in place of those of real touches
+@interface MSReplayPanGestureRecognizer : MSDynamicsDrawerPanGestureRecognizer
+
+// The view that the replayed locations are in the coordinate space of
+@property (nonatomic, weak) UIView *referenceView;
+@property (nonatomic, assign) UIGestureRecognizerState replayState;
+@property (nonatomic, assign) CGPoint replayLocation;
+@property (nonatomic, assign) NSTimeInterval replayTimestamp;
+
+@end
+
+@implementation MSReplayPanGestureRecognizer
+
+- (UIGestureRecognizerState)state
+{
+    return self.replayState;
+}
+
+- (CGPoint)locationInView:(UIView *)view
+{
+    return [self.referenceView convertPoint:self.replayLocation toView:view];
+}
+
+- (NSTimeInterval)latestTouchTimestamp
+{
+    return self.replayTimestamp;
+}
+
+- (NSArray *)coalescedTouches
+{
+    return nil;
+}
+
+- (NSArray *)predictedTouches
+{
+    return nil;
+}
+
+@end
+
+#pragma mark - MSReplayPaneMotionEngine
+
+// Records the motion that the pane is brought to rest with, and only performs it when told to, so that replays are deterministic
+@interface MSReplayPaneMotionEngine : NSObject <MSDynamicsDrawerPaneMotionEngine>
+
+@property (nonatomic, weak) id <MSDynamicsDrawerPaneMotionEngineDelegate> delegate;
+@property (nonatomic, readonly, getter = isRunning) BOOL running;
+@property (nonatomic, assign, readonly) MSDynamicsDrawerPaneMotion motion;
+@property (nonatomic, assign, readonly) NSUInteger motionCount;
+
+// Moves the pane view to the target of the running motion, bringing it to rest
+- (void)finishMotion;
+
+@end
+
+@interface MSReplayPaneMotionEngine ()
+
+@property (nonatomic, readwrite, getter = isRunning) BOOL running;
+@property (nonatomic, assign, readwrite) MSDynamicsDrawerPaneMotion motion;
+@property (nonatomic, assign, readwrite) NSUInteger motionCount;
+@property (nonatomic, weak) UIView *paneView;
+
+@end
+
+@implementation MSReplayPaneMotionEngine
+
+- (void)beginMotion:(MSDynamicsDrawerPaneMotion)motion ofPaneView:(UIView *)paneView inReferenceView:(UIView *)referenceView
+{
+    self.motion = motion;
+    self.motionCount++;
+    self.paneView = paneView;
+    self.running = YES;
+}
+
+- (void)stopMotion
+{
+    if (!self.running) {
+        return;
+    }
+    self.running = NO;
+    [self.delegate paneMotionEngineDidComeToRest:self];
+}
+
+- (void)finishMotion
+{
+    NSAssert(self.running, @"Unable to finish a motion when none is running");
+    self.paneView.frame = (CGRect){self.motion.targetPaneViewOrigin, self.paneView.frame.size};
+    [self.delegate paneMotionEngineDidUpdatePaneView:self];
+    self.running = NO;
+    [self.delegate paneMotionEngineDidComeToRest:self];
+}
+
+@end
+
+#pragma mark - MSDynamicsDrawerGestureReplayTests
+
+/*
+ Replays recorded pan traces through `panePanned:`, as the pane pan gesture recognizer would deliver them.
+ 
+ A trace is a JSON fixture in the `Fixtures` directory:
+ 
+     {
+         "description": "What the trace records",
+         "initialPaneState": "closed" | "open",
+         "samples": [
+             {"state": "began" | "changed" | "ended" | "cancelled", "t": 0.0, "x": 20.0, "y": 300.0},
+             ...
+         ]
+     }
+ 
+ Each sample is a touch delivered to the pan gesture recognizer. `t` is its timestamp (in seconds) relative to the start of the trace, and `x` and `y` are its location in the coordinate space of the drawer view controller's view, which is 320 × 568 points. Traces are replayed against a left drawer that starts in `initialPaneState`.
+ 
+ Traces recorded on a device by `MSDynamicsDrawerGestureRecorder` are `.mstrace` fixtures in the same directory, and are replayed in the same way.
+ */
+@interface MSDynamicsDrawerGestureReplayTests : XCTestCase <MSDynamicsDrawerViewControllerDelegate>
+
+@property (nonatomic, strong) MSDynamicsDrawerViewController *dynamicsDrawerViewController;
+@property (nonatomic, strong) MSReplayPanGestureRecognizer *panGestureRecognizer;
+@property (nonatomic, strong) MSReplayPaneMotionEngine *paneMotionEngine;
+// The pane states that the delegate was informed that the pane may update to, as `@[paneState, direction]` pairs
+@property (nonatomic, strong) NSMutableArray *mayUpdatePaneStates;
+
+@end
+
+@implementation MSDynamicsDrawerGestureReplayTests
+
+#pragma mark - XCTestCase
+
+- (void)setUp
+{
+    [super setUp];
+    
+    // A headless drawer, which is never added to a window
+    self.dynamicsDrawerViewController = [MSDynamicsDrawerViewController new];
+    self.dynamicsDrawerViewController.view.frame = (CGRect){CGPointZero, {320.0, 568.0}};
+    self.dynamicsDrawerViewController.paneViewController = [UIViewController new];
+    [self.dynamicsDrawerViewController setDrawerViewController:[UIViewController new] forDirection:MSDynamicsDrawerDirectionLeft];
+    [self.dynamicsDrawerViewController addStylersFromArray:@[[MSDynamicsDrawerParallaxStyler styler], [MSDynamicsDrawerFadeStyler styler], [MSDynamicsDrawerScaleStyler styler], [MSDynamicsDrawerShadowStyler styler]] forDirection:MSDynamicsDrawerDirectionLeft];
+    self.dynamicsDrawerViewController.delegate = self;
+    
+    self.paneMotionEngine = [MSReplayPaneMotionEngine new];
+    self.dynamicsDrawerViewController.paneMotionEngine = self.paneMotionEngine;
+    
+    // Stands in for the pane pan gesture recognizer, so that the drawer considers the pane to be dragged while a trace is replayed
+    self.panGestureRecognizer = [[MSReplayPanGestureRecognizer alloc] initWithTarget:nil action:NULL];
+    self.panGestureRecognizer.referenceView = self.dynamicsDrawerViewController.view;
+    self.dynamicsDrawerViewController.panePanGestureRecognizer = self.panGestureRecognizer;
+    
+    self.mayUpdatePaneStates = [NSMutableArray new];
+}
+
+- (void)tearDown
+{
+    self.dynamicsDrawerViewController = nil;
+    self.panGestureRecognizer = nil;
+    self.paneMotionEngine = nil;
+    [super tearDown];
+}
+
+#pragma mark - Replay
+
+- (NSData *)fixtureNamed:(NSString *)name extension:(NSString *)extension
+{
+    NSURL *fixtureURL = [[NSBundle bundleForClass:[self class]] URLForResource:name withExtension:extension];
+    XCTAssertNotNil(fixtureURL, @"Missing trace fixture %@.%@", name, extension);
+    return (fixtureURL ? [NSData dataWithContentsOfURL:fixtureURL] : nil);
+}
+
+// Returns the samples of a JSON trace fixture as boxed `MSDynamicsDrawerGestureTraceSample` values
+- (NSArray *)samplesOfTraceNamed:(NSString *)name initialPaneState:(MSDynamicsDrawerPaneState *)initialPaneState
+{
+    NSData *traceData = [self fixtureNamed:name extension:@"json"];
+    NSError *error;
+    NSDictionary *trace = (traceData ? [NSJSONSerialization JSONObjectWithData:traceData options:0 error:&error] : nil);
+    XCTAssertNotNil(trace, @"Unable to read trace fixture %@: %@", name, error);
+    
+    *initialPaneState = ([trace[@"initialPaneState"] isEqualToString:@"open"] ? MSDynamicsDrawerPaneStateOpen : MSDynamicsDrawerPaneStateClosed);
+    NSDictionary *states = @{
+        @"began" : @(UIGestureRecognizerStateBegan),
+        @"changed" : @(UIGestureRecognizerStateChanged),
+        @"ended" : @(UIGestureRecognizerStateEnded),
+        @"cancelled" : @(UIGestureRecognizerStateCancelled)
+    };
+    NSMutableArray *samples = [NSMutableArray new];
+    for (NSDictionary *traceSample in trace[@"samples"]) {
+        NSNumber *state = states[traceSample[@"state"]];
+        XCTAssertNotNil(state, @"Unknown state %@ in trace fixture %@", traceSample[@"state"], name);
+        MSDynamicsDrawerGestureTraceSample sample = {
+            .state = [state integerValue],
+            .timestamp = [traceSample[@"t"] doubleValue],
+            .location = {[traceSample[@"x"] doubleValue], [traceSample[@"y"] doubleValue]}
+        };
+        [samples addObject:[NSValue valueWithBytes:&sample objCType:@encode(MSDynamicsDrawerGestureTraceSample)]];
+    }
+    return samples;
+}
+
+// Returns the samples of a binary gesture trace as boxed `MSDynamicsDrawerGestureTraceSample` values, or `nil` if it can't be read
+- (NSArray *)samplesOfTrace:(NSData *)trace header:(MSDynamicsDrawerGestureTraceHeader *)header
+{
+    NSMutableArray *samples = [NSMutableArray new];
+    BOOL read = [MSDynamicsDrawerGestureRecorder enumerateSamplesOfTrace:trace header:header usingBlock:^(MSDynamicsDrawerGestureTraceSample sample, BOOL *stop) {
+        [samples addObject:[NSValue valueWithBytes:&sample objCType:@encode(MSDynamicsDrawerGestureTraceSample)]];
+    }];
+    return (read ? samples : nil);
+}
+
+- (void)replaySamples:(NSArray *)samples initialPaneState:(MSDynamicsDrawerPaneState)initialPaneState ofTraceNamed:(NSString *)name
+{
+    MSDynamicsDrawerViewController *dynamicsDrawerViewController = self.dynamicsDrawerViewController;
+    MSReplayPanGestureRecognizer *panGestureRecognizer = self.panGestureRecognizer;
+    
+    [dynamicsDrawerViewController setPaneState:initialPaneState inDirection:MSDynamicsDrawerDirectionLeft];
+    CGFloat initialPaneViewOriginX = dynamicsDrawerViewController.paneView.frame.origin.x;
+    CGFloat revealWidth = [dynamicsDrawerViewController revealWidthForDirection:MSDynamicsDrawerDirectionLeft];
+    
+    CGPoint startLocation = CGPointZero;
+    for (NSValue *sampleValue in samples) {
+        MSDynamicsDrawerGestureTraceSample sample;
+        [sampleValue getValue:&sample];
+        panGestureRecognizer.replayState = sample.state;
+        panGestureRecognizer.replayLocation = sample.location;
+        panGestureRecognizer.replayTimestamp = (MSReplayTimestampOrigin + sample.timestamp);
+        if (sample.state == UIGestureRecognizerStateBegan) {
+            startLocation = sample.location;
+        }
+        
+        [dynamicsDrawerViewController panePanned:panGestureRecognizer];
+        
+        if (sample.state == UIGestureRecognizerStateChanged) {
+            // The pane follows the touch along the axis, bounded between its closed and open origins
+            CGFloat expectedPaneViewOriginX = MIN(MAX((initialPaneViewOriginX + (sample.location.x - startLocation.x)), 0.0), revealWidth);
+            XCTAssertEqualWithAccuracy(dynamicsDrawerViewController.paneView.frame.origin.x, expectedPaneViewOriginX, 0.01, @"Pane doesn't follow the touch in trace %@ at t = %f", name, sample.timestamp);
+            XCTAssertEqualWithAccuracy(dynamicsDrawerViewController.paneView.frame.origin.y, 0.0, 0.01, @"Pane moves off its axis in trace %@ at t = %f", name, sample.timestamp);
+        }
+    }
+    // Gesture recognizers return to possible once they've ended
+    panGestureRecognizer.replayState = UIGestureRecognizerStatePossible;
+}
+
+- (void)replayTraceNamed:(NSString *)name
+{
+    MSDynamicsDrawerPaneState initialPaneState;
+    NSArray *samples = [self samplesOfTraceNamed:name initialPaneState:&initialPaneState];
+    [self replaySamples:samples initialPaneState:initialPaneState ofTraceNamed:name];
+}
+
+- (void)assertSamples:(NSArray *)samples equalSamples:(NSArray *)expectedSamples
+{
+    XCTAssertEqual(samples.count, expectedSamples.count);
+    for (NSUInteger sampleIndex = 0; sampleIndex < MIN(samples.count, expectedSamples.count); sampleIndex++) {
+        MSDynamicsDrawerGestureTraceSample sample, expectedSample;
+        [samples[sampleIndex] getValue:&sample];
+        [expectedSamples[sampleIndex] getValue:&expectedSample];
+        XCTAssertEqual(sample.state, expectedSample.state, @"Sample %lu", (unsigned long)sampleIndex);
+        // Timestamps are stored to the microsecond, and locations as single precision floats
+        XCTAssertEqualWithAccuracy(sample.timestamp, expectedSample.timestamp, 0.000001, @"Sample %lu", (unsigned long)sampleIndex);
+        XCTAssertEqualWithAccuracy(sample.location.x, expectedSample.location.x, 0.001, @"Sample %lu", (unsigned long)sampleIndex);
+        XCTAssertEqualWithAccuracy(sample.location.y, expectedSample.location.y, 0.001, @"Sample %lu", (unsigned long)sampleIndex);
+    }
+}
+
+- (void)assertPaneMayUpdateToPaneState:(MSDynamicsDrawerPaneState)paneState pushed:(BOOL)pushed
+{
+    XCTAssertEqual(self.mayUpdatePaneStates.count, (NSUInteger)1);
+    XCTAssertEqualObjects(self.mayUpdatePaneStates.lastObject, (@[@(paneState), @(MSDynamicsDrawerDirectionLeft)]));
+    XCTAssertEqual(self.paneMotionEngine.motionCount, (NSUInteger)1);
+    XCTAssertEqual(self.paneMotionEngine.motion.paneState, paneState);
+    if (pushed) {
+        // A release over the velocity threshold pushes the pane with a magnitude proportional to its velocity, 900 points / second in the flick traces
+        XCTAssertEqualWithAccuracy(self.paneMotionEngine.motion.pushMagnitude, 75.0, 1.0);
+    } else {
+        XCTAssertEqual(self.paneMotionEngine.motion.pushMagnitude, 0.0);
+    }
+}
+
+- (void)assertPaneComesToRestInPaneState:(MSDynamicsDrawerPaneState)paneState
+{
+    [self.paneMotionEngine finishMotion];
+    XCTAssertEqual(self.dynamicsDrawerViewController.paneState, paneState);
+    CGFloat expectedPaneViewOriginX = ((paneState == MSDynamicsDrawerPaneStateOpen) ? [self.dynamicsDrawerViewController revealWidthForDirection:MSDynamicsDrawerDirectionLeft] : 0.0);
+    XCTAssertEqualWithAccuracy(self.dynamicsDrawerViewController.paneView.frame.origin.x, expectedPaneViewOriginX, 0.01);
+}
+
+#pragma mark - Tests
+
+- (void)testFlickOpenResolvesToOpenByVelocity
+{
+    [self replayTraceNamed:@"FlickOpen"];
+    [self assertPaneMayUpdateToPaneState:MSDynamicsDrawerPaneStateOpen pushed:YES];
+    [self assertPaneComesToRestInPaneState:MSDynamicsDrawerPaneStateOpen];
+}
+
+- (void)testFlickClosedResolvesToClosedByVelocity
+{
+    [self replayTraceNamed:@"FlickClosed"];
+    [self assertPaneMayUpdateToPaneState:MSDynamicsDrawerPaneStateClosed pushed:YES];
+    [self assertPaneComesToRestInPaneState:MSDynamicsDrawerPaneStateClosed];
+}
+
+- (void)testSlowDragAndHoldResolvesToNearestClosed
+{
+    [self replayTraceNamed:@"SlowDragHold"];
+    [self assertPaneMayUpdateToPaneState:MSDynamicsDrawerPaneStateClosed pushed:NO];
+    [self assertPaneComesToRestInPaneState:MSDynamicsDrawerPaneStateClosed];
+}
+
+- (void)testDragOpenAndHoldResolvesToNearestOpen
+{
+    [self replayTraceNamed:@"DragOpenHold"];
+    [self assertPaneMayUpdateToPaneState:MSDynamicsDrawerPaneStateOpen pushed:NO];
+    [self assertPaneComesToRestInPaneState:MSDynamicsDrawerPaneStateOpen];
+}
+
+- (void)testOverdragIsBoundedAndResolvesToNearestOpen
+{
+    [self replayTraceNamed:@"OverdragHold"];
+    [self assertPaneMayUpdateToPaneState:MSDynamicsDrawerPaneStateOpen pushed:NO];
+    [self assertPaneComesToRestInPaneState:MSDynamicsDrawerPaneStateOpen];
+}
+
+#pragma mark Binary Traces
+
+- (void)testBinaryTraceReplaysLikeItsJSONTrace
+{
+    MSDynamicsDrawerPaneState initialPaneState;
+    NSArray *expectedSamples = [self samplesOfTraceNamed:@"FlickOpen" initialPaneState:&initialPaneState];
+    MSDynamicsDrawerGestureTraceHeader header;
+    NSArray *samples = [self samplesOfTrace:[self fixtureNamed:@"FlickOpen" extension:@"mstrace"] header:&header];
+    XCTAssertNotNil(samples);
+    XCTAssertTrue(CGSizeEqualToSize(header.referenceSize, self.dynamicsDrawerViewController.view.bounds.size), @"%@", NSStringFromCGSize(header.referenceSize));
+    XCTAssertEqual(header.paneState, MSDynamicsDrawerPaneStateClosed);
+    XCTAssertEqual(header.direction, MSDynamicsDrawerDirectionNone);
+    XCTAssertEqual(header.sampleCount, expectedSamples.count);
+    [self assertSamples:samples equalSamples:expectedSamples];
+    
+    [self replaySamples:samples initialPaneState:header.paneState ofTraceNamed:@"FlickOpen.mstrace"];
+    [self assertPaneMayUpdateToPaneState:MSDynamicsDrawerPaneStateOpen pushed:YES];
+    [self assertPaneComesToRestInPaneState:MSDynamicsDrawerPaneStateOpen];
+}
+
+- (void)testRecordedTraceReplaysLikeTheRecordedGesture
+{
+    MSDynamicsDrawerGestureRecorder *gestureRecorder = [MSDynamicsDrawerGestureRecorder new];
+    self.dynamicsDrawerViewController.gestureRecorder = gestureRecorder;
+    [gestureRecorder beginRecording];
+    XCTAssertTrue(gestureRecorder.isRecording);
+    [self replayTraceNamed:@"FlickClosed"];
+    NSData *trace = [gestureRecorder endRecording];
+    XCTAssertFalse(gestureRecorder.isRecording);
+    XCTAssertNil([gestureRecorder endRecording]);
+    
+    // The header records the drawer as the gesture began, and each sample takes 16 bytes after the 24 byte header
+    MSDynamicsDrawerPaneState initialPaneState;
+    NSArray *expectedSamples = [self samplesOfTraceNamed:@"FlickClosed" initialPaneState:&initialPaneState];
+    XCTAssertEqual(trace.length, (24 + (16 * expectedSamples.count)));
+    MSDynamicsDrawerGestureTraceHeader header;
+    NSArray *samples = [self samplesOfTrace:trace header:&header];
+    XCTAssertNotNil(samples);
+    XCTAssertTrue(CGSizeEqualToSize(header.referenceSize, (CGSize){320.0, 568.0}), @"%@", NSStringFromCGSize(header.referenceSize));
+    XCTAssertEqual(header.paneState, initialPaneState);
+    XCTAssertEqual(header.direction, MSDynamicsDrawerDirectionLeft);
+    [self assertSamples:samples equalSamples:expectedSamples];
+    
+    // Replaying the recording brings the pane to rest in the same way as the original gesture
+    [self.paneMotionEngine finishMotion];
+    self.dynamicsDrawerViewController.gestureRecorder = nil;
+    [self.mayUpdatePaneStates removeAllObjects];
+    self.paneMotionEngine = [MSReplayPaneMotionEngine new];
+    self.dynamicsDrawerViewController.paneMotionEngine = self.paneMotionEngine;
+    [self replaySamples:samples initialPaneState:header.paneState ofTraceNamed:@"Recorded FlickClosed"];
+    [self assertPaneMayUpdateToPaneState:MSDynamicsDrawerPaneStateClosed pushed:YES];
+    [self assertPaneComesToRestInPaneState:MSDynamicsDrawerPaneStateClosed];
+}
+
+- (void)testGesturesAreOnlyRecordedWhileRecording
+{
+    MSDynamicsDrawerGestureRecorder *gestureRecorder = [MSDynamicsDrawerGestureRecorder new];
+    self.dynamicsDrawerViewController.gestureRecorder = gestureRecorder;
+    [self replayTraceNamed:@"SlowDragHold"];
+    XCTAssertNil([gestureRecorder endRecording]);
+    
+    // A recording without any gestures is an empty trace
+    [gestureRecorder beginRecording];
+    MSDynamicsDrawerGestureTraceHeader header;
+    NSArray *samples = [self samplesOfTrace:[gestureRecorder endRecording] header:&header];
+    XCTAssertNotNil(samples);
+    XCTAssertEqual(samples.count, (NSUInteger)0);
+    XCTAssertEqual(header.sampleCount, (NSUInteger)0);
+}
+
+- (void)testMalformedTracesAreRejected
+{
+    NSData *trace = [self fixtureNamed:@"FlickOpen" extension:@"mstrace"];
+    __block NSUInteger sampleCount = 0;
+    void (^countSample)(MSDynamicsDrawerGestureTraceSample, BOOL *) = ^(MSDynamicsDrawerGestureTraceSample sample, BOOL *stop) {
+        sampleCount++;
+    };
+    XCTAssertTrue([MSDynamicsDrawerGestureRecorder enumerateSamplesOfTrace:trace header:NULL usingBlock:nil]);
+    
+    // Truncated within the header, and within the last sample
+    XCTAssertFalse([MSDynamicsDrawerGestureRecorder enumerateSamplesOfTrace:[trace subdataWithRange:(NSRange){0, 20}] header:NULL usingBlock:countSample]);
+    XCTAssertFalse([MSDynamicsDrawerGestureRecorder enumerateSamplesOfTrace:[trace subdataWithRange:(NSRange){0, (trace.length - 1)}] header:NULL usingBlock:countSample]);
+    
+    NSMutableData *corruptTrace = [trace mutableCopy];
+    ((uint8_t *)corruptTrace.mutableBytes)[0] = 'X';
+    XCTAssertFalse([MSDynamicsDrawerGestureRecorder enumerateSamplesOfTrace:corruptTrace header:NULL usingBlock:countSample]);
+    
+    // An unsupported format version
+    corruptTrace = [trace mutableCopy];
+    ((uint8_t *)corruptTrace.mutableBytes)[4] = 2;
+    XCTAssertFalse([MSDynamicsDrawerGestureRecorder enumerateSamplesOfTrace:corruptTrace header:NULL usingBlock:countSample]);
+    XCTAssertEqual(sampleCount, (NSUInteger)0);
+    
+    // Stopping ends the enumeration
+    XCTAssertTrue([MSDynamicsDrawerGestureRecorder enumerateSamplesOfTrace:trace header:NULL usingBlock:^(MSDynamicsDrawerGestureTraceSample sample, BOOL *stop) {
+        sampleCount++;
+        *stop = (sampleCount == 3);
+    }]);
+    XCTAssertEqual(sampleCount, (NSUInteger)3);
+}
+
+#pragma mark Hitches
+
+- (void)testHitchesAreMeasuredAgainstTheRefreshInterval
+{
+    CFTimeInterval refreshInterval = (1.0 / 60.0);
+    MSDynamicsDrawerTransitionMetrics *transitionMetrics = [[MSDynamicsDrawerTransitionMetrics alloc] initWithKind:MSDynamicsDrawerTransitionKindGesture direction:MSDynamicsDrawerDirectionLeft startTimestamp:0.0];
+    // Refreshes 3 and 4 are dropped, then refresh 7
+    for (NSNumber *refresh in @[@0, @1, @2, @5, @6, @8]) {
+        [transitionMetrics recordFrameAtTimestamp:([refresh doubleValue] * refreshInterval) refreshInterval:refreshInterval];
+    }
+    XCTAssertEqual(transitionMetrics.framesRendered, (NSUInteger)6);
+    XCTAssertEqual(transitionMetrics.framesDropped, (NSUInteger)3);
+    XCTAssertEqualWithAccuracy(transitionMetrics.hitchDuration, (3.0 * refreshInterval), 0.000001);
+    XCTAssertEqualWithAccuracy(transitionMetrics.longestHitchDuration, (2.0 * refreshInterval), 0.000001);
+    // 50 ms of hitches over the 133 ms between the first and last refreshes
+    XCTAssertEqualWithAccuracy(transitionMetrics.hitchTimeRatio, 375.0, 0.001);
+}
+
+- (void)testTransitionWithoutHitchesHasNoHitchTime
+{
+    CFTimeInterval refreshInterval = (1.0 / 120.0);
+    MSDynamicsDrawerTransitionMetrics *transitionMetrics = [[MSDynamicsDrawerTransitionMetrics alloc] initWithKind:MSDynamicsDrawerTransitionKindGesture direction:MSDynamicsDrawerDirectionLeft startTimestamp:0.0];
+    XCTAssertEqual(transitionMetrics.hitchTimeRatio, 0.0);
+    for (NSUInteger refresh = 0; refresh < 12; refresh++) {
+        [transitionMetrics recordFrameAtTimestamp:(refresh * refreshInterval) refreshInterval:refreshInterval];
+    }
+    XCTAssertEqual(transitionMetrics.framesDropped, (NSUInteger)0);
+    XCTAssertEqual(transitionMetrics.hitchDuration, 0.0);
+    XCTAssertEqual(transitionMetrics.hitchTimeRatio, 0.0);
+}
+
+#pragma mark Performance
+
+- (void)testReplayedFlickPerformance
+{
+    if (@available(iOS 13.0, *)) {
+        // The styler updates and the transition are measured by the signposts that the drawer emits for them. On iOS 14 and later, the transition is an animation interval that the hitch metrics are reported for.
+        NSString *subsystem = @"com.monospacecollective.MSDynamicsDrawerViewController";
+        NSArray *metrics = @[[XCTClockMetric new], [[XCTOSSignpostMetric alloc] initWithSubsystem:subsystem category:@"Transitions" name:@"Update Stylers"], [[XCTOSSignpostMetric alloc] initWithSubsystem:subsystem category:@"Transitions" name:@"Transition"]];
+        [self measureWithMetrics:metrics block:^{
+            [self replayTraceNamed:@"FlickOpen"];
+            [self.paneMotionEngine finishMotion];
+            [self.dynamicsDrawerViewController setPaneState:MSDynamicsDrawerPaneStateClosed];
+        }];
+    }
+}
+
+#pragma mark - MSDynamicsDrawerViewControllerDelegate
+
+- (void)dynamicsDrawerViewController:(MSDynamicsDrawerViewController *)drawerViewController mayUpdateToPaneState:(MSDynamicsDrawerPaneState)paneState forDirection:(MSDynamicsDrawerDirection)direction
+{
+    [self.mayUpdatePaneStates addObject:@[@(paneState), @(direction)]];
+}
+
+@end
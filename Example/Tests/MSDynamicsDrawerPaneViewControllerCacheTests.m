@@ -0,0 +1,211 @@
+//
+//  MSDynamicsDrawerPaneViewControllerCacheTests.m
+//  MSDynamicsDrawerViewController
+//
+//  Copyright (c) 2013 Monospace Ltd. All rights reserved.
+//
+//  This code is distributed under the terms and conditions of the MIT license.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#import "MSDynamicsDrawerViewController.h"
+
+// A pane view controller that counts its evictions from the cache
+@interface MSEvictionCountingViewController : UIViewController <MSDynamicsDrawerCachedPaneViewController>
+
+@property (nonatomic, assign) NSUInteger evictionCount;
+
+@end
+
+@implementation MSEvictionCountingViewController
+
+- (void)paneViewControllerWasEvictedFromDynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController
+{
+    self.evictionCount++;
+}
+
+@end
+
+@interface MSDynamicsDrawerPaneViewControllerCacheTests : XCTestCase
+
+@property (nonatomic, strong) MSDynamicsDrawerViewController *dynamicsDrawerViewController;
+@property (nonatomic, strong) NSMutableDictionary *builtPaneViewControllers;
+@property (nonatomic, assign) NSUInteger buildCount;
+
+@end
+
+@implementation MSDynamicsDrawerPaneViewControllerCacheTests
+
+- (void)setUp
+{
+    [super setUp];
+    
+    // A headless drawer, which is never added to a window
+    self.dynamicsDrawerViewController = [MSDynamicsDrawerViewController new];
+    self.dynamicsDrawerViewController.view.frame = (CGRect){CGPointZero, {320.0, 568.0}};
+    self.builtPaneViewControllers = [NSMutableDictionary new];
+    self.buildCount = 0;
+}
+
+- (void)tearDown
+{
+    self.dynamicsDrawerViewController = nil;
+    self.builtPaneViewControllers = nil;
+    [super tearDown];
+}
+
+#pragma mark - Helpers
+
+// Shows the pane view controller for `key` without animation, building a new one if it isn't cached
+- (void)showPaneViewControllerForKey:(NSString *)key
+{
+    __weak typeof(self) weakSelf = self;
+    [self.dynamicsDrawerViewController setPaneViewControllerForKey:key builder:^UIViewController *{
+        MSEvictionCountingViewController *paneViewController = [MSEvictionCountingViewController new];
+        weakSelf.builtPaneViewControllers[key] = paneViewController;
+        weakSelf.buildCount++;
+        return paneViewController;
+    } animated:NO completion:nil];
+}
+
+- (NSArray *)cachedKeys
+{
+    NSMutableArray *cachedKeys = [NSMutableArray new];
+    for (NSString *key in [self.builtPaneViewControllers.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+        if ([self.dynamicsDrawerViewController cachedPaneViewControllerForKey:key]) {
+            [cachedKeys addObject:key];
+        }
+    }
+    return cachedKeys;
+}
+
+- (NSUInteger)evictionCountForKey:(NSString *)key
+{
+    return [self.builtPaneViewControllers[key] evictionCount];
+}
+
+#pragma mark - Caching
+
+- (void)testCachedPaneViewControllerIsReused
+{
+    [self showPaneViewControllerForKey:@"A"];
+    [self showPaneViewControllerForKey:@"B"];
+    [self showPaneViewControllerForKey:@"A"];
+    XCTAssertEqual(self.buildCount, (NSUInteger)2);
+    XCTAssertEqual(self.dynamicsDrawerViewController.paneViewController, self.builtPaneViewControllers[@"A"]);
+    XCTAssertEqual([self.dynamicsDrawerViewController cachedPaneViewControllerForKey:@"B"], self.builtPaneViewControllers[@"B"]);
+    XCTAssertNil([self.dynamicsDrawerViewController cachedPaneViewControllerForKey:@"C"]);
+}
+
+- (void)testReplacedPaneViewControllerKeepsItsView
+{
+    [self showPaneViewControllerForKey:@"A"];
+    UIView *view = [self.builtPaneViewControllers[@"A"] view];
+    [self showPaneViewControllerForKey:@"B"];
+    [self showPaneViewControllerForKey:@"A"];
+    XCTAssertEqual([self.builtPaneViewControllers[@"A"] view], view);
+    XCTAssertEqual(view.superview, self.dynamicsDrawerViewController.paneView);
+}
+
+#pragma mark - Eviction
+
+- (void)testLeastRecentlyShownPaneViewControllerIsEvicted
+{
+    // The default capacity of 3
+    [self showPaneViewControllerForKey:@"A"];
+    [self showPaneViewControllerForKey:@"B"];
+    [self showPaneViewControllerForKey:@"C"];
+    XCTAssertEqualObjects([self cachedKeys], (@[@"A", @"B", @"C"]));
+    
+    // Showing A again makes B the least recently shown
+    [self showPaneViewControllerForKey:@"A"];
+    [self showPaneViewControllerForKey:@"D"];
+    XCTAssertEqualObjects([self cachedKeys], (@[@"A", @"C", @"D"]));
+    XCTAssertEqual([self evictionCountForKey:@"B"], (NSUInteger)1);
+    XCTAssertEqual([self evictionCountForKey:@"A"], (NSUInteger)0);
+    XCTAssertEqual([self evictionCountForKey:@"C"], (NSUInteger)0);
+    
+    // An evicted pane view controller is rebuilt the next time it's shown, evicting C
+    [self showPaneViewControllerForKey:@"B"];
+    XCTAssertEqual(self.buildCount, (NSUInteger)5);
+    XCTAssertEqualObjects([self cachedKeys], (@[@"A", @"B", @"D"]));
+    XCTAssertEqual([self evictionCountForKey:@"C"], (NSUInteger)1);
+}
+
+- (void)testVisiblePaneViewControllerIsNeverEvicted
+{
+    self.dynamicsDrawerViewController.paneViewControllerCacheCapacity = 0;
+    [self showPaneViewControllerForKey:@"A"];
+    XCTAssertEqualObjects([self cachedKeys], (@[@"A"]));
+    [self showPaneViewControllerForKey:@"B"];
+    XCTAssertEqualObjects([self cachedKeys], (@[@"B"]));
+    XCTAssertEqual([self evictionCountForKey:@"A"], (NSUInteger)1);
+    XCTAssertEqual([self evictionCountForKey:@"B"], (NSUInteger)0);
+}
+
+- (void)testLoweringCapacityEvictsImmediately
+{
+    [self showPaneViewControllerForKey:@"A"];
+    [self showPaneViewControllerForKey:@"B"];
+    [self showPaneViewControllerForKey:@"C"];
+    self.dynamicsDrawerViewController.paneViewControllerCacheCapacity = 1;
+    XCTAssertEqualObjects([self cachedKeys], (@[@"C"]));
+    XCTAssertEqual([self evictionCountForKey:@"A"], (NSUInteger)1);
+    XCTAssertEqual([self evictionCountForKey:@"B"], (NSUInteger)1);
+    
+    // Raising the capacity again doesn't bring anything back, but allows more to be cached
+    self.dynamicsDrawerViewController.paneViewControllerCacheCapacity = 2;
+    [self showPaneViewControllerForKey:@"D"];
+    XCTAssertEqualObjects([self cachedKeys], (@[@"C", @"D"]));
+}
+
+- (void)testMemoryWarningEvictsAllButTheVisiblePaneViewController
+{
+    [self showPaneViewControllerForKey:@"A"];
+    [self showPaneViewControllerForKey:@"B"];
+    [self showPaneViewControllerForKey:@"C"];
+    [self.dynamicsDrawerViewController didReceiveMemoryWarning];
+    XCTAssertEqualObjects([self cachedKeys], (@[@"C"]));
+    XCTAssertEqual([self evictionCountForKey:@"A"], (NSUInteger)1);
+    XCTAssertEqual([self evictionCountForKey:@"B"], (NSUInteger)1);
+    XCTAssertEqual([self evictionCountForKey:@"C"], (NSUInteger)0);
+    XCTAssertEqualObjects([self.dynamicsDrawerViewController memoryFootprintReport][@"cachedPaneViewControllers"], @1);
+}
+
+- (void)testRemovedPaneViewControllerIsEvictedUnlessVisible
+{
+    [self showPaneViewControllerForKey:@"A"];
+    [self showPaneViewControllerForKey:@"B"];
+    [self.dynamicsDrawerViewController removeCachedPaneViewControllerForKey:@"A"];
+    XCTAssertEqual([self evictionCountForKey:@"A"], (NSUInteger)1);
+    
+    // The visible pane view controller remains the pane view controller, but is rebuilt the next time it's shown
+    [self.dynamicsDrawerViewController removeCachedPaneViewControllerForKey:@"B"];
+    XCTAssertEqual([self evictionCountForKey:@"B"], (NSUInteger)0);
+    XCTAssertEqual(self.dynamicsDrawerViewController.paneViewController, self.builtPaneViewControllers[@"B"]);
+    XCTAssertEqualObjects([self cachedKeys], @[]);
+    
+    // Removing a key that isn't cached does nothing
+    [self.dynamicsDrawerViewController removeCachedPaneViewControllerForKey:@"C"];
+    XCTAssertEqual(self.buildCount, (NSUInteger)2);
+}
+
+@end
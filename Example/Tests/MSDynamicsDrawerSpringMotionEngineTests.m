@@ -0,0 +1,233 @@
+//
+//  MSDynamicsDrawerSpringMotionEngineTests.m
+//  MSDynamicsDrawerViewController
+//
+//  Copyright (c) 2013 Monospace Ltd. All rights reserved.
+//
+//  This code is distributed under the terms and conditions of the MIT license.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#import "MSDynamicsDrawerViewController.h"
+
+// The duration of a frame at 60 fps
+static const CFTimeInterval MSTestSampleInterval = (1.0 / 60.0);
+
+@interface MSDynamicsDrawerSpringMotionEngineTests : XCTestCase <MSDynamicsDrawerPaneMotionEngineDelegate>
+
+@property (nonatomic, strong) MSDynamicsDrawerSpringMotionEngine *paneMotionEngine;
+@property (nonatomic, strong) UIView *referenceView;
+@property (nonatomic, strong) UIView *paneView;
+@property (nonatomic, assign) NSUInteger updateCount;
+@property (nonatomic, assign) NSUInteger restCount;
+
+@end
+
+@implementation MSDynamicsDrawerSpringMotionEngineTests
+
+- (void)setUp
+{
+    [super setUp];
+    
+    self.paneMotionEngine = [MSDynamicsDrawerSpringMotionEngine new];
+    self.paneMotionEngine.delegate = self;
+    self.referenceView = [[UIView alloc] initWithFrame:(CGRect){CGPointZero, {320.0, 568.0}}];
+    self.paneView = [[UIView alloc] initWithFrame:self.referenceView.bounds];
+    [self.referenceView addSubview:self.paneView];
+    self.updateCount = 0;
+    self.restCount = 0;
+}
+
+- (void)tearDown
+{
+    self.paneMotionEngine = nil;
+    self.referenceView = nil;
+    self.paneView = nil;
+    [super tearDown];
+}
+
+#pragma mark - Helpers
+
+// Opening a left drawer with the default reveal width from the closed pane view origin, as created by `MSDynamicsDrawerViewController`
+- (MSDynamicsDrawerPaneMotion)openMotionWithElasticity:(CGFloat)elasticity
+{
+    MSDynamicsDrawerPaneMotion motion;
+    memset(&motion, 0, sizeof(motion));
+    motion.paneState = MSDynamicsDrawerPaneStateOpen;
+    motion.direction = MSDynamicsDrawerDirectionLeft;
+    motion.targetPaneViewOrigin = (CGPoint){267.0, 0.0};
+    motion.boundary = (CGRect){{-1.0, -1.0}, {589.0, 569.0}};
+    // Gravity pulls the pane towards the right
+    motion.gravityAngle = 0.0;
+    motion.gravityMagnitude = 2.0;
+    motion.elasticity = elasticity;
+    return motion;
+}
+
+- (NSArray *)horizontalPaneViewOriginsForMotion:(MSDynamicsDrawerPaneMotion)motion
+{
+    NSArray *paneViewOrigins = [self.paneMotionEngine paneViewOriginsForMotion:motion ofPaneView:self.paneView sampleInterval:MSTestSampleInterval];
+    NSMutableArray *horizontalPaneViewOrigins = [NSMutableArray new];
+    for (NSValue *paneViewOrigin in paneViewOrigins) {
+        XCTAssertEqual([paneViewOrigin CGPointValue].y, 0.0);
+        [horizontalPaneViewOrigins addObject:@([paneViewOrigin CGPointValue].x)];
+    }
+    return horizontalPaneViewOrigins;
+}
+
+#pragma mark - Prediction
+
+- (void)testCriticallyDampedSpringSettlesWithoutBouncing
+{
+    NSArray *paneViewOrigins = [self horizontalPaneViewOriginsForMotion:[self openMotionWithElasticity:0.0]];
+    
+    // With a period of 0.5s, the spring rests within half a point of the target after 0.7s
+    XCTAssertEqual(paneViewOrigins.count, (NSUInteger)43);
+    XCTAssertEqualWithAccuracy([paneViewOrigins.firstObject doubleValue], 0.0, 0.001);
+    XCTAssertEqual([paneViewOrigins.lastObject doubleValue], 267.0);
+    // x(t) = 267 - 267 * e^(-4πt) * (1 + 4πt)
+    XCTAssertEqualWithAccuracy([paneViewOrigins[6] doubleValue], 95.516, 0.001);
+    XCTAssertEqualWithAccuracy([paneViewOrigins[12] doubleValue], 191.016, 0.001);
+    XCTAssertEqualWithAccuracy([paneViewOrigins[15] doubleValue], 219.214, 0.001);
+    
+    for (NSUInteger index = 1; index < paneViewOrigins.count; index++) {
+        XCTAssertGreaterThanOrEqual([paneViewOrigins[index] doubleValue], [paneViewOrigins[(index - 1)] doubleValue]);
+    }
+}
+
+- (void)testElasticSpringBouncesOffOfItsTarget
+{
+    // An elasticity of 0.5 halves the damping ratio
+    NSArray *paneViewOrigins = [self horizontalPaneViewOriginsForMotion:[self openMotionWithElasticity:0.5]];
+    XCTAssertEqual(paneViewOrigins.count, (NSUInteger)65);
+    XCTAssertEqual([paneViewOrigins.lastObject doubleValue], 267.0);
+    
+    // The first bounce peaks at 0.2s, then the pane falls back to 223.6 before the second one
+    XCTAssertEqualWithAccuracy([paneViewOrigins[12] doubleValue], 259.8, 0.1);
+    XCTAssertEqualWithAccuracy([paneViewOrigins[17] doubleValue], 223.6, 0.1);
+    XCTAssertLessThan([paneViewOrigins[13] doubleValue], [paneViewOrigins[12] doubleValue]);
+    // The pane is never moved past its target, into the boundary
+    for (NSNumber *paneViewOrigin in paneViewOrigins) {
+        XCTAssertLessThanOrEqual([paneViewOrigin doubleValue], 267.0);
+    }
+}
+
+- (void)testSpringStartingPastItsTargetStaysOnThatSide
+{
+    // Closing from open wide (340) to open, the pane starts on the same side of its target that gravity pulls it from
+    self.paneView.frame = (CGRect){{340.0, 0.0}, self.paneView.frame.size};
+    NSArray *paneViewOrigins = [self horizontalPaneViewOriginsForMotion:[self openMotionWithElasticity:0.0]];
+    
+    // x(t) = 267 + 73 * e^(-4πt) * (1 + 4πt)
+    XCTAssertEqual(paneViewOrigins.count, (NSUInteger)36);
+    XCTAssertEqualWithAccuracy([paneViewOrigins.firstObject doubleValue], 340.0, 0.001);
+    XCTAssertEqualWithAccuracy([paneViewOrigins[6] doubleValue], 313.885, 0.001);
+    XCTAssertEqualWithAccuracy([paneViewOrigins[12] doubleValue], 287.775, 0.001);
+    XCTAssertEqual([paneViewOrigins.lastObject doubleValue], 267.0);
+    for (NSUInteger index = 1; index < paneViewOrigins.count; index++) {
+        XCTAssertLessThanOrEqual([paneViewOrigins[index] doubleValue], [paneViewOrigins[(index - 1)] doubleValue]);
+    }
+    
+    // An elastic spring bounces off of the target from the same side
+    for (NSNumber *paneViewOrigin in [self horizontalPaneViewOriginsForMotion:[self openMotionWithElasticity:0.5]]) {
+        XCTAssertGreaterThanOrEqual([paneViewOrigin doubleValue], 267.0);
+    }
+}
+
+- (void)testInitialVelocityMovesThePaneFurther
+{
+    NSArray *paneViewOrigins = [self horizontalPaneViewOriginsForMotion:[self openMotionWithElasticity:0.0]];
+    MSDynamicsDrawerPaneMotion motion = [self openMotionWithElasticity:0.0];
+    motion.initialVelocity = (CGPoint){2000.0, 0.0};
+    NSArray *fasterPaneViewOrigins = [self horizontalPaneViewOriginsForMotion:motion];
+    XCTAssertGreaterThan([fasterPaneViewOrigins[1] doubleValue], [paneViewOrigins[1] doubleValue]);
+    XCTAssertEqual([fasterPaneViewOrigins.lastObject doubleValue], 267.0);
+}
+
+- (void)testPredictionDoesNotMoveThePaneView
+{
+    [self.paneMotionEngine paneViewOriginsForMotion:[self openMotionWithElasticity:0.0] ofPaneView:self.paneView sampleInterval:MSTestSampleInterval];
+    XCTAssertTrue(CGPointEqualToPoint(self.paneView.frame.origin, CGPointZero), @"%@", NSStringFromCGPoint(self.paneView.frame.origin));
+    XCTAssertFalse(self.paneMotionEngine.isRunning);
+    XCTAssertEqual(self.updateCount, (NSUInteger)0);
+}
+
+#pragma mark - Stepping
+
+- (void)testSteppedMotionComesToRestAtTarget
+{
+    MSDynamicsDrawerPaneMotion motion = [self openMotionWithElasticity:0.0];
+    [self.paneMotionEngine beginMotion:motion ofPaneView:self.paneView inReferenceView:self.referenceView];
+    XCTAssertTrue(self.paneMotionEngine.isRunning);
+    
+    // Long after the spring has settled
+    [self.paneMotionEngine stepMotionToTimestamp:(CACurrentMediaTime() + 10.0)];
+    XCTAssertFalse(self.paneMotionEngine.isRunning);
+    XCTAssertTrue(CGPointEqualToPoint(self.paneView.frame.origin, motion.targetPaneViewOrigin), @"%@", NSStringFromCGPoint(self.paneView.frame.origin));
+    XCTAssertEqual(self.updateCount, (NSUInteger)1);
+    XCTAssertEqual(self.restCount, (NSUInteger)1);
+    
+    // Steps once at rest are ignored
+    [self.paneMotionEngine stepMotionToTimestamp:(CACurrentMediaTime() + 11.0)];
+    XCTAssertEqual(self.updateCount, (NSUInteger)1);
+}
+
+- (void)testStoppedMotionComesToRestInPlace
+{
+    [self.paneMotionEngine beginMotion:[self openMotionWithElasticity:0.0] ofPaneView:self.paneView inReferenceView:self.referenceView];
+    [self.paneMotionEngine stopMotion];
+    XCTAssertFalse(self.paneMotionEngine.isRunning);
+    XCTAssertTrue(CGPointEqualToPoint(self.paneView.frame.origin, CGPointZero), @"%@", NSStringFromCGPoint(self.paneView.frame.origin));
+    XCTAssertEqual(self.restCount, (NSUInteger)1);
+    
+    // Stopping once at rest doesn't inform the delegate again
+    [self.paneMotionEngine stopMotion];
+    XCTAssertEqual(self.restCount, (NSUInteger)1);
+}
+
+- (void)testSteppedSpringStartingPastItsTargetStaysOnThatSide
+{
+    // Closing from open wide (340) to open, an elastic spring bounces off of the target from the side that it starts on
+    self.paneView.frame = (CGRect){{340.0, 0.0}, self.paneView.frame.size};
+    CFTimeInterval startTimestamp = CACurrentMediaTime();
+    [self.paneMotionEngine beginMotion:[self openMotionWithElasticity:0.5] ofPaneView:self.paneView inReferenceView:self.referenceView];
+    for (NSUInteger frame = 1; (self.paneMotionEngine.isRunning && (frame < 600)); frame++) {
+        [self.paneMotionEngine stepMotionToTimestamp:(startTimestamp + (frame * MSTestSampleInterval))];
+        XCTAssertGreaterThanOrEqual(self.paneView.frame.origin.x, 267.0);
+    }
+    XCTAssertFalse(self.paneMotionEngine.isRunning);
+    XCTAssertEqual(self.paneView.frame.origin.x, 267.0);
+    XCTAssertEqual(self.restCount, (NSUInteger)1);
+}
+
+#pragma mark - MSDynamicsDrawerPaneMotionEngineDelegate
+
+- (void)paneMotionEngineDidUpdatePaneView:(id <MSDynamicsDrawerPaneMotionEngine>)paneMotionEngine
+{
+    self.updateCount++;
+}
+
+- (void)paneMotionEngineDidComeToRest:(id <MSDynamicsDrawerPaneMotionEngine>)paneMotionEngine
+{
+    self.restCount++;
+}
+
+@end
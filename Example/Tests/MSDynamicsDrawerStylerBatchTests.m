@@ -0,0 +1,190 @@
+//
+//  MSDynamicsDrawerStylerBatchTests.m
+//  MSDynamicsDrawerViewController
+//
+//  Copyright (c) 2013 Monospace Ltd. All rights reserved.
+//
+//  This code is distributed under the terms and conditions of the MIT license.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#import "MSDynamicsDrawerViewController.h"
+#import "MSDynamicsDrawerStyler.h"
+
+// A styler that records the directions that it was added and removed for
+@interface MSMembershipRecordingStyler : NSObject <MSDynamicsDrawerStyler>
+
+@property (nonatomic, strong) NSMutableArray *addedDirections;
+@property (nonatomic, strong) NSMutableArray *removedDirections;
+
+@end
+
+@implementation MSMembershipRecordingStyler
+
++ (instancetype)styler
+{
+    MSMembershipRecordingStyler *styler = [self new];
+    styler.addedDirections = [NSMutableArray new];
+    styler.removedDirections = [NSMutableArray new];
+    return styler;
+}
+
+- (void)dynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController didUpdatePaneClosedFraction:(CGFloat)paneClosedFraction forDirection:(MSDynamicsDrawerDirection)direction
+{
+    
+}
+
+- (void)stylerWasAddedToDynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController forDirection:(MSDynamicsDrawerDirection)direction
+{
+    [self.addedDirections addObject:@(direction)];
+}
+
+- (void)stylerWasRemovedFromDynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController forDirection:(MSDynamicsDrawerDirection)direction
+{
+    [self.removedDirections addObject:@(direction)];
+}
+
+@end
+
+@interface MSDynamicsDrawerStylerBatchTests : XCTestCase
+
+@property (nonatomic, strong) MSDynamicsDrawerViewController *dynamicsDrawerViewController;
+@property (nonatomic, strong) MSMembershipRecordingStyler *styler;
+
+@end
+
+@implementation MSDynamicsDrawerStylerBatchTests
+
+- (void)setUp
+{
+    [super setUp];
+    
+    // A headless drawer, which is never added to a window
+    self.dynamicsDrawerViewController = [MSDynamicsDrawerViewController new];
+    self.dynamicsDrawerViewController.view.frame = (CGRect){CGPointZero, {320.0, 568.0}};
+    self.dynamicsDrawerViewController.paneViewController = [UIViewController new];
+    self.styler = [MSMembershipRecordingStyler styler];
+}
+
+- (void)tearDown
+{
+    self.dynamicsDrawerViewController = nil;
+    self.styler = nil;
+    [super tearDown];
+}
+
+#pragma mark - Membership
+
+- (void)testStylerIsAddedOnceAcrossDirections
+{
+    [self.dynamicsDrawerViewController addStyler:self.styler forDirection:MSDynamicsDrawerDirectionHorizontal];
+    XCTAssertEqualObjects(self.styler.addedDirections, @[@(MSDynamicsDrawerDirectionHorizontal)]);
+    XCTAssertEqualObjects([self.dynamicsDrawerViewController stylersForDirection:MSDynamicsDrawerDirectionLeft], @[self.styler]);
+    XCTAssertEqualObjects([self.dynamicsDrawerViewController stylersForDirection:MSDynamicsDrawerDirectionRight], @[self.styler]);
+    
+    // Already set in the left direction, so it isn't added again
+    [self.dynamicsDrawerViewController addStyler:self.styler forDirection:MSDynamicsDrawerDirectionLeft];
+    XCTAssertEqual(self.styler.addedDirections.count, (NSUInteger)1);
+    XCTAssertEqualObjects([self.dynamicsDrawerViewController stylersForDirection:MSDynamicsDrawerDirectionLeft], @[self.styler]);
+}
+
+- (void)testStylerIsRemovedOnceNoLongerSetInAnyDirection
+{
+    [self.dynamicsDrawerViewController addStyler:self.styler forDirection:MSDynamicsDrawerDirectionHorizontal];
+    // Adding again in a direction that it's set in doesn't add another reference to it
+    [self.dynamicsDrawerViewController addStyler:self.styler forDirection:MSDynamicsDrawerDirectionLeft];
+    
+    [self.dynamicsDrawerViewController removeStyler:self.styler forDirection:MSDynamicsDrawerDirectionLeft];
+    XCTAssertEqualObjects(self.styler.removedDirections, @[]);
+    XCTAssertEqualObjects([self.dynamicsDrawerViewController stylersForDirection:MSDynamicsDrawerDirectionLeft], @[]);
+    XCTAssertEqualObjects([self.dynamicsDrawerViewController stylersForDirection:MSDynamicsDrawerDirectionRight], @[self.styler]);
+    
+    [self.dynamicsDrawerViewController removeStyler:self.styler forDirection:MSDynamicsDrawerDirectionRight];
+    XCTAssertEqualObjects(self.styler.removedDirections, @[@(MSDynamicsDrawerDirectionRight)]);
+    XCTAssertEqualObjects([self.dynamicsDrawerViewController memoryFootprintReport][@"stylers"], @0);
+    
+    // Removing a styler that isn't set does nothing
+    [self.dynamicsDrawerViewController removeStyler:self.styler forDirection:MSDynamicsDrawerDirectionHorizontal];
+    XCTAssertEqual(self.styler.removedDirections.count, (NSUInteger)1);
+}
+
+#pragma mark - Batches
+
+- (void)testBatchDefersMembershipCallbacksUntilCommitted
+{
+    [self.dynamicsDrawerViewController beginStylerUpdates];
+    [self.dynamicsDrawerViewController addStyler:self.styler forDirection:MSDynamicsDrawerDirectionLeft];
+    // Set immediately, but not yet informed
+    XCTAssertEqualObjects([self.dynamicsDrawerViewController stylersForDirection:MSDynamicsDrawerDirectionLeft], @[self.styler]);
+    XCTAssertEqualObjects(self.styler.addedDirections, @[]);
+    [self.dynamicsDrawerViewController addStyler:self.styler forDirection:MSDynamicsDrawerDirectionRight];
+    [self.dynamicsDrawerViewController commitStylerUpdates];
+    // A single callback for the directions that were added within the batch
+    XCTAssertEqualObjects(self.styler.addedDirections, @[@(MSDynamicsDrawerDirectionHorizontal)]);
+}
+
+- (void)testStylerReaddedWithinBatchIsNotInformed
+{
+    [self.dynamicsDrawerViewController addStyler:self.styler forDirection:MSDynamicsDrawerDirectionLeft];
+    
+    // Swap the styler from the left to the right direction, via no direction at all
+    [self.dynamicsDrawerViewController beginStylerUpdates];
+    [self.dynamicsDrawerViewController removeStyler:self.styler forDirection:MSDynamicsDrawerDirectionLeft];
+    XCTAssertEqualObjects([self.dynamicsDrawerViewController stylersForDirection:MSDynamicsDrawerDirectionLeft], @[]);
+    [self.dynamicsDrawerViewController addStyler:self.styler forDirection:MSDynamicsDrawerDirectionRight];
+    [self.dynamicsDrawerViewController commitStylerUpdates];
+    
+    XCTAssertEqual(self.styler.addedDirections.count, (NSUInteger)1);
+    XCTAssertEqualObjects(self.styler.removedDirections, @[]);
+    XCTAssertEqualObjects([self.dynamicsDrawerViewController stylersForDirection:MSDynamicsDrawerDirectionLeft], @[]);
+    XCTAssertEqualObjects([self.dynamicsDrawerViewController stylersForDirection:MSDynamicsDrawerDirectionRight], @[self.styler]);
+}
+
+- (void)testStylerAddedAndRemovedWithinBatchIsNotInformed
+{
+    [self.dynamicsDrawerViewController beginStylerUpdates];
+    [self.dynamicsDrawerViewController addStyler:self.styler forDirection:MSDynamicsDrawerDirectionLeft];
+    [self.dynamicsDrawerViewController removeStyler:self.styler forDirection:MSDynamicsDrawerDirectionLeft];
+    [self.dynamicsDrawerViewController commitStylerUpdates];
+    XCTAssertEqualObjects(self.styler.addedDirections, @[]);
+    XCTAssertEqualObjects(self.styler.removedDirections, @[]);
+}
+
+- (void)testNestedBatchesOnlyCommitOnTheOutermostCommit
+{
+    MSMembershipRecordingStyler *otherStyler = [MSMembershipRecordingStyler styler];
+    [self.dynamicsDrawerViewController beginStylerUpdates];
+    [self.dynamicsDrawerViewController addStyler:self.styler forDirection:MSDynamicsDrawerDirectionLeft];
+    [self.dynamicsDrawerViewController beginStylerUpdates];
+    [self.dynamicsDrawerViewController addStyler:otherStyler forDirection:MSDynamicsDrawerDirectionRight];
+    [self.dynamicsDrawerViewController commitStylerUpdates];
+    XCTAssertEqualObjects(self.styler.addedDirections, @[]);
+    XCTAssertEqualObjects(otherStyler.addedDirections, @[]);
+    [self.dynamicsDrawerViewController commitStylerUpdates];
+    XCTAssertEqualObjects(self.styler.addedDirections, @[@(MSDynamicsDrawerDirectionLeft)]);
+    XCTAssertEqualObjects(otherStyler.addedDirections, @[@(MSDynamicsDrawerDirectionRight)]);
+    
+    // Stylers are returned in the order they were added
+    [self.dynamicsDrawerViewController addStyler:otherStyler forDirection:MSDynamicsDrawerDirectionLeft];
+    XCTAssertEqualObjects([self.dynamicsDrawerViewController stylersForDirection:MSDynamicsDrawerDirectionLeft], (@[self.styler, otherStyler]));
+}
+
+@end
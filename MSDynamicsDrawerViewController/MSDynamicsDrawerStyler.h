@@ -30,6 +30,28 @@
 #import <UIKit/UIKit.h>
 #import "MSDynamicsDrawerViewController.h"
 
+@class MSDynamicsDrawerStylerComposition;
+
+/**
+ How frequently a styler that modifies views directly is updated as the `paneView` moves.
+ 
+ @see [MSDynamicsDrawerStyler updateGranularityForDynamicsDrawerViewController:]
+ */
+typedef NS_ENUM(NSInteger, MSDynamicsDrawerStylerUpdateGranularity) {
+    /**
+     The styler is updated every time that the layout of the `paneView` changes.
+     */
+    MSDynamicsDrawerStylerUpdateGranularityContinuous,
+    /**
+     The styler is updated once the `currentRevealWidth` has changed by the distance returned from `updateDistanceForDynamicsDrawerViewController:`, and when the `paneView` comes to rest.
+     */
+    MSDynamicsDrawerStylerUpdateGranularityDistance,
+    /**
+     The styler is only updated when the `paneView` is at rest, or when the direction changes.
+     */
+    MSDynamicsDrawerStylerUpdateGranularityRest,
+};
+
 /**
  `MSDynamicsDrawerStyler` is a protocol that defines the interface for an object that can style a `MSDynamicsDrawerViewController`. Instances of `MSDynamicsDrawerStyler` are added to `MSDynamicsDrawerViewController` via the `addStyler:forDirection:` method.
  
@@ -57,6 +79,53 @@
 
 @optional
 
+/**
+ Invoked when the `MSDynamicsDrawerViewController` has an update to the layout of its pane.
+ 
+ If implemented, this method is invoked instead of `dynamicsDrawerViewController:didUpdatePaneClosedFraction:forDirection:`. The layout is computed once per update and shared between all stylers, so stylers that depend on the pane geometry should prefer the values within `layout` to querying the `MSDynamicsDrawerViewController` instance.
+ 
+ @param dynamicsDrawerViewController The `MSDynamicsDrawerViewController` that is being styled by the `MSDynamicsDrawerStyler` instance.
+ @param layout The layout of the `MSDynamicsDrawerViewController` instance's pane.
+ */
+- (void)dynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController didUpdateLayout:(MSDynamicsDrawerLayout)layout;
+
+/**
+ Invoked when the `MSDynamicsDrawerViewController` has an update to the layout of its pane, allowing the styler to contribute its styling to a composition that is shared between all stylers.
+ 
+ If implemented, this method is invoked instead of both `dynamicsDrawerViewController:didUpdateLayout:` and `dynamicsDrawerViewController:didUpdatePaneClosedFraction:forDirection:`. Rather than modifying views directly, the styler should describe its styling via `composition`, as a function of `layout` alone. This method can also be invoked for layouts that are not yet on screen, in order to sample the styling along the trajectory of a transition that is performed with Core Animation (see `coreAnimationTransitionsEnabled`). Once all stylers have been updated, the `MSDynamicsDrawerViewController` instance applies the composition once, within a single `CATransaction` with actions disabled. Since contributions are combined independently of the order in which stylers are updated, compositing stylers can be combined deterministically.
+ 
+ @param dynamicsDrawerViewController The `MSDynamicsDrawerViewController` that is being styled by the `MSDynamicsDrawerStyler` instance.
+ @param layout The layout of the `MSDynamicsDrawerViewController` instance's pane.
+ @param composition The composition that the styler should contribute to.
+ */
+- (void)dynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController didUpdateLayout:(MSDynamicsDrawerLayout)layout composition:(MSDynamicsDrawerStylerComposition *)composition;
+
+/**
+ Queried for how frequently the styler should be updated as the `paneView` moves.
+ 
+ Stylers that are expensive to update can opt into fewer updates. Queried once when the styler is added, and ignored by compositing stylers, which are always updated together. If not implemented, the styler is updated continuously.
+ 
+ @param dynamicsDrawerViewController The `MSDynamicsDrawerViewController` that is being styled by the `MSDynamicsDrawerStyler` instance.
+ 
+ @return The update granularity of the styler.
+ 
+ @see updateDistanceForDynamicsDrawerViewController:
+ */
+- (MSDynamicsDrawerStylerUpdateGranularity)updateGranularityForDynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController;
+
+/**
+ Queried for the distance (in points) that the `currentRevealWidth` must change by between updates of a styler with an update granularity of `MSDynamicsDrawerStylerUpdateGranularityDistance`.
+ 
+ Queried once when the styler is added. If not implemented, the styler is updated continuously.
+ 
+ @param dynamicsDrawerViewController The `MSDynamicsDrawerViewController` that is being styled by the `MSDynamicsDrawerStyler` instance.
+ 
+ @return The update distance (in points) of the styler.
+ 
+ @see updateGranularityForDynamicsDrawerViewController:
+ */
+- (CGFloat)updateDistanceForDynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController;
+
 /**
  Used to set up the appearance of the styler when it is added to a `MSDynamicsDrawerViewController` instance.
  
@@ -78,6 +147,52 @@
 
 @end
 
+/**
+ Accumulates the styling that compositing stylers contribute for a single update of a `MSDynamicsDrawerViewController` instance's pane.
+ 
+ Each attribute of the composition is only applied if at least one styler has contributed to it, so compositing stylers can be combined with stylers that modify views directly, as long as they don't style the same attributes.
+ 
+ @see [MSDynamicsDrawerStyler dynamicsDrawerViewController:didUpdateLayout:composition:]
+ */
+@interface MSDynamicsDrawerStylerComposition : NSObject
+
+/**
+ Offsets the `drawerView` by the specified translation. Translations from multiple stylers are summed.
+ 
+ @param translation The translation that should be applied to the `drawerView`.
+ */
+- (void)translateDrawerViewBy:(CGPoint)translation;
+
+/**
+ Scales the `drawerView` by the specified scale. Scales from multiple stylers are multiplied.
+ 
+ @param scale The scale that should be applied to the `drawerView`.
+ */
+- (void)scaleDrawerViewBy:(CGFloat)scale;
+
+/**
+ Fades the `drawerView` by the specified alpha. Alphas from multiple stylers are multiplied.
+ 
+ @param alpha The alpha that should be applied to the `drawerView`.
+ */
+- (void)fadeDrawerViewBy:(CGFloat)alpha;
+
+/**
+ Sets the frame of the visible drawer view controller's view. If multiple stylers set a frame, the last one wins.
+ 
+ @param frame The frame that the drawer view controller's view should have.
+ */
+- (void)setDrawerViewControllerViewFrame:(CGRect)frame;
+
+/**
+ Sets the layer that renders the shadow of the `paneView`. The layer is inserted as the bottommost sublayer of the `paneView` layer, replacing the previously set shadow layer. If multiple stylers set a shadow layer, the last one wins.
+ 
+ @param shadowLayer The layer that renders the shadow of the `paneView`, or `nil` if the pane shouldn't have a shadow.
+ */
+- (void)setPaneShadowLayer:(CALayer *)shadowLayer;
+
+@end
+
 /**
  Creates a parallax effect on the `drawerView` while sliding the `paneView` within a `MSDynamicsDrawerViewController`.
  */
@@ -130,6 +245,15 @@
  */
 @property (nonatomic, assign) CGFloat minimumResizeRevealWidth;
 
+/**
+ The increment (in points) that the drawer view controller's view is resized in while the `paneView` is moving.
+ 
+ Resizing the drawer view controller's view causes it to lay out its subviews, which is expensive to do on every frame of a pane motion. When this value is greater than `0`, the drawer view controller's view is only resized when the `currentRevealWidth` crosses into a different multiple of this increment while the `paneView` is moving, and is sized up to the next multiple so that it always covers the visible area of the drawer. Resizing back down to a smaller multiple is subject to hysteresis of half an increment, so that small back-and-forth movements do not cause repeated resizes. Once the `paneView` comes to rest, the drawer view controller's view is resized to exactly fit the `currentRevealWidth`.
+ 
+ Default value of `0.0`, which resizes the drawer view controller's view on every update.
+ */
+@property (nonatomic, assign) CGFloat resizeIncrement;
+
 @end
 
 /**
@@ -165,4 +289,11 @@
  */
 @property (nonatomic, assign) CGSize shadowOffset;
 
+/**
+ Whether the shadow should be rendered from a prerendered gradient image rather than with a Core Animation shadow.
+ 
+ Core Animation shadows are blurred when rendered, which requires an offscreen pass for every frame that the `paneView` moves. When enabled, the shadow is instead approximated by a gradient image that is rendered once, stretched along the edge of the `paneView` that is exposed by the drawer. Gradient images are cached by their color, radius, opacity, and edge, and are shared between all shadow stylers. Defaults to `NO`.
+ */
+@property (nonatomic, assign) BOOL prerenderedShadowEnabled;
+
 @end
@@ -50,30 +50,56 @@
 
 - (void)dynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController didUpdatePaneClosedFraction:(CGFloat)paneClosedFraction forDirection:(MSDynamicsDrawerDirection)direction
 {
-    CGFloat paneRevealWidth = [dynamicsDrawerViewController revealWidthForDirection:direction];
+    [self styleDynamicsDrawerViewController:dynamicsDrawerViewController paneClosedFraction:paneClosedFraction revealWidth:[dynamicsDrawerViewController revealWidthForDirection:direction] direction:direction];
+}
+
+- (void)dynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController didUpdateLayout:(MSDynamicsDrawerLayout)layout
+{
+    [self styleDynamicsDrawerViewController:dynamicsDrawerViewController paneClosedFraction:layout.paneClosedFraction revealWidth:layout.revealWidth direction:layout.direction];
+}
+
+- (void)dynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController didUpdateLayout:(MSDynamicsDrawerLayout)layout composition:(MSDynamicsDrawerStylerComposition *)composition
+{
+    [composition translateDrawerViewBy:[self translationForPaneClosedFraction:layout.paneClosedFraction revealWidth:layout.revealWidth direction:layout.direction]];
+}
+
+- (void)stylerWasRemovedFromDynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController forDirection:(MSDynamicsDrawerDirection)direction
+{
+    CGAffineTransform translate = CGAffineTransformMakeTranslation(0.0, 0.0);
+    CGAffineTransform drawerViewTransform = dynamicsDrawerViewController.drawerView.transform;
+    drawerViewTransform.tx = translate.tx;
+    drawerViewTransform.ty = translate.ty;
+    dynamicsDrawerViewController.drawerView.transform = drawerViewTransform;
+}
+
+#pragma mark - MSDynamicsDrawerParallaxStyler
+
+- (CGPoint)translationForPaneClosedFraction:(CGFloat)paneClosedFraction revealWidth:(CGFloat)paneRevealWidth direction:(MSDynamicsDrawerDirection)direction
+{
     CGFloat translate = ((paneRevealWidth * paneClosedFraction) * self.parallaxOffsetFraction);
     if (direction & (MSDynamicsDrawerDirectionTop | MSDynamicsDrawerDirectionLeft)) {
         translate = -translate;
     }
-    CGAffineTransform drawerViewTransform = dynamicsDrawerViewController.drawerView.transform;
     if (direction & MSDynamicsDrawerDirectionHorizontal) {
-        drawerViewTransform.tx = CGAffineTransformMakeTranslation(translate, 0.0).tx;
+        return (CGPoint){translate, 0.0};
     } else if (direction & MSDynamicsDrawerDirectionVertical) {
-        drawerViewTransform.ty = CGAffineTransformMakeTranslation(0.0, translate).ty;
-    } else {
-        CGAffineTransform translateTransform = CGAffineTransformMakeTranslation(0.0, 0.0);
-        drawerViewTransform.tx = translateTransform.tx;
-        drawerViewTransform.ty = translateTransform.ty;
+        return (CGPoint){0.0, translate};
     }
-    dynamicsDrawerViewController.drawerView.transform = drawerViewTransform;
+    return CGPointZero;
 }
 
-- (void)stylerWasRemovedFromDynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController forDirection:(MSDynamicsDrawerDirection)direction
+- (void)styleDynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController paneClosedFraction:(CGFloat)paneClosedFraction revealWidth:(CGFloat)paneRevealWidth direction:(MSDynamicsDrawerDirection)direction
 {
-    CGAffineTransform translate = CGAffineTransformMakeTranslation(0.0, 0.0);
+    CGPoint translation = [self translationForPaneClosedFraction:paneClosedFraction revealWidth:paneRevealWidth direction:direction];
     CGAffineTransform drawerViewTransform = dynamicsDrawerViewController.drawerView.transform;
-    drawerViewTransform.tx = translate.tx;
-    drawerViewTransform.ty = translate.ty;
+    if (direction & MSDynamicsDrawerDirectionHorizontal) {
+        drawerViewTransform.tx = translation.x;
+    } else if (direction & MSDynamicsDrawerDirectionVertical) {
+        drawerViewTransform.ty = translation.y;
+    } else {
+        drawerViewTransform.tx = 0.0;
+        drawerViewTransform.ty = 0.0;
+    }
     dynamicsDrawerViewController.drawerView.transform = drawerViewTransform;
 }
 
@@ -101,11 +127,12 @@
 
 - (void)dynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController didUpdatePaneClosedFraction:(CGFloat)paneClosedFraction forDirection:(MSDynamicsDrawerDirection)direction
 {
-    if (direction & MSDynamicsDrawerDirectionAll) {
-        dynamicsDrawerViewController.drawerView.alpha = ((1.0 - self.closedAlpha) * (1.0  - paneClosedFraction));
-    } else {
-        dynamicsDrawerViewController.drawerView.alpha = 1.0;
-    }
+    dynamicsDrawerViewController.drawerView.alpha = [self alphaForPaneClosedFraction:paneClosedFraction direction:direction];
+}
+
+- (void)dynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController didUpdateLayout:(MSDynamicsDrawerLayout)layout composition:(MSDynamicsDrawerStylerComposition *)composition
+{
+    [composition fadeDrawerViewBy:[self alphaForPaneClosedFraction:layout.paneClosedFraction direction:layout.direction]];
 }
 
 - (void)stylerWasRemovedFromDynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController forDirection:(MSDynamicsDrawerDirection)direction
@@ -113,6 +140,16 @@
     dynamicsDrawerViewController.drawerView.alpha = 1.0;
 }
 
+#pragma mark - MSDynamicsDrawerFadeStyler
+
+- (CGFloat)alphaForPaneClosedFraction:(CGFloat)paneClosedFraction direction:(MSDynamicsDrawerDirection)direction
+{
+    if (direction & MSDynamicsDrawerDirectionAll) {
+        return ((1.0 - self.closedAlpha) * (1.0  - paneClosedFraction));
+    }
+    return 1.0;
+}
+
 @end
 
 @implementation MSDynamicsDrawerScaleStyler
@@ -137,12 +174,7 @@
 
 - (void)dynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController didUpdatePaneClosedFraction:(CGFloat)paneClosedFraction forDirection:(MSDynamicsDrawerDirection)direction
 {
-    CGFloat scale;
-    if (direction & MSDynamicsDrawerDirectionAll) {
-        scale = (1.0 - (paneClosedFraction * self.closedScale));
-    } else {
-        scale = 1.0;
-    }
+    CGFloat scale = [self scaleForPaneClosedFraction:paneClosedFraction direction:direction];
     CGAffineTransform scaleTransform = CGAffineTransformMakeScale(scale, scale);
     CGAffineTransform drawerViewTransform = dynamicsDrawerViewController.drawerView.transform;
     drawerViewTransform.a = scaleTransform.a;
@@ -150,6 +182,11 @@
     dynamicsDrawerViewController.drawerView.transform = drawerViewTransform;
 }
 
+- (void)dynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController didUpdateLayout:(MSDynamicsDrawerLayout)layout composition:(MSDynamicsDrawerStylerComposition *)composition
+{
+    [composition scaleDrawerViewBy:[self scaleForPaneClosedFraction:layout.paneClosedFraction direction:layout.direction]];
+}
+
 - (void)stylerWasRemovedFromDynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController forDirection:(MSDynamicsDrawerDirection)direction
 {
     CGAffineTransform scaleTransform = CGAffineTransformMakeScale(1.0, 1.0);
@@ -159,11 +196,23 @@
     dynamicsDrawerViewController.drawerView.transform = drawerViewTransform;
 }
 
+#pragma mark - MSDynamicsDrawerScaleStyler
+
+- (CGFloat)scaleForPaneClosedFraction:(CGFloat)paneClosedFraction direction:(MSDynamicsDrawerDirection)direction
+{
+    if (direction & MSDynamicsDrawerDirectionAll) {
+        return (1.0 - (paneClosedFraction * self.closedScale));
+    }
+    return 1.0;
+}
+
 @end
 
 @interface MSDynamicsDrawerResizeStyler ()
 
 @property (nonatomic, assign) BOOL useRevealWidthAsMinimumResizeRevealWidth;
+@property (nonatomic, assign) CGFloat incrementedResizeRevealWidth;
+@property (nonatomic, assign) MSDynamicsDrawerDirection incrementedResizeDirection;
 
 @end
 
@@ -192,45 +241,91 @@
     if (direction == MSDynamicsDrawerDirectionNone) {
         return;
     }
-    
+    // Without a layout, there's no way to tell whether the pane is moving, so always resize exactly
+    [self styleDynamicsDrawerViewController:dynamicsDrawerViewController direction:direction revealWidth:[dynamicsDrawerViewController revealWidthForDirection:direction] currentRevealWidth:dynamicsDrawerViewController.currentRevealWidth paneViewFrame:dynamicsDrawerViewController.paneView.frame paneViewResting:YES];
+}
+
+- (void)dynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController didUpdateLayout:(MSDynamicsDrawerLayout)layout
+{
+    if (layout.direction == MSDynamicsDrawerDirectionNone) {
+        return;
+    }
+    [self styleDynamicsDrawerViewController:dynamicsDrawerViewController direction:layout.direction revealWidth:layout.revealWidth currentRevealWidth:layout.currentRevealWidth paneViewFrame:layout.paneViewFrame paneViewResting:layout.paneViewResting];
+}
+
+- (void)dynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController didUpdateLayout:(MSDynamicsDrawerLayout)layout composition:(MSDynamicsDrawerStylerComposition *)composition
+{
+    if (layout.direction == MSDynamicsDrawerDirectionNone) {
+        return;
+    }
+    UIView *drawerViewControllerView = [[dynamicsDrawerViewController drawerViewControllerForDirection:layout.direction] view];
+    [composition setDrawerViewControllerViewFrame:[self drawerViewControllerViewFrame:drawerViewControllerView.frame forDirection:layout.direction revealWidth:layout.revealWidth currentRevealWidth:layout.currentRevealWidth paneViewFrame:layout.paneViewFrame paneViewResting:layout.paneViewResting]];
+}
+
+- (void)stylerWasRemovedFromDynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController forDirection:(MSDynamicsDrawerDirection)direction
+{
+    // Reset the drawer view controller's view to be the size of the drawerView (before the styler was added)
     CGRect drawerViewFrame = [[dynamicsDrawerViewController drawerViewControllerForDirection:direction] view].frame;
-    
-    CGFloat minimumResizeRevealWidth = (self.useRevealWidthAsMinimumResizeRevealWidth ? [dynamicsDrawerViewController revealWidthForDirection:direction] : self.minimumResizeRevealWidth);
-    if (dynamicsDrawerViewController.currentRevealWidth < minimumResizeRevealWidth) {
-        drawerViewFrame.size.width = [dynamicsDrawerViewController revealWidthForDirection:direction];
-    } else {
-        if (direction & MSDynamicsDrawerDirectionHorizontal) {
-            drawerViewFrame.size.width = dynamicsDrawerViewController.currentRevealWidth;
-        } else if (direction & MSDynamicsDrawerDirectionVertical) {
-            drawerViewFrame.size.height = dynamicsDrawerViewController.currentRevealWidth;
-        }
+    drawerViewFrame.size = dynamicsDrawerViewController.drawerView.frame.size;
+    [[dynamicsDrawerViewController drawerViewControllerForDirection:direction] view].frame = drawerViewFrame;
+}
+
+#pragma mark - MSDynamicsDrawerResizeStyler
+
+- (void)styleDynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController direction:(MSDynamicsDrawerDirection)direction revealWidth:(CGFloat)revealWidth currentRevealWidth:(CGFloat)currentRevealWidth paneViewFrame:(CGRect)paneViewFrame paneViewResting:(BOOL)paneViewResting
+{
+    UIView *drawerViewControllerView = [[dynamicsDrawerViewController drawerViewControllerForDirection:direction] view];
+    CGRect drawerViewControllerViewFrame = [self drawerViewControllerViewFrame:drawerViewControllerView.frame forDirection:direction revealWidth:revealWidth currentRevealWidth:currentRevealWidth paneViewFrame:paneViewFrame paneViewResting:paneViewResting];
+    // Only touch the frame when it changes, as setting a frame (even an identical one) can trigger a layout pass
+    if (!CGRectEqualToRect(drawerViewControllerView.frame, drawerViewControllerViewFrame)) {
+        drawerViewControllerView.frame = drawerViewControllerViewFrame;
+    }
+}
+
+- (CGRect)drawerViewControllerViewFrame:(CGRect)drawerViewFrame forDirection:(MSDynamicsDrawerDirection)direction revealWidth:(CGFloat)revealWidth currentRevealWidth:(CGFloat)currentRevealWidth paneViewFrame:(CGRect)paneViewFrame paneViewResting:(BOOL)paneViewResting
+{
+    CGFloat minimumResizeRevealWidth = (self.useRevealWidthAsMinimumResizeRevealWidth ? revealWidth : self.minimumResizeRevealWidth);
+    CGFloat resizeRevealWidth = ((currentRevealWidth < minimumResizeRevealWidth) ? revealWidth : [self resizeRevealWidthForCurrentRevealWidth:currentRevealWidth direction:direction paneViewResting:paneViewResting]);
+    if (direction & MSDynamicsDrawerDirectionHorizontal) {
+        drawerViewFrame.size.width = resizeRevealWidth;
+    } else if (direction & MSDynamicsDrawerDirectionVertical) {
+        drawerViewFrame.size.height = resizeRevealWidth;
     }
     
-    CGRect paneViewFrame = dynamicsDrawerViewController.paneView.frame;
+    // Drawers that open from the trailing edges are pinned to the trailing edge of the pane along their axis
     switch (direction) {
         case MSDynamicsDrawerDirectionRight:
             drawerViewFrame.origin.x = CGRectGetMaxX(paneViewFrame);
             break;
         case MSDynamicsDrawerDirectionBottom:
-            drawerViewFrame.origin.x = CGRectGetMaxY(paneViewFrame);
+            drawerViewFrame.origin.y = CGRectGetMaxY(paneViewFrame);
             break;
         default:
             break;
     }
     
-    [[dynamicsDrawerViewController drawerViewControllerForDirection:direction] view].frame = drawerViewFrame;
+    return drawerViewFrame;
 }
 
-- (void)stylerWasRemovedFromDynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController forDirection:(MSDynamicsDrawerDirection)direction
+- (CGFloat)resizeRevealWidthForCurrentRevealWidth:(CGFloat)currentRevealWidth direction:(MSDynamicsDrawerDirection)direction paneViewResting:(BOOL)paneViewResting
 {
-    // Reset the drawer view controller's view to be the size of the drawerView (before the styler was added)
-    CGRect drawerViewFrame = [[dynamicsDrawerViewController drawerViewControllerForDirection:direction] view].frame;
-    drawerViewFrame.size = dynamicsDrawerViewController.drawerView.frame.size;
-    [[dynamicsDrawerViewController drawerViewControllerForDirection:direction] view].frame = drawerViewFrame;
+    CGFloat resizeIncrement = self.resizeIncrement;
+    // A resting pane is always resized exactly, and the next motion starts from a fresh increment
+    if (paneViewResting || (resizeIncrement <= 0.0)) {
+        self.incrementedResizeRevealWidth = 0.0;
+        return currentRevealWidth;
+    }
+    CGFloat incrementedResizeRevealWidth = self.incrementedResizeRevealWidth;
+    // Grow as soon as the current reveal width is no longer covered, but only shrink once it has receded half an increment past the next lower multiple
+    BOOL exceedsIncrement = (currentRevealWidth > incrementedResizeRevealWidth);
+    BOOL recedesIncrement = (currentRevealWidth <= (incrementedResizeRevealWidth - (resizeIncrement * 1.5)));
+    if ((direction != self.incrementedResizeDirection) || (incrementedResizeRevealWidth <= 0.0) || exceedsIncrement || recedesIncrement) {
+        self.incrementedResizeDirection = direction;
+        self.incrementedResizeRevealWidth = (ceil(currentRevealWidth / resizeIncrement) * resizeIncrement);
+    }
+    return self.incrementedResizeRevealWidth;
 }
 
-#pragma mark - MSDynamicsDrawerResizeStyler
-
 - (void)setMinimumResizeRevealWidth:(CGFloat)minimumResizeRevealWidth
 {
     self.useRevealWidthAsMinimumResizeRevealWidth = NO;
@@ -239,9 +334,16 @@
 
 @end
 
+// The number of color stops used to approximate the Gaussian falloff of a prerendered shadow
+enum { MSPrerenderedShadowGradientStopCount = 8 };
+
 @interface MSDynamicsDrawerShadowStyler ()
 
 @property (nonatomic, strong) CALayer *shadowLayer;
+// The pane view size and direction that the shadow layer was last laid out for
+@property (nonatomic, assign) CGSize shadowLayerPaneViewSize;
+@property (nonatomic, assign) MSDynamicsDrawerDirection shadowLayerDirection;
+@property (nonatomic, assign) BOOL shadowLayerNeedsLayout;
 
 @end
 
@@ -257,21 +359,10 @@
         self.shadowRadius = 10.0;
 		self.shadowOpacity = 1.0;
         self.shadowOffset = CGSizeZero;
-        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(applicationDidChangeStatusBarOrientation:) name:UIApplicationDidChangeStatusBarOrientationNotification object:nil];
     }
     return self;
 }
 
-- (void)dealloc
-{
-    [[NSNotificationCenter defaultCenter] removeObserver:self];
-}
-
-- (void)applicationDidChangeStatusBarOrientation:(NSNotification *)notification
-{
-    [self.shadowLayer removeFromSuperlayer];
-}
-
 #pragma mark - MSDynamicsDrawerStyler
 
 + (instancetype)styler
@@ -282,24 +373,14 @@
 - (void)stylerWasAddedToDynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController forDirection:(MSDynamicsDrawerDirection)direction
 {
 	self.shadowLayer = [CALayer layer];
-	self.shadowLayer.shadowPath = [[UIBezierPath bezierPathWithRect:dynamicsDrawerViewController.paneView.frame] CGPath];
-    self.shadowLayer.shadowColor = self.shadowColor.CGColor;
-    self.shadowLayer.shadowOpacity = self.shadowOpacity;
-    self.shadowLayer.shadowRadius = self.shadowRadius;
-    self.shadowLayer.shadowOffset = self.shadowOffset;
+    [self setNeedsShadowLayerLayout];
 }
 
 - (void)dynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController didUpdatePaneClosedFraction:(CGFloat)paneClosedFraction forDirection:(MSDynamicsDrawerDirection)direction
 {    
     if (direction & MSDynamicsDrawerDirectionAll) {
+        [self layoutShadowLayerForPaneViewSize:dynamicsDrawerViewController.paneView.frame.size direction:direction];
         if (!self.shadowLayer.superlayer) {
-            CGRect shadowRect = (CGRect){CGPointZero, dynamicsDrawerViewController.paneView.frame.size};
-            if (direction & MSDynamicsDrawerDirectionHorizontal) {
-                shadowRect = CGRectInset(shadowRect, 0.0, -self.shadowRadius);
-            } else if (direction & MSDynamicsDrawerDirectionVertical) {
-                shadowRect = CGRectInset(shadowRect, -self.shadowRadius, 0.0);
-            }
-            self.shadowLayer.shadowPath = [[UIBezierPath bezierPathWithRect:shadowRect] CGPath];
             [dynamicsDrawerViewController.paneView.layer insertSublayer:self.shadowLayer atIndex:0];
         }
     } else {
@@ -307,6 +388,17 @@
     }
 }
 
+- (void)dynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController didUpdateLayout:(MSDynamicsDrawerLayout)layout composition:(MSDynamicsDrawerStylerComposition *)composition
+{
+    if (layout.direction & MSDynamicsDrawerDirectionAll) {
+        // The composition inserts the shadow layer once it is applied
+        [self layoutShadowLayerForPaneViewSize:layout.paneViewFrame.size direction:layout.direction];
+        [composition setPaneShadowLayer:self.shadowLayer];
+    } else {
+        [composition setPaneShadowLayer:nil];
+    }
+}
+
 - (void)stylerWasRemovedFromDynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController forDirection:(MSDynamicsDrawerDirection)direction
 {
 	[self.shadowLayer removeFromSuperlayer];
@@ -315,11 +407,157 @@
 
 #pragma mark - MSDynamicsDrawerShadowStyler
 
+- (void)setNeedsShadowLayerLayout
+{
+    self.shadowLayerNeedsLayout = YES;
+    // If the shadow is visible, update it immediately rather than on the next styling
+    if (self.shadowLayer.superlayer) {
+        [self layoutShadowLayerForPaneViewSize:self.shadowLayerPaneViewSize direction:self.shadowLayerDirection];
+    }
+}
+
+- (void)layoutShadowLayerForPaneViewSize:(CGSize)paneViewSize direction:(MSDynamicsDrawerDirection)direction
+{
+    // Only lay out the shadow when the pane view is resized (e.g. on rotation), the direction changes, or the shadow's attributes change
+    if (!self.shadowLayerNeedsLayout && CGSizeEqualToSize(paneViewSize, self.shadowLayerPaneViewSize) && (direction == self.shadowLayerDirection)) {
+        return;
+    }
+    self.shadowLayerNeedsLayout = NO;
+    self.shadowLayerPaneViewSize = paneViewSize;
+    self.shadowLayerDirection = direction;
+    
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    if (self.prerenderedShadowEnabled) {
+        self.shadowLayer.shadowOpacity = 0.0;
+        self.shadowLayer.shadowPath = NULL;
+        self.shadowLayer.contents = (id)[[[self class] prerenderedShadowImageWithColor:self.shadowColor radius:self.shadowRadius opacity:self.shadowOpacity direction:direction] CGImage];
+        self.shadowLayer.frame = [self prerenderedShadowFrameForPaneViewSize:paneViewSize direction:direction];
+    } else {
+        self.shadowLayer.contents = nil;
+        self.shadowLayer.frame = CGRectZero;
+        self.shadowLayer.shadowColor = self.shadowColor.CGColor;
+        self.shadowLayer.shadowOpacity = self.shadowOpacity;
+        self.shadowLayer.shadowRadius = self.shadowRadius;
+        self.shadowLayer.shadowOffset = self.shadowOffset;
+        CGRect shadowRect = (CGRect){CGPointZero, paneViewSize};
+        if (direction & MSDynamicsDrawerDirectionHorizontal) {
+            shadowRect = CGRectInset(shadowRect, 0.0, -self.shadowRadius);
+        } else if (direction & MSDynamicsDrawerDirectionVertical) {
+            shadowRect = CGRectInset(shadowRect, -self.shadowRadius, 0.0);
+        }
+        self.shadowLayer.shadowPath = [[UIBezierPath bezierPathWithRect:shadowRect] CGPath];
+    }
+    [CATransaction commit];
+}
+
+- (CGRect)prerenderedShadowFrameForPaneViewSize:(CGSize)paneViewSize direction:(MSDynamicsDrawerDirection)direction
+{
+    // The shadow is a strip along the edge of the pane that is exposed when opening in the direction
+    CGFloat shadowWidth = self.shadowRadius;
+    CGRect shadowFrame;
+    switch (direction) {
+        case MSDynamicsDrawerDirectionLeft:
+            shadowFrame = (CGRect){{-shadowWidth, 0.0}, {shadowWidth, paneViewSize.height}};
+            break;
+        case MSDynamicsDrawerDirectionRight:
+            shadowFrame = (CGRect){{paneViewSize.width, 0.0}, {shadowWidth, paneViewSize.height}};
+            break;
+        case MSDynamicsDrawerDirectionTop:
+            shadowFrame = (CGRect){{0.0, -shadowWidth}, {paneViewSize.width, shadowWidth}};
+            break;
+        case MSDynamicsDrawerDirectionBottom:
+            shadowFrame = (CGRect){{0.0, paneViewSize.height}, {paneViewSize.width, shadowWidth}};
+            break;
+        default:
+            shadowFrame = CGRectZero;
+            break;
+    }
+    return CGRectOffset(shadowFrame, self.shadowOffset.width, self.shadowOffset.height);
+}
+
++ (UIImage *)prerenderedShadowImageWithColor:(UIColor *)color radius:(CGFloat)radius opacity:(CGFloat)opacity direction:(MSDynamicsDrawerDirection)direction
+{
+    if ((radius <= 0.0) || !color) {
+        return nil;
+    }
+    // Shared between all shadow stylers, as the image only depends on its attributes
+    static NSCache *prerenderedShadowImageCache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        prerenderedShadowImageCache = [NSCache new];
+    });
+    NSString *cacheKey = [NSString stringWithFormat:@"%@-%f-%f-%ld", color, radius, opacity, (long)direction];
+    UIImage *prerenderedShadowImage = [prerenderedShadowImageCache objectForKey:cacheKey];
+    if (prerenderedShadowImage) {
+        return prerenderedShadowImage;
+    }
+    
+    // The image is a single point thick across the edge, and is stretched along the edge by the layer
+    BOOL horizontal = ((direction & MSDynamicsDrawerDirectionHorizontal) != 0);
+    CGSize imageSize = (horizontal ? (CGSize){ceil(radius), 1.0} : (CGSize){1.0, ceil(radius)});
+    // The gradient starts at the edge of the pane, and falls off away from it
+    CGPoint startPoint;
+    CGPoint endPoint;
+    switch (direction) {
+        case MSDynamicsDrawerDirectionLeft:
+            startPoint = (CGPoint){imageSize.width, 0.0};
+            endPoint = CGPointZero;
+            break;
+        case MSDynamicsDrawerDirectionRight:
+            startPoint = CGPointZero;
+            endPoint = (CGPoint){imageSize.width, 0.0};
+            break;
+        case MSDynamicsDrawerDirectionTop:
+            startPoint = (CGPoint){0.0, imageSize.height};
+            endPoint = CGPointZero;
+            break;
+        default:
+            startPoint = CGPointZero;
+            endPoint = (CGPoint){0.0, imageSize.height};
+            break;
+    }
+    
+    // Approximate the falloff of a Gaussian blur of the pane's edge (with a standard deviation of half of the radius, as Core Animation does), which is half of its intensity at the edge itself
+    CGFloat colorAlpha = CGColorGetAlpha(color.CGColor);
+    NSMutableArray *colors = [NSMutableArray arrayWithCapacity:MSPrerenderedShadowGradientStopCount];
+    CGFloat locations[MSPrerenderedShadowGradientStopCount];
+    for (NSUInteger stop = 0; stop < MSPrerenderedShadowGradientStopCount; stop++) {
+        CGFloat location = ((CGFloat)stop / (MSPrerenderedShadowGradientStopCount - 1));
+        CGFloat distance = (location * radius);
+        CGFloat intensity = (0.5 * erfc(distance / ((radius / 2.0) * M_SQRT2)));
+        locations[stop] = location;
+        [colors addObject:(id)[[color colorWithAlphaComponent:(colorAlpha * opacity * intensity)] CGColor]];
+    }
+    
+    UIGraphicsBeginImageContextWithOptions(imageSize, NO, 0.0);
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGGradientRef gradient = CGGradientCreateWithColors(colorSpace, (__bridge CFArrayRef)colors, locations);
+    CGContextDrawLinearGradient(UIGraphicsGetCurrentContext(), gradient, startPoint, endPoint, 0);
+    CGGradientRelease(gradient);
+    CGColorSpaceRelease(colorSpace);
+    prerenderedShadowImage = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    
+    if (prerenderedShadowImage) {
+        [prerenderedShadowImageCache setObject:prerenderedShadowImage forKey:cacheKey];
+    }
+    return prerenderedShadowImage;
+}
+
+- (void)setPrerenderedShadowEnabled:(BOOL)prerenderedShadowEnabled
+{
+    if (_prerenderedShadowEnabled != prerenderedShadowEnabled) {
+        _prerenderedShadowEnabled = prerenderedShadowEnabled;
+        [self setNeedsShadowLayerLayout];
+    }
+}
+
 - (void)setShadowColor:(UIColor *)shadowColor
 {
     if (_shadowColor != shadowColor) {
         _shadowColor = shadowColor;
-        self.shadowLayer.shadowColor = [shadowColor CGColor];
+        [self setNeedsShadowLayerLayout];
     }
 }
 
@@ -327,7 +565,7 @@
 {
     if (_shadowOpacity != shadowOpacity) {
         _shadowOpacity = shadowOpacity;
-        self.shadowLayer.shadowOpacity = shadowOpacity;
+        [self setNeedsShadowLayerLayout];
     }
 }
 
@@ -335,7 +573,7 @@
 {
     if (_shadowRadius != shadowRadius) {
         _shadowRadius = shadowRadius;
-        self.shadowLayer.shadowRadius = shadowRadius;
+        [self setNeedsShadowLayerLayout];
     }
 }
 
@@ -343,7 +581,7 @@
 {
     if (!CGSizeEqualToSize(_shadowOffset, shadowOffset)) {
         _shadowOffset = shadowOffset;
-        self.shadowLayer.shadowOffset = shadowOffset;
+        [self setNeedsShadowLayerLayout];
     }
 }
 
@@ -31,9 +31,15 @@
 
 @protocol MSDynamicsDrawerStyler;
 @protocol MSDynamicsDrawerViewControllerDelegate;
+@protocol MSDynamicsDrawerPaneMotionEngine;
+@protocol MSDynamicsDrawerPaneMotionEngineDelegate;
+@protocol MSDynamicsDrawerStatusBarAligner;
+@class MSDynamicsDrawerTransitionMetrics;
+@class MSDynamicsDrawerGestureRecorder;
 
 extern const CGFloat MSDynamicsDrawerDefaultOpenStateRevealWidthHorizontal;
 extern const CGFloat MSDynamicsDrawerDefaultOpenStateRevealWidthVertical;
+extern const CGFloat MSPaneViewScreenEdgeThreshold;
 
 /**
  The drawer direction defines the direction that a `MSDynamicsDrawerViewController` instance's `paneView` can be opened in.
@@ -93,6 +99,268 @@ typedef NS_ENUM(NSInteger, MSDynamicsDrawerPaneState) {
     MSDynamicsDrawerPaneStateOpenWide,
 };
 
+/**
+ The policies that `MSDynamicsDrawerViewController` can use to keep the views of drawer view controllers that aren't currently visible attached to the `drawerView`.
+ 
+ A drawer view controller that is kept alive remains a child view controller with its view hidden within the `drawerView`, so that revealing it again only requires unhiding its view rather than a full removal and addition.
+ 
+ @see drawerViewControllerKeepAlivePolicy
+ */
+typedef NS_ENUM(NSInteger, MSDynamicsDrawerKeepAlivePolicy) {
+    /**
+     Drawer view controllers are removed from the `MSDynamicsDrawerViewController` as soon as they are no longer visible.
+     */
+    MSDynamicsDrawerKeepAlivePolicyNone,
+    /**
+     All drawer view controllers are kept alive once they have been revealed or prewarmed.
+     */
+    MSDynamicsDrawerKeepAlivePolicyKeepAll,
+    /**
+     Only the most recently visible drawer view controller is kept alive.
+     */
+    MSDynamicsDrawerKeepAlivePolicyKeepLast,
+    /**
+     All drawer view controllers are kept alive until the `MSDynamicsDrawerViewController` receives a memory warning, at which point those that aren't visible are removed.
+     */
+    MSDynamicsDrawerKeepAlivePolicyEvictOnMemoryWarning,
+};
+
+/**
+ The views that `MSDynamicsDrawerViewController` can replace with static snapshots while the `paneView` is dragged or moving to rest. The values can be masked.
+ 
+ @see setTransitionSnapshotOptions:forDirection:
+ */
+typedef NS_OPTIONS(NSInteger, MSDynamicsDrawerTransitionSnapshotOptions) {
+    /**
+     No views are snapshotted, and both the pane and the drawer remain live.
+     */
+    MSDynamicsDrawerTransitionSnapshotOptionNone   = 0,
+    /**
+     The pane view controller's view is replaced with a snapshot.
+     */
+    MSDynamicsDrawerTransitionSnapshotOptionPane   = (1 << 0),
+    /**
+     The drawer view controller's view is replaced with a snapshot.
+     */
+    MSDynamicsDrawerTransitionSnapshotOptionDrawer = (1 << 1),
+};
+
+/**
+ The kinds of transition that move the `paneView` of a `MSDynamicsDrawerViewController`.
+ 
+ @see MSDynamicsDrawerTransitionMetrics
+ */
+typedef NS_ENUM(NSInteger, MSDynamicsDrawerTransitionKind) {
+    /**
+     The user dragged the `paneView`, including the motion to rest after it was released.
+     */
+    MSDynamicsDrawerTransitionKindGesture,
+    /**
+     The user tapped the `paneView` to close it.
+     */
+    MSDynamicsDrawerTransitionKindTapToClose,
+    /**
+     The `paneView` was bounced open via one of the `bouncePaneOpen` methods.
+     */
+    MSDynamicsDrawerTransitionKindBounce,
+    /**
+     The `paneState` was set with animation via one of the `setPaneState:animated:` methods.
+     */
+    MSDynamicsDrawerTransitionKindProgrammatic,
+};
+
+/**
+ A range of frame rates (in frames / second) that the updates of a `MSDynamicsDrawerViewController` instance's `paneView` are paced at.
+ 
+ Mirrors `CAFrameRateRange`, which is only available on iOS 15+. On earlier versions of iOS, only `preferred` is applied. A range with all fields set to `0.0` lets the system choose the frame rate.
+ 
+ @see setFrameRateRange:forTransitionKind:
+ */
+typedef struct {
+    /**
+     The lowest frame rate that is acceptable.
+     */
+    float minimum;
+    /**
+     The highest frame rate that is useful.
+     */
+    float maximum;
+    /**
+     The frame rate that should ideally be used.
+     */
+    float preferred;
+} MSDynamicsDrawerFrameRateRange;
+
+/**
+ The frame rate range that lets the system choose the frame rate.
+ */
+extern const MSDynamicsDrawerFrameRateRange MSDynamicsDrawerFrameRateRangeDefault;
+
+/**
+ A snapshot of the layout of a `MSDynamicsDrawerViewController` instance's `paneView`.
+ 
+ The layout is computed once each time that the `paneView` frame is updated, and is passed to stylers that implement `dynamicsDrawerViewController:didUpdateLayout:` so that they do not have to query the `MSDynamicsDrawerViewController` instance for its geometry.
+ */
+typedef struct {
+    /**
+     The direction that the `paneView` is opening in. Will not be masked.
+     */
+    MSDynamicsDrawerDirection direction;
+    /**
+     The frame of the `paneView`.
+     */
+    CGRect paneViewFrame;
+    /**
+     The fraction that the `paneView` is closed. `1.0` when closed, `0.0` when opened.
+     */
+    CGFloat paneClosedFraction;
+    /**
+     The reveal width for `direction`, as returned by `revealWidthForDirection:`. `0.0` when `direction` is `MSDynamicsDrawerDirectionNone`.
+     */
+    CGFloat revealWidth;
+    /**
+     The distance (in points) that the drawer is currently opened, as returned by `currentRevealWidth`.
+     */
+    CGFloat currentRevealWidth;
+    /**
+     The origin of the `paneView` when in `MSDynamicsDrawerPaneStateClosed`.
+     */
+    CGPoint closedPaneViewOrigin;
+    /**
+     The origin of the `paneView` when in `MSDynamicsDrawerPaneStateOpen` in `direction`.
+     */
+    CGPoint openPaneViewOrigin;
+    /**
+     The origin of the `paneView` when in `MSDynamicsDrawerPaneStateOpenWide` in `direction`.
+     */
+    CGPoint openWidePaneViewOrigin;
+    /**
+     Whether the `paneView` is at rest, i.e. it is neither being dragged by the user nor being moved by the `paneMotionEngine` or a Core Animation transition.
+     
+     A resting layout is always delivered to stylers once a pane motion has completed, so stylers may defer expensive work (such as relayout) until the `paneView` is at rest.
+     */
+    BOOL paneViewResting;
+} MSDynamicsDrawerLayout;
+
+/**
+ The configuration that the geometry of a `MSDynamicsDrawerViewController` instance's `paneView` is derived from in a single direction.
+ 
+ A geometry is a plain value that is independent of any view, so the functions that derive pane view origins, closed fractions, pane states, and layouts from it can be called from any thread. This enables layouts to be precomputed in the background, or the drawer geometry to be exercised without a window.
+ 
+ @see geometryForDirection:
+ @see MSDynamicsDrawerGeometryMake
+ */
+typedef struct {
+    /**
+     The direction that the `paneView` opens in. Will not be masked. The `paneView` is always closed in `MSDynamicsDrawerDirectionNone`.
+     */
+    MSDynamicsDrawerDirection direction;
+    /**
+     The size of the `paneView`.
+     */
+    CGSize paneViewSize;
+    /**
+     The distance that the `paneView` is opened in `MSDynamicsDrawerPaneStateOpen`, as returned by `revealWidthForDirection:`.
+     */
+    CGFloat revealWidth;
+    /**
+     The distance that the `paneView` is offset past the edge of the screen in `MSDynamicsDrawerPaneStateOpenWide`, as returned by `paneStateOpenWideEdgeOffset`.
+     */
+    CGFloat openWideEdgeOffset;
+} MSDynamicsDrawerGeometry;
+
+/**
+ A description of the motion that brings a `MSDynamicsDrawerViewController` instance's `paneView` to rest in a pane state, as passed to a `MSDynamicsDrawerPaneMotionEngine`.
+ 
+ All angles are in radians, and all magnitudes use the UIKit Dynamics convention of a magnitude of `1.0` representing an acceleration of 1000 points / second².
+ */
+typedef struct {
+    /**
+     The pane state that the `paneView` is being brought to rest in.
+     */
+    MSDynamicsDrawerPaneState paneState;
+    /**
+     The direction that the `paneView` is moving in. Will not be masked.
+     */
+    MSDynamicsDrawerDirection direction;
+    /**
+     The origin of the `paneView` once it has come to rest in `paneState`.
+     */
+    CGPoint targetPaneViewOrigin;
+    /**
+     The boundary that the `paneView` is confined to while moving, in the coordinate space of the reference view.
+     */
+    CGRect boundary;
+    /**
+     The angle of the gravity that pulls the `paneView` towards `targetPaneViewOrigin`.
+     */
+    CGFloat gravityAngle;
+    /**
+     The magnitude of the gravity that pulls the `paneView` towards `targetPaneViewOrigin`.
+     */
+    CGFloat gravityMagnitude;
+    /**
+     The angle of the instantaneous push that is applied to the `paneView` as the motion begins.
+     */
+    CGFloat pushAngle;
+    /**
+     The magnitude of the instantaneous push that is applied to the `paneView` as the motion begins. `0.0` for no push.
+     */
+    CGFloat pushMagnitude;
+    /**
+     The elasticity of the `paneView` when it collides with `boundary`. Valid range is from `0.0` for no bounce upon collision, to `1.0` for completely elastic collisions.
+     */
+    CGFloat elasticity;
+    /**
+     The velocity (in points / second) that the `paneView` has as the motion begins, in addition to the push. Non-zero when the motion continues an interrupted Core Animation transition. An engine that is already running carries over its own velocity instead.
+     */
+    CGPoint initialVelocity;
+} MSDynamicsDrawerPaneMotion;
+
+/**
+ The state that a `MSDynamicsDrawerViewController` instance was in as a gesture trace was recorded by a `MSDynamicsDrawerGestureRecorder`.
+ 
+ @see enumerateSamplesOfTrace:header:usingBlock:
+ */
+typedef struct {
+    /**
+     The size of the drawer view controller's view, which the locations of the samples are in the coordinate space of.
+     */
+    CGSize referenceSize;
+    /**
+     The `paneState` of the drawer view controller as the first sample was recorded.
+     */
+    MSDynamicsDrawerPaneState paneState;
+    /**
+     The `currentDrawerDirection` of the drawer view controller as the first sample was recorded. `MSDynamicsDrawerDirectionNone` when the pane was closed.
+     */
+    MSDynamicsDrawerDirection direction;
+    /**
+     The number of samples in the trace.
+     */
+    NSUInteger sampleCount;
+} MSDynamicsDrawerGestureTraceHeader;
+
+/**
+ A single delivery of the pane pan gesture recognizer of a `MSDynamicsDrawerViewController` instance, as recorded in a gesture trace by a `MSDynamicsDrawerGestureRecorder`.
+ 
+ @see enumerateSamplesOfTrace:header:usingBlock:
+ */
+typedef struct {
+    /**
+     The state of the pan gesture recognizer.
+     */
+    UIGestureRecognizerState state;
+    /**
+     The timestamp (in seconds) of the touch that drove the delivery, relative to the first sample of the trace.
+     */
+    NSTimeInterval timestamp;
+    /**
+     The location of the touch in the coordinate space of the drawer view controller's view.
+     */
+    CGPoint location;
+} MSDynamicsDrawerGestureTraceSample;
+
 @class MSDynamicsDrawerViewController;
 
 /**
@@ -117,15 +385,62 @@ typedef NS_ENUM(NSInteger, MSDynamicsDrawerPaneState) {
  
  If the value for the `animated` parameter is `NO`, then this method is functionally equivalent to using the `paneViewController` setter.
  
+ If the new pane view controller conforms to `MSDynamicsDrawerPaneTransitionPreparing`, it's asked to prepare its content as soon as the transition begins, and the `paneView` is held in `MSDynamicsDrawerPaneStateOpenWide` (or wherever it is when `paneViewSlideOffAnimationEnabled` is disabled) until it has finished preparing or `paneViewControllerPreparationTimeout` has elapsed. Only then is it added and the pane closed.
+ 
+ Invoking this method while a previous animated transition has not yet replaced the pane view controller retargets that transition to the new pane view controller, rather than queuing another animation. The preparation of the previous pane view controller is cancelled, and the completion of the previous transition is not invoked. If the previous transition has already replaced the pane view controller and is closing the pane, it's completed immediately and a new transition begins from the current position of the `paneView`.
+ 
  @param paneViewController The `paneViewController` to be added.
  @param animated Whether adding the pane should be animated.
  @param completion An optional completion block called upon the completion of the `paneViewController` being set.
  
  @see paneViewController
  @see paneViewSlideOffAnimationEnabled
+ @see paneViewControllerPreparationTimeout
  */
 - (void)setPaneViewController:(UIViewController *)paneViewController animated:(BOOL)animated completion:(void (^)(void))completion;
 
+/**
+ Sets the `paneViewController` to the cached pane view controller for a key, building and caching it if it's not already cached.
+ 
+ Pane view controllers that are cached keep their view hierarchies when they are replaced, so that switching back to them doesn't rebuild their views or reload their data. Cached pane view controllers are evicted in least recently shown order once there are more than `paneViewControllerCacheCapacity` of them, and when the `MSDynamicsDrawerViewController` receives a memory warning. The visible pane view controller is never evicted. Evicted pane view controllers that conform to `MSDynamicsDrawerCachedPaneViewController` are informed, so that they can release any heavy resources.
+ 
+ @param key The key that identifies the pane view controller.
+ @param builder The block that creates the pane view controller if it isn't cached for `key`. Must not be `nil`, and must not return `nil`.
+ @param animated Whether the transition to the pane view controller should be animated.
+ @param completion An optional completion block called upon the completion of the `paneViewController` being set.
+ 
+ @see setPaneViewController:animated:completion:
+ @see cachedPaneViewControllerForKey:
+ @see paneViewControllerCacheCapacity
+ */
+- (void)setPaneViewControllerForKey:(id <NSCopying>)key builder:(UIViewController *(^)(void))builder animated:(BOOL)animated completion:(void (^)(void))completion;
+
+/**
+ Returns the cached pane view controller for a key, or `nil` if there isn't one.
+ 
+ @param key The key that identifies the pane view controller.
+ @return The cached pane view controller.
+ 
+ @see setPaneViewControllerForKey:builder:animated:completion:
+ */
+- (UIViewController *)cachedPaneViewControllerForKey:(id <NSCopying>)key;
+
+/**
+ Removes the cached pane view controller for a key from the cache. If it's not visible, it's evicted.
+ 
+ @param key The key that identifies the pane view controller.
+ 
+ @see setPaneViewControllerForKey:builder:animated:completion:
+ */
+- (void)removeCachedPaneViewControllerForKey:(id <NSCopying>)key;
+
+/**
+ The maximum number of pane view controllers that are cached by `setPaneViewControllerForKey:builder:animated:completion:`, including the visible one.
+ 
+ Lowering the capacity evicts the least recently shown pane view controllers immediately. A capacity of `0` only keeps the visible pane view controller cached. Default value of `3`.
+ */
+@property (nonatomic, assign) NSUInteger paneViewControllerCacheCapacity;
+
 /**
  Sets the view controller to be revealed as a drawer in the specified direction underneath the pane view controller.
  
@@ -148,6 +463,24 @@ typedef NS_ENUM(NSInteger, MSDynamicsDrawerPaneState) {
  */
 - (UIViewController *)drawerViewControllerForDirection:(MSDynamicsDrawerDirection)direction;
 
+/**
+ Loads and lays out the views of all drawer view controllers that have been set, so that the first reveal of a drawer doesn't have to.
+ 
+ The work is deferred until the main run loop is next idle in its default mode, so it doesn't occur while the user is tracking a touch. A good time to invoke this method is after the `MSDynamicsDrawerViewController` instance's view has loaded. If `drawerViewControllerKeepAlivePolicy` is any value other than `MSDynamicsDrawerKeepAlivePolicyNone`, the prewarmed drawer view controllers are also attached to the `drawerView` as hidden child view controllers.
+ 
+ @see drawerViewControllerKeepAlivePolicy
+ */
+- (void)prewarmDrawerViewControllers;
+
+/**
+ The policy used to keep the views of drawer view controllers that aren't currently visible attached to the `drawerView`.
+ 
+ Kept alive drawer view controllers receive appearance callbacks as they are hidden and revealed, but remain child view controllers of the `MSDynamicsDrawerViewController` instance. Defaults to `MSDynamicsDrawerKeepAlivePolicyNone`.
+ 
+ @see prewarmDrawerViewControllers
+ */
+@property (nonatomic, assign) MSDynamicsDrawerKeepAlivePolicy drawerViewControllerKeepAlivePolicy;
+
 /**
  If setting a new `paneViewController` should have an animation that slides off the old view controller before animating the new one into its place.
  
@@ -159,11 +492,36 @@ typedef NS_ENUM(NSInteger, MSDynamicsDrawerPaneState) {
  */
 @property (nonatomic, assign) BOOL paneViewSlideOffAnimationEnabled;
 
+/**
+ The maximum duration (in seconds) that an animated transition to a new pane view controller is held while the pane view controller prepares its content.
+ 
+ Only applies to pane view controllers that conform to `MSDynamicsDrawerPaneTransitionPreparing`. Once the timeout has elapsed, the transition continues regardless of whether preparation has finished. Default value of `1.0`.
+ 
+ @see setPaneViewController:animated:completion:
+ */
+@property (nonatomic, assign) NSTimeInterval paneViewControllerPreparationTimeout;
+
 /**
  If the status bar should align with the pane view as the pane view frame is adjusted by both the user gestures and the internal dynamic animator.
+ 
+ The alignment is performed by the `statusBarAligner`, within the same commit as the contributions of compositing stylers.
+ 
+ Default value of `YES`. As the status bar isn't a view within the application on iOS 13 and later, the default `MSDynamicsDrawerStatusBarTransformAligner` has no effect there. To align the status bar on iOS 13 and later, set the `statusBarAligner` to an instance of `MSDynamicsDrawerStatusBarSnapshotAligner`, which snapshots the screen each time that the `paneView` leaves its closed position, hides the real status bar, and freezes the status bar contents while the drawer is open.
+ 
+ @see statusBarAligner
  */
 @property (nonatomic, assign) BOOL shouldAlignStatusBarToPaneView;
 
+/**
+ The strategy that aligns the status bar with the pane view when `shouldAlignStatusBarToPaneView` is enabled.
+ 
+ Defaults to an instance of `MSDynamicsDrawerStatusBarTransformAligner`. Must not be `nil`.
+ 
+ @see shouldAlignStatusBarToPaneView
+ @see MSDynamicsDrawerStatusBarAligner
+ */
+@property (nonatomic, strong) id <MSDynamicsDrawerStatusBarAligner> statusBarAligner;
+
 ///----------------------------------
 /// @name Accessing & Modifying State
 ///----------------------------------
@@ -198,10 +556,12 @@ typedef NS_ENUM(NSInteger, MSDynamicsDrawerPaneState) {
  
  If the value for the `animated` parameter is `NO`, then this method is functionally equivalent to using the `paneState` setter. If there is more than one drawer view controller set, use `setPaneState:inDirection:animated:allowUserInterruption:completion:` instead and specify a direction.
  
+ If the pane is already moving when this method is called with `animated` set to `YES`, its motion is retargeted to the new pane state while keeping its current velocity. Repeated updates to the pane state that it is already moving towards don't restart the motion, and continue the transition in progress rather than beginning a new one, so its `MSDynamicsDrawerTransitionMetrics` and frame rate range are unaffected.
+ 
  @param paneState The state that the pane view controller should be updated to be in.
  @param animated Whether the transition should be animated.
  @param allowUserInterruption If the user should be able to interrupt the pane state transition with gestures.
- @param completion Called upon completion of the update to the pane state. If the user interrupts the transition, the completion will be called when the internal dynamic animator completes.
+ @param completion Called upon completion of the update to the pane state. If the user interrupts the transition, the completion will be called when the internal dynamic animator completes. If the transition is retargeted by another pane state update or a bounce, the completion is called along with the completions of the transitions that replaced it, once the pane comes to rest.
  
  @see paneState
  @see setPaneState:inDirection:
@@ -218,7 +578,7 @@ typedef NS_ENUM(NSInteger, MSDynamicsDrawerPaneState) {
  @param direction The direction that the `paneState` update should be applied in.
  @param animated Whether the transition should be animated.
  @param allowUserInterruption If the user should be able to interrupt the pane state transition with gestures.
- @param completion Called upon completion of the update to the pane state. If the user interrupts the transition, the completion will be called when the internal dynamic animator completes.
+ @param completion Called upon completion of the update to the pane state. If the user interrupts the transition, the completion will be called when the internal dynamic animator completes. If the transition is retargeted by another pane state update or a bounce, the completion is called along with the completions of the transitions that replaced it, once the pane comes to rest.
  
  @see paneState
  @see setPaneState:inDirection:
@@ -343,6 +703,15 @@ typedef NS_ENUM(NSInteger, MSDynamicsDrawerPaneState) {
  */
 @property (nonatomic, assign) CGFloat bounceMagnitude;
 
+/**
+ The engine that moves the `paneView` to rest whenever the pane state is changed with an animation, the user releases the pane, or the pane is bounced.
+ 
+ Defaults to an instance of `MSDynamicsDrawerDynamicsMotionEngine`, which uses UIKit Dynamics. Set to an instance of `MSDynamicsDrawerSpringMotionEngine` to settle the `paneView` with an analytic spring that is evaluated once per display refresh instead. Must not be `nil`.
+ 
+ @see MSDynamicsDrawerPaneMotionEngine
+ */
+@property (nonatomic, strong) id <MSDynamicsDrawerPaneMotionEngine> paneMotionEngine;
+
 ///--------------------------
 ///@name Configuring Gestures
 ///--------------------------
@@ -396,15 +765,78 @@ typedef NS_ENUM(NSInteger, MSDynamicsDrawerPaneState) {
  */
 @property (nonatomic, assign) BOOL paneDragRequiresScreenEdgePan;
 
+/**
+ Sets how close to an edge of the `paneView` (in points) a pan must start to be considered a screen edge pan in the specified direction.
+
+ Used both by `paneDragRequiresScreenEdgePan` and `screenEdgePanCancelsConflictingGestures`. The edges that a pan started at are resolved once per touch sequence, so changes take effect from the next pan. Defaults to `MSPaneViewScreenEdgeThreshold`.
+
+ @param screenEdgePanThreshold The distance from the edge that a screen edge pan must start within. Must not be negative.
+ @param direction The direction of the edge that the threshold should be applied to. Accepts masked direction values.
+
+ @see screenEdgePanThresholdForDirection:
+ */
+- (void)setScreenEdgePanThreshold:(CGFloat)screenEdgePanThreshold forDirection:(MSDynamicsDrawerDirection)direction;
+
+/**
+ Returns how close to an edge of the `paneView` a pan must start to be considered a screen edge pan in the specified direction.
+
+ @param direction The direction of the edge that the threshold should be returned for. Does not accept masked direction values.
+ @return The screen edge pan threshold for the specified direction.
+
+ @see setScreenEdgePanThreshold:forDirection:
+ */
+- (CGFloat)screenEdgePanThresholdForDirection:(MSDynamicsDrawerDirection)direction;
+
 /**
  Whether gestures that start at the edge of the screen should be cancelled under the assumption that the user is dragging the pane view to reveal a drawer underneath.
  
   This behavior only applies to edges that have a corresponding drawer view controller set in the same direction as the edge that the gesture originated in. The primary use of this property is the case of having a `UIScrollView` within the view of the active pane view controller. When the drawers are closed and the user starts a pan-like gesture at the edge of the screen, all other conflicting gesture recognizers will be required to fail, yielding to the internal `UIPanGestureRecognizer` in the `MSDynamicsDrawerViewController` instance. Effectually, this property makes it easier for the user to open the drawers. Defaults to `YES`.
  
  @see paneDragRequiresScreenEdgePan
+ @see setScreenEdgePanThreshold:forDirection:
  */
 @property (nonatomic, assign) BOOL screenEdgePanCancelsConflictingGestures;
 
+/**
+ Whether this drawer arbitrates pane drags with the `MSDynamicsDrawerViewController` that it's nested within.
+
+ A drawer is nested when it's contained (at any depth) within the pane or drawer view controller of another `MSDynamicsDrawerViewController` instance, such as a drawer that is the root view controller of a `UINavigationController` set as another drawer's `paneViewController`. Set this property to `YES` on the inner drawer to enable the nested-drawer mode. In this mode, pane drags are handled as follows:
+
+ - The enclosing drawer's pane pan requires the failure of the inner drawer's pane pan, so the inner drawer is always given the first chance to handle a pan.
+ - While its pane is closed, the inner drawer's pane pan fails immediately if it can't reveal a drawer in the pan's direction, and the enclosing drawer handles it instead. A pan that starts while the inner pane is open is always handled by the inner drawer.
+
+ Arbitration is resolved from the recognizers' view controllers: the enclosing drawer is found by walking the inner drawer's `parentViewController` chain, and the hit test views of the touch aren't traversed. Defaults to `NO`.
+
+ @see enclosingDynamicsDrawerViewController
+ @see screenEdgePanCancelsConflictingGestures
+ */
+@property (nonatomic, assign) BOOL nestedDrawerGestureArbitrationEnabled;
+
+/**
+ The nearest `MSDynamicsDrawerViewController` instance that this drawer is contained within, or `nil` if it isn't nested.
+
+ @see nestedDrawerGestureArbitrationEnabled
+ */
+@property (nonatomic, weak, readonly) MSDynamicsDrawerViewController *enclosingDynamicsDrawerViewController;
+
+/**
+ Whether the `paneView` should be placed ahead of the user's touch while it is dragged, reducing the perceived latency between the touch and the pane.
+
+ When enabled, the pane's position is extrapolated `paneDragPredictionInterval` into the future, using the system's predicted touches where they are available (iOS 9+) and the recent pan velocity otherwise. Coalesced touches are also used to sample the pan velocity at the full touch rate of the device. The predicted position is bounded in the same way as a regular drag. Defaults to `NO`.
+
+ @see paneDragPredictionInterval
+ */
+@property (nonatomic, assign) BOOL paneDragPredictionEnabled;
+
+/**
+ How far into the future (in seconds) the pane's position is extrapolated while it is dragged.
+
+ Only has an effect if `paneDragPredictionEnabled` is set to `YES`. Larger values hide more latency at the cost of overshooting the touch when it changes direction. Defaults to one 60 Hz frame (`1.0 / 60.0`).
+
+ @see paneDragPredictionEnabled
+ */
+@property (nonatomic, assign) NSTimeInterval paneDragPredictionInterval;
+
 /**
  Attempts to register a `UIView` subclass that the pane view should forward dragging through.
  
@@ -421,18 +853,23 @@ typedef NS_ENUM(NSInteger, MSDynamicsDrawerPaneState) {
 /**
  Adds a styler (a class that conforms to the `MSDynamicsDrawerStyler` protocol).
  
+ Stylers are updated in the order that they were added. The update method that a styler is sent is determined when it is added, so a styler should implement its update methods before being added. The styler is sent `stylerWasAddedToDynamicsDrawerViewController:forDirection:` only when it isn't already set in another direction. When called within `beginStylerUpdates` and `commitStylerUpdates`, the styler is added once the updates are committed.
+ 
  @param styler The styler that should be added.
  @param direction The direction that the styler apply to. Accepts masked direction values.
  
  @see addStylersFromArray:forDirection:
  @see removeStyler:forDirection:
  @see stylersForDirection:
+ @see beginStylerUpdates
  */
 - (void)addStyler:(id <MSDynamicsDrawerStyler>)styler forDirection:(MSDynamicsDrawerDirection)direction;
 
 /**
  Removes a styler (a class that conforms to the `MSDynamicsDrawerStyler` protocol).
  
+ The styler is sent `stylerWasRemovedFromDynamicsDrawerViewController:forDirection:` only once it is no longer set in any direction. When called within `beginStylerUpdates` and `commitStylerUpdates`, the styler is removed once the updates are committed.
+ 
  @param styler The styler that should be removed.
  @param direction The direction that they styler should be removed for. Accepts masked direction values.
  
@@ -454,11 +891,29 @@ typedef NS_ENUM(NSInteger, MSDynamicsDrawerPaneState) {
  */
 - (void)addStylersFromArray:(NSArray *)stylers forDirection:(MSDynamicsDrawerDirection)direction;
 
+/**
+ Begins a batch of styler additions and removals, which are applied together by a matching call to `commitStylerUpdates`.
+ 
+ Use a batch when swapping between sets of stylers, such as for each pane view controller. Within a batch, stylers are added and removed immediately for the purposes of `stylersForDirection:`. Dispatch is only resolved once when the batch is committed. Each styler whose membership changed is sent a single `stylerWasAddedToDynamicsDrawerViewController:forDirection:` or `stylerWasRemovedFromDynamicsDrawerViewController:forDirection:`. A styler that was removed and re-added within the same batch isn't sent either, so it keeps its state (such as the layer of a `MSDynamicsDrawerShadowStyler`). Batches can be nested, in which case only the outermost commit applies the updates.
+ 
+ @see commitStylerUpdates
+ */
+- (void)beginStylerUpdates;
+
+/**
+ Commits the batch of styler additions and removals begun by `beginStylerUpdates`.
+ 
+ The layer changes of the added and removed stylers, and the styling of the stylers that are now set, are committed as a single `CATransaction` without implicit animations.
+ 
+ @see beginStylerUpdates
+ */
+- (void)commitStylerUpdates;
+
 /**
  Returns an array of the stylers that are set in a specified direction
  
  @param direction The direction that the stylers should be returned for. Accepts masked direction values.
- @return An array of stylers that are
+ @return An array of stylers that are set in the direction, in the order that they were added.
  
  @see addStyler:forDirection:
  @see addStylersFromArray:forDirection:
@@ -466,6 +921,22 @@ typedef NS_ENUM(NSInteger, MSDynamicsDrawerPaneState) {
  */
 - (NSArray *)stylersForDirection:(MSDynamicsDrawerDirection)direction;
 
+/**
+ Whether programmatic transitions should be performed by Core Animation in the render server, rather than by updating the `paneView` and the stylers on the main thread for every frame.
+ 
+ Only applies to transitions initiated by `setPaneState:animated:allowUserInterruption:completion:` (and its directional equivalent) and `bouncePaneOpenInDirection:allowUserInterruption:completion:`, and only when the trajectory of the transition is known ahead of time, which requires that the `paneMotionEngine` implements `paneViewOriginsForMotion:ofPaneView:sampleInterval:` (such as `MSDynamicsDrawerSpringMotionEngine`) and is not already running. The stylers of the transition's direction must all implement `dynamicsDrawerViewController:didUpdateLayout:composition:`, must not contribute a drawer view controller view frame (as with `MSDynamicsDrawerResizeStyler`), and must contribute the same pane shadow layer throughout the transition, as they are sampled along the trajectory to generate keyframe animations of the `paneView` position and of the `drawerView` transform and opacity. Only the final sample is delivered with a `paneViewResting` layout. If these requirements aren't met, the transition is performed on the main thread as usual.
+ 
+ While such a transition is running, the `frame` of the `paneView` (and the styling of the `drawerView`) remains at the start of the transition, and is only updated to its final state once the transition has finished. Hit-testing, key-value observers of the `paneView` frame, and the status bar alignment of `shouldAlignStatusBarToPaneView` therefore don't track the presented `paneView` during the transition. If the user interrupts the transition, it is stopped at its currently presented state. Defaults to `NO`.
+ */
+@property (nonatomic, assign) BOOL coreAnimationTransitionsEnabled;
+
+/**
+ The minimum change in `paneClosedFraction` that causes the stylers to be updated.
+ 
+ The layout that was last delivered to each styler is tracked, and an update is skipped if its direction, reveal width, `paneView` size, and resting state are unchanged and both its `paneClosedFraction` and its `currentRevealWidth` (relative to the reveal width, as the `paneClosedFraction` is clamped once the `paneView` moves beyond the reveal width) have changed by no more than this value. Compositing stylers (those that implement `dynamicsDrawerViewController:didUpdateLayout:composition:`) are tracked as a group, so that their combined contributions are always applied together. Stylers that modify views directly can further reduce their updates via `updateGranularityForDynamicsDrawerViewController:`. Defaults to `0.0`, which only skips updates that are identical to the last one.
+ */
+@property (nonatomic, assign) CGFloat stylerUpdateThreshold;
+
 ///-------------------------------
 /// @name Configuring Reveal Width
 ///-------------------------------
@@ -499,25 +970,131 @@ typedef NS_ENUM(NSInteger, MSDynamicsDrawerPaneState) {
  */
 - (CGFloat)currentRevealWidth;
 
-///----------------------
-/// @name Container Views
-///----------------------
+///-------------------------------
+/// @name Configuring Pane Updates
+///-------------------------------
 
 /**
- The drawer view contains the currently visible drawer view controller's view.
+ Whether updates to the `paneView` frame should be coalesced and delivered to the stylers at most once per display refresh.
  
- The `drawerView` is always presented underneath the `paneView`. The frame of the `drawerView` never moves, and it is not affected by dynamics.
+ When set to `NO`, the stylers are updated each time that the `paneView` frame is changed, either by the user's gestures or by the internal dynamic animator. Since a single rendered frame can contain more than one of these changes, the stylers can be updated more than once per frame. When set to `YES`, changes to the `paneView` frame instead mark the pane as needing an update, which is then applied once per display refresh from a `CADisplayLink`. Defaults to `NO`.
  */
-@property (nonatomic, readonly) UIView *drawerView;
+@property (nonatomic, assign) BOOL paneUpdateCoalescingEnabled;
 
 /**
- The pane view contains the pane view controller's view.
+ Sets the range of frame rates that the `paneView` is updated at during the specified kind of transition.
  
- The user can slide the `paneView` in any of the directions defined in `possibleDrawerDirection` to reveal the drawer view controller underneath. The frame of the `paneView` is frequently updated by internal dynamics and user gestures.
+ The range is applied when the transition begins to the `CADisplayLink` that steps display link driven motion engines (such as `MSDynamicsDrawerSpringMotionEngine`) and delivers coalesced pane updates, and to the animations of Core Animation transitions. UIKit Dynamics doesn't expose its frame rate, so while `MSDynamicsDrawerDynamicsMotionEngine` moves the `paneView`, the range only paces the updates delivered to the stylers when `paneUpdateCoalescingEnabled` is set to `YES`. The frame rate that was achieved is reported by the `achievedFrameRate` of the transition's `MSDynamicsDrawerTransitionMetrics`.
+ 
+ Defaults to a range of 30–60 frames / second that prefers 60 for `MSDynamicsDrawerTransitionKindBounce`, so that bounces don't hold a ProMotion display at its maximum refresh rate, and to `MSDynamicsDrawerFrameRateRangeDefault` for all other kinds of transition.
+ 
+ @param frameRateRange The range of frame rates that the `paneView` should be updated at.
+ @param kind The kind of transition that the range applies to.
+ 
+ @see frameRateRangeForTransitionKind:
  */
-@property (nonatomic, readonly) UIView *paneView;
+- (void)setFrameRateRange:(MSDynamicsDrawerFrameRateRange)frameRateRange forTransitionKind:(MSDynamicsDrawerTransitionKind)kind;
 
-///////////////////////////////////////
+/**
+ Returns the range of frame rates that the `paneView` is updated at during the specified kind of transition.
+ 
+ @param kind The kind of transition to return the range for.
+ @return The range of frame rates for the specified kind of transition.
+ 
+ @see setFrameRateRange:forTransitionKind:
+ */
+- (MSDynamicsDrawerFrameRateRange)frameRateRangeForTransitionKind:(MSDynamicsDrawerTransitionKind)kind;
+
+///---------------------------------------
+/// @name Configuring Transition Snapshots
+///---------------------------------------
+
+/**
+ Sets which child view controller views should be replaced by static snapshots while the pane is transitioning in the specified direction.
+ 
+ Snapshots are taken when the user begins dragging the pane or when the pane begins moving to rest, and the live views are restored once the pane has come to rest. While a view is snapshotted, its content is not updated and it does not receive touches, so this is best suited to expensive content (such as maps or web views) that would otherwise prevent the pane from moving at the full frame rate. Stylers that modify the drawer view controller's view directly (such as `MSDynamicsDrawerResizeStyler`) have no visible effect on a drawer snapshot. The delegate can refuse individual snapshots via `dynamicsDrawerViewController:shouldSnapshotViewController:forDirection:`. Defaults to `MSDynamicsDrawerTransitionSnapshotOptionNone` for all directions.
+ 
+ @param options The views that should be snapshotted.
+ @param direction The direction that the options apply to. Accepts masked direction values.
+ 
+ @see transitionSnapshotOptionsForDirection:
+ */
+- (void)setTransitionSnapshotOptions:(MSDynamicsDrawerTransitionSnapshotOptions)options forDirection:(MSDynamicsDrawerDirection)direction;
+
+/**
+ Returns which child view controller views are replaced by static snapshots while the pane is transitioning in the specified direction.
+ 
+ @param direction The direction to check against. Does not accept masked direction values.
+ @return The views that are snapshotted for the specified direction.
+ 
+ @see setTransitionSnapshotOptions:forDirection:
+ */
+- (MSDynamicsDrawerTransitionSnapshotOptions)transitionSnapshotOptionsForDirection:(MSDynamicsDrawerDirection)direction;
+
+///-------------------------------------
+/// @name Reporting the Memory Footprint
+///-------------------------------------
+
+/**
+ Reports the objects that the drawer view controller retains, for diagnosing its memory footprint.
+ 
+ The report includes the counts of the drawer view controllers (`drawerViewControllers`), the drawer view controllers that are kept alive while hidden (`keptAliveDrawerViewControllers`), the cached pane view controllers (`cachedPaneViewControllers`), the unique stylers (`stylers`), the active transition snapshot views (`transitionSnapshotViews`), and the display link (`displayLink`). If the `paneMotionEngine` implements `memoryFootprintReport`, its report is included under the `paneMotionEngine` key.
+ 
+ @return A dictionary of `NSNumber` object counts, keyed by the kind of object that is retained.
+ 
+ @see drawerViewControllerKeepAlivePolicy
+ @see paneViewControllerCacheCapacity
+ */
+- (NSDictionary *)memoryFootprintReport;
+
+///-------------------------
+/// @name Recording Gestures
+///-------------------------
+
+/**
+ The recorder that the deliveries of the pane pan gesture recognizer are recorded into while it is recording.
+ 
+ Attach a recorder to capture the drags that a user performs on a device as a compact binary trace, which can be attached to a bug report and replayed through the drawer view controller later. While the recorder isn't recording, the drawer view controller does no work for it. Defaults to `nil`.
+ 
+ @see MSDynamicsDrawerGestureRecorder
+ */
+@property (nonatomic, strong) MSDynamicsDrawerGestureRecorder *gestureRecorder;
+
+///-------------------------
+/// @name Accessing Geometry
+///-------------------------
+
+/**
+ Returns the geometry that the `paneView` is currently laid out with in the specified direction.
+ 
+ Must be called from the main thread, as it reads the size of the `paneView`. The returned geometry can be used from any thread, and remains valid until the size of the `paneView`, the reveal width for `direction`, or `paneStateOpenWideEdgeOffset` changes.
+ 
+ @param direction The direction to return the geometry for. Must not be masked.
+ @return The geometry of the `paneView` in `direction`.
+ 
+ @see MSDynamicsDrawerGeometryLayout
+ */
+- (MSDynamicsDrawerGeometry)geometryForDirection:(MSDynamicsDrawerDirection)direction;
+
+///----------------------
+/// @name Container Views
+///----------------------
+
+/**
+ The drawer view contains the currently visible drawer view controller's view.
+ 
+ The `drawerView` is always presented underneath the `paneView`. The frame of the `drawerView` never moves, and it is not affected by dynamics.
+ */
+@property (nonatomic, readonly) UIView *drawerView;
+
+/**
+ The pane view contains the pane view controller's view.
+ 
+ The user can slide the `paneView` in any of the directions defined in `possibleDrawerDirection` to reveal the drawer view controller underneath. The frame of the `paneView` is frequently updated by internal dynamics and user gestures.
+ */
+@property (nonatomic, readonly) UIView *paneView;
+
+///////////////////////////////////////
 /// @name Accessing the Delegate Object
 ///////////////////////////////////////
 
@@ -549,6 +1126,92 @@ typedef void (^MSDynamicsDrawerActionBlock)(MSDynamicsDrawerDirection maskedValu
  */
 void MSDynamicsDrawerDirectionActionForMaskedValues(MSDynamicsDrawerDirection direction, MSDynamicsDrawerActionBlock action);
 
+/**
+ Creates a frame rate range.
+ 
+ @param minimum The lowest frame rate that is acceptable.
+ @param maximum The highest frame rate that is useful.
+ @param preferred The frame rate that should ideally be used.
+ @return A frame rate range with the specified frame rates.
+ */
+MSDynamicsDrawerFrameRateRange MSDynamicsDrawerFrameRateRangeMake(float minimum, float maximum, float preferred);
+
+/**
+ Creates a geometry. Like the other `MSDynamicsDrawerGeometry` functions, it is safe to call from any thread.
+ 
+ @param direction The direction that the `paneView` opens in. Must not be masked.
+ @param paneViewSize The size of the `paneView`.
+ @param revealWidth The distance that the `paneView` is opened in `MSDynamicsDrawerPaneStateOpen`.
+ @param openWideEdgeOffset The distance that the `paneView` is offset past the edge of the screen in `MSDynamicsDrawerPaneStateOpenWide`.
+ @return A geometry with the specified configuration.
+ */
+MSDynamicsDrawerGeometry MSDynamicsDrawerGeometryMake(MSDynamicsDrawerDirection direction, CGSize paneViewSize, CGFloat revealWidth, CGFloat openWideEdgeOffset);
+
+/**
+ Returns the origin of the `paneView` in a pane state.
+ 
+ @param geometry The geometry of the `paneView`.
+ @param paneState The pane state.
+ @return The origin of the `paneView` in `paneState`. `CGPointZero` when the direction of `geometry` is `MSDynamicsDrawerDirectionNone`.
+ */
+CGPoint MSDynamicsDrawerGeometryPaneViewOrigin(MSDynamicsDrawerGeometry geometry, MSDynamicsDrawerPaneState paneState);
+
+/**
+ Returns the fraction that the `paneView` is closed at an origin, clipped to the range `0.0` (opened) to `1.0` (closed).
+ 
+ @param geometry The geometry of the `paneView`.
+ @param paneViewOrigin The origin of the `paneView`.
+ @return The closed fraction of the `paneView`. `1.0` when the direction of `geometry` is `MSDynamicsDrawerDirectionNone`.
+ */
+CGFloat MSDynamicsDrawerGeometryPaneClosedFraction(MSDynamicsDrawerGeometry geometry, CGPoint paneViewOrigin);
+
+/**
+ Returns the distance (in points) that the drawer is opened with the `paneView` at an origin.
+ 
+ @param geometry The geometry of the `paneView`.
+ @param paneViewOrigin The origin of the `paneView`.
+ @return The distance that the drawer is opened.
+ */
+CGFloat MSDynamicsDrawerGeometryCurrentRevealWidth(MSDynamicsDrawerGeometry geometry, CGPoint paneViewOrigin);
+
+/**
+ Returns whether the `paneView` is positioned in a pane state at an origin, to within a couple of points along each axis.
+ 
+ @param geometry The geometry of the `paneView`.
+ @param paneViewOrigin The origin of the `paneView`.
+ @param paneState Upon return, the pane state that the `paneView` is positioned in, if any. May be `NULL`.
+ @return Whether the `paneView` is positioned in a pane state.
+ */
+BOOL MSDynamicsDrawerGeometryPaneStateAtPaneViewOrigin(MSDynamicsDrawerGeometry geometry, CGPoint paneViewOrigin, MSDynamicsDrawerPaneState *paneState);
+
+/**
+ Returns the pane state whose `paneView` origin is nearest to an origin.
+ 
+ @param geometry The geometry of the `paneView`.
+ @param paneViewOrigin The origin of the `paneView`.
+ @return The nearest pane state.
+ */
+MSDynamicsDrawerPaneState MSDynamicsDrawerGeometryNearestPaneState(MSDynamicsDrawerGeometry geometry, CGPoint paneViewOrigin);
+
+/**
+ Returns the boundary that the `paneView` is confined to while it moves to a pane state, as passed to a `MSDynamicsDrawerPaneMotionEngine` in `MSDynamicsDrawerPaneMotion`.
+ 
+ @param geometry The geometry of the `paneView`.
+ @param paneState The pane state that the `paneView` is moving to.
+ @return The boundary of the `paneView`. `CGRectZero` when the direction of `geometry` is `MSDynamicsDrawerDirectionNone`.
+ */
+CGRect MSDynamicsDrawerGeometryBoundaryForPaneState(MSDynamicsDrawerGeometry geometry, MSDynamicsDrawerPaneState paneState);
+
+/**
+ Returns the layout of the `paneView` at an origin, as delivered to stylers.
+ 
+ @param geometry The geometry of the `paneView`.
+ @param paneViewOrigin The origin of the `paneView`.
+ @param paneViewResting Whether the `paneView` is at rest.
+ @return The layout of the `paneView`.
+ */
+MSDynamicsDrawerLayout MSDynamicsDrawerGeometryLayout(MSDynamicsDrawerGeometry geometry, CGPoint paneViewOrigin, BOOL paneViewResting);
+
 /**
  To respond to the updates to `paneState` for an instance of `MSDynamicsDrawerViewController`, configure a custom class to adopt the `MSDynamicsDrawerViewControllerDelegate` protocol and set it as the `delegate` object.
  */
@@ -586,6 +1249,399 @@ void MSDynamicsDrawerDirectionActionForMaskedValues(MSDynamicsDrawerDirection di
  */
 - (BOOL)dynamicsDrawerViewController:(MSDynamicsDrawerViewController *)drawerViewController shouldBeginPanePan:(UIPanGestureRecognizer *)panGestureRecognizer;
 
+/**
+ Queries the delegate for whether the view of a child view controller should be replaced by a static snapshot for the duration of a transition.
+ 
+ Only invoked for the views that are enabled via `setTransitionSnapshotOptions:forDirection:`. If not implemented, the snapshot is always taken.
+ 
+ @param drawerViewController The drawer view controller that the delegate is registered with.
+ @param viewController The pane or drawer view controller whose view is about to be snapshotted.
+ @param direction The direction that the pane is transitioning in.
+ 
+ @return Whether the view controller's view should be snapshotted.
+ */
+- (BOOL)dynamicsDrawerViewController:(MSDynamicsDrawerViewController *)drawerViewController shouldSnapshotViewController:(UIViewController *)viewController forDirection:(MSDynamicsDrawerDirection)direction;
+
+/**
+ Informs the delegate that a transition of the `paneView` has finished, along with the metrics that were recorded over its duration.
+ 
+ A transition finishes when the `paneView` comes to rest, or when it is interrupted by another transition (such as the user catching the `paneView` while it is bouncing). The metrics are only recorded when the delegate implements this method, as recording them keeps the display link of the drawer view controller running for the duration of each transition. Regardless of whether this method is implemented, each transition is emitted as an `os_signpost` interval on iOS 12 and later when being recorded by Instruments.
+ 
+ @param drawerViewController The drawer view controller that the delegate is registered with.
+ @param metrics The metrics of the transition that finished.
+ */
+- (void)dynamicsDrawerViewController:(MSDynamicsDrawerViewController *)drawerViewController didFinishTransitionWithMetrics:(MSDynamicsDrawerTransitionMetrics *)metrics;
+
+@end
+
+/**
+ `MSDynamicsDrawerPaneTransitionPreparing` is a protocol that a pane view controller can conform to in order to prepare its content (such as by prefetching data or decoding images on a background queue) before it's revealed by `setPaneViewController:animated:completion:`.
+ */
+@protocol MSDynamicsDrawerPaneTransitionPreparing <NSObject>
+
+/**
+ Asks the pane view controller to prepare its content for being revealed.
+ 
+ Invoked when the animated transition to the pane view controller begins, before it is added to the `MSDynamicsDrawerViewController` instance, so that preparation can overlap with the `paneView` sliding off.
+ 
+ @param dynamicsDrawerViewController The `MSDynamicsDrawerViewController` that the pane view controller is transitioning into.
+ @param completion The block to invoke once the content has been prepared. Can be invoked from any queue.
+ 
+ @see paneViewControllerPreparationTimeout
+ */
+- (void)prepareForPaneTransitionInDynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController completion:(void (^)(void))completion;
+
+@optional
+
+/**
+ Informs the pane view controller that the transition to it was cancelled by a transition to another pane view controller, so that any preparation in progress can be stopped.
+ 
+ @param dynamicsDrawerViewController The `MSDynamicsDrawerViewController` that the pane view controller was transitioning into.
+ */
+- (void)cancelPaneTransitionPreparationInDynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController;
+
+@end
+
+/**
+ `MSDynamicsDrawerCachedPaneViewController` is a protocol that a pane view controller that is cached by `setPaneViewControllerForKey:builder:animated:completion:` can conform to in order to be informed when it's evicted.
+ */
+@protocol MSDynamicsDrawerCachedPaneViewController <NSObject>
+
+/**
+ Informs the pane view controller that it has been evicted from the pane view controller cache of a `MSDynamicsDrawerViewController`, and will be rebuilt the next time it's shown.
+ 
+ @param dynamicsDrawerViewController The `MSDynamicsDrawerViewController` that the pane view controller was cached by.
+ */
+- (void)paneViewControllerWasEvictedFromDynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController;
+
+@end
+
+/**
+ `MSDynamicsDrawerPaneMotionEngine` is a protocol that defines the interface for an object that moves the `paneView` of a `MSDynamicsDrawerViewController` to rest. Instances of `MSDynamicsDrawerPaneMotionEngine` are set on `MSDynamicsDrawerViewController` via the `paneMotionEngine` property.
+ 
+ The engine must inform its `delegate` each time it updates the `paneView`, and when the `paneView` comes to rest. Stopping a running motion with `stopMotion` is considered coming to rest.
+ */
+@protocol MSDynamicsDrawerPaneMotionEngine <NSObject>
+
+/**
+ The delegate that is informed of updates to the `paneView` made by the engine. Set by the `MSDynamicsDrawerViewController` instance that the engine belongs to.
+ */
+@property (nonatomic, weak) id <MSDynamicsDrawerPaneMotionEngineDelegate> delegate;
+
+/**
+ Whether the engine is currently moving the `paneView`.
+ */
+@property (nonatomic, readonly, getter = isRunning) BOOL running;
+
+/**
+ Begins moving the `paneView` to rest as described by `motion`. If the engine is already running, the new motion retargets the existing one, and the `paneView` keeps the velocity that it is moving with.
+ 
+ @param motion The motion that should be performed.
+ @param paneView The view that should be moved.
+ @param referenceView The view whose coordinate space `motion` is described in.
+ */
+- (void)beginMotion:(MSDynamicsDrawerPaneMotion)motion ofPaneView:(UIView *)paneView inReferenceView:(UIView *)referenceView;
+
+/**
+ Stops moving the `paneView`, leaving it in its current position.
+ */
+- (void)stopMotion;
+
+@optional
+
+/**
+ Advances the motion to the specified time.
+ 
+ Engines that implement this method are stepped once per display refresh by the `MSDynamicsDrawerViewController` instance while they are running, instead of having to schedule their own updates.
+ 
+ @param timestamp The time of the display refresh, in the timebase of `CACurrentMediaTime()`.
+ */
+- (void)stepMotionToTimestamp:(CFTimeInterval)timestamp;
+
+/**
+ Predicts the trajectory of a motion without performing it.
+ 
+ Engines that implement this method allow `MSDynamicsDrawerViewController` to perform programmatic transitions with Core Animation when `coreAnimationTransitionsEnabled` is set to `YES`. The prediction must exactly match what `beginMotion:ofPaneView:inReferenceView:` would perform from the `paneView` current frame.
+ 
+ @param motion The motion that should be predicted.
+ @param paneView The view that would be moved.
+ @param sampleInterval The time (in seconds) between subsequent samples of the trajectory.
+ @return An array of `NSValue`-wrapped `CGPoint` origins of the `paneView`, sampled every `sampleInterval` from the start of the motion until the `paneView` comes to rest at `motion.targetPaneViewOrigin`.
+ */
+- (NSArray *)paneViewOriginsForMotion:(MSDynamicsDrawerPaneMotion)motion ofPaneView:(UIView *)paneView sampleInterval:(CFTimeInterval)sampleInterval;
+
+/**
+ Reports the objects that the engine retains, for inclusion in `memoryFootprintReport` of the `MSDynamicsDrawerViewController` instance that the engine belongs to.
+ 
+ @return A dictionary of `NSNumber` object counts, keyed by the kind of object that is retained.
+ */
+- (NSDictionary *)memoryFootprintReport;
+
+@end
+
+/**
+ The delegate of a `MSDynamicsDrawerPaneMotionEngine`, adopted by `MSDynamicsDrawerViewController`.
+ */
+@protocol MSDynamicsDrawerPaneMotionEngineDelegate <NSObject>
+
+/**
+ Informs the delegate that the engine has updated the position of the `paneView`.
+ 
+ @param paneMotionEngine The engine that updated the `paneView`.
+ */
+- (void)paneMotionEngineDidUpdatePaneView:(id <MSDynamicsDrawerPaneMotionEngine>)paneMotionEngine;
+
+/**
+ Informs the delegate that the `paneView` has come to rest.
+ 
+ @param paneMotionEngine The engine that was moving the `paneView`.
+ */
+- (void)paneMotionEngineDidComeToRest:(id <MSDynamicsDrawerPaneMotionEngine>)paneMotionEngine;
+
+@end
+
+/**
+ A pane motion engine that uses UIKit Dynamics to move the `paneView` with gravity, collision, elasticity, and push behaviors. This is the default `paneMotionEngine`.
+ */
+@interface MSDynamicsDrawerDynamicsMotionEngine : NSObject <MSDynamicsDrawerPaneMotionEngine>
+
+/**
+ How long (in seconds) the engine waits after the `paneView` comes to rest before releasing its `UIDynamicAnimator` and behaviors.
+ 
+ The animator and behaviors are created when the first motion begins, and recreated by the next motion after they have been released. Set to a negative value to retain them for the lifetime of the engine. Default value of `5.0`.
+ */
+@property (nonatomic, assign) NSTimeInterval idleTeardownInterval;
+
+@end
+
+/**
+ A pane motion engine that moves the `paneView` along a closed-form damped spring, without a UIKit Dynamics physics world.
+ 
+ The spring is evaluated once per display refresh. Rather than passing through the pane state that it is settling in, the `paneView` bounces off of it, so the motion's `elasticity` reduces the damping of the spring to create bounces. The motion's gravity is ignored, while its push determines the initial velocity of the `paneView`. As the trajectory of the spring is known ahead of time, this engine supports `coreAnimationTransitionsEnabled`.
+ */
+@interface MSDynamicsDrawerSpringMotionEngine : NSObject <MSDynamicsDrawerPaneMotionEngine>
+
+/**
+ The period (in seconds) of the spring when undamped. Lower values settle the `paneView` faster.
+ 
+ Default value of `0.5`.
+ */
+@property (nonatomic, assign) CGFloat response;
+
+/**
+ The damping ratio of the spring when the motion has no elasticity.
+ 
+ `1.0` (critically damped) by default. The motion's `elasticity` scales this value down, so that an `elasticity` of `0.5` halves the damping ratio.
+ */
+@property (nonatomic, assign) CGFloat dampingRatio;
+
+@end
+
+/**
+ `MSDynamicsDrawerStatusBarAligner` is a protocol that defines the interface for an object that aligns the status bar with the `paneView` of a `MSDynamicsDrawerViewController`. Instances of `MSDynamicsDrawerStatusBarAligner` are set on `MSDynamicsDrawerViewController` via the `statusBarAligner` property.
+ */
+@protocol MSDynamicsDrawerStatusBarAligner <NSObject>
+
+/**
+ Aligns the status bar with the layout of the `paneView`.
+ 
+ Invoked each time that the stylers are updated while `shouldAlignStatusBarToPaneView` is enabled, within the `CATransaction` that applies the contributions of compositing stylers. As this is invoked for every frame of a transition, any expensive lookups should be performed once and cached.
+ 
+ @param dynamicsDrawerViewController The `MSDynamicsDrawerViewController` whose status bar should be aligned.
+ @param layout The layout of the `MSDynamicsDrawerViewController` instance's pane.
+ */
+- (void)dynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController alignStatusBarToLayout:(MSDynamicsDrawerLayout)layout;
+
+/**
+ Restores the status bar to its unaligned state, such as when `shouldAlignStatusBarToPaneView` is disabled or the aligner is replaced.
+ 
+ @param dynamicsDrawerViewController The `MSDynamicsDrawerViewController` whose status bar was being aligned.
+ */
+- (void)restoreStatusBarForDynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController;
+
+@optional
+
+/**
+ Queried for whether the real status bar should be hidden, such as while it's represented by a snapshot.
+ 
+ When the aligner returns `YES`, the `MSDynamicsDrawerViewController` hides the status bar rather than deferring to its `paneViewController`. The aligner should invoke `setNeedsStatusBarAppearanceUpdate` on the `MSDynamicsDrawerViewController` when the returned value changes.
+ 
+ @param dynamicsDrawerViewController The `MSDynamicsDrawerViewController` whose status bar is being aligned.
+ 
+ @return Whether the status bar should be hidden.
+ */
+- (BOOL)statusBarHiddenForDynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController;
+
+@end
+
+/**
+ A status bar aligner that translates the application's status bar view along with the `paneView`.
+ 
+ The status bar view is looked up once and cached. As the status bar isn't a view within the application on iOS 13 and later, this aligner has no effect there.
+ */
+@interface MSDynamicsDrawerStatusBarTransformAligner : NSObject <MSDynamicsDrawerStatusBarAligner>
+
+@end
+
+/**
+ A status bar aligner that represents the status bar with a snapshot within the `paneView` while the `paneView` is away from its closed position.
+ 
+ When the `paneView` first moves, the status bar is snapshotted from the screen and added to the `paneView`, and the real status bar is hidden. As the snapshot is a subview of the `paneView`, it moves with the `paneView` without any work per frame. Once the `paneView` returns to its closed position, the snapshot is removed and the real status bar is shown again. The contents of the status bar do not update while they are represented by the snapshot.
+ 
+ Taking the snapshot requires a full screen `snapshotViewAfterScreenUpdates:` as the `paneView` leaves its closed position, and hiding the real status bar may change the top safe area of devices without a sensor housing, causing a layout pass. For this reason, it isn't the default `statusBarAligner`, and must be opted into.
+ */
+@interface MSDynamicsDrawerStatusBarSnapshotAligner : NSObject <MSDynamicsDrawerStatusBarAligner>
+
+@end
+
+/**
+ The timing and per-frame data recorded over a single transition of the `paneView` of a `MSDynamicsDrawerViewController`.
+ 
+ All timestamps are in the timebase of `CACurrentMediaTime()`.
+ 
+ @see dynamicsDrawerViewController:didFinishTransitionWithMetrics:
+ */
+@interface MSDynamicsDrawerTransitionMetrics : NSObject
+
+/**
+ What caused the transition.
+ */
+@property (nonatomic, assign, readonly) MSDynamicsDrawerTransitionKind kind;
+
+/**
+ The direction that the `paneView` was transitioning in when the transition began.
+ */
+@property (nonatomic, assign, readonly) MSDynamicsDrawerDirection direction;
+
+/**
+ The `paneState` of the drawer view controller when the transition finished.
+ */
+@property (nonatomic, assign, readonly) MSDynamicsDrawerPaneState paneState;
+
+/**
+ Whether the transition was interrupted by another transition before the `paneView` came to rest.
+ */
+@property (nonatomic, assign, readonly, getter = isInterrupted) BOOL interrupted;
+
+/**
+ The time that the transition began.
+ */
+@property (nonatomic, assign, readonly) CFTimeInterval startTimestamp;
+
+/**
+ The time that the transition finished.
+ */
+@property (nonatomic, assign, readonly) CFTimeInterval endTimestamp;
+
+/**
+ The duration of the transition (in seconds).
+ */
+@property (nonatomic, assign, readonly) CFTimeInterval duration;
+
+/**
+ The number of display refreshes that the main thread serviced during the transition.
+ */
+@property (nonatomic, assign, readonly) NSUInteger framesRendered;
+
+/**
+ The number of display refreshes that were missed between the serviced refreshes during the transition.
+ */
+@property (nonatomic, assign, readonly) NSUInteger framesDropped;
+
+/**
+ The total time (in seconds) that serviced refreshes were late during the transition, as the sum of the refresh intervals that were dropped between them.
+ */
+@property (nonatomic, assign, readonly) CFTimeInterval hitchDuration;
+
+/**
+ The time (in seconds) of the longest single hitch during the transition, i.e. the largest run of refresh intervals that were dropped between two serviced refreshes.
+ */
+@property (nonatomic, assign, readonly) CFTimeInterval longestHitchDuration;
+
+/**
+ The hitch time ratio of the transition, in milliseconds of hitches per second between its first and last serviced refreshes, or `0.0` if fewer than two refreshes were serviced. This is the measure that Xcode reports for animation hitches, where a ratio of under 5 ms / s is imperceptible and over 10 ms / s is noticeable to the user.
+ */
+@property (nonatomic, assign, readonly) double hitchTimeRatio;
+
+/**
+ The refresh interval (in seconds) that dropped frames are measured against. This is the interval that the display link was paced at, which can be longer than the refresh interval of the display when a lower frame rate range is in effect.
+ */
+@property (nonatomic, assign, readonly) CFTimeInterval refreshInterval;
+
+/**
+ The average rate (in frames / second) that the main thread serviced display refreshes at during the transition, or `0.0` if fewer than two refreshes were serviced.
+ 
+ @see setFrameRateRange:forTransitionKind:
+ */
+@property (nonatomic, assign, readonly) double achievedFrameRate;
+
+/**
+ The total time (in seconds) spent updating stylers during the transition, including applying the contributions of compositing stylers.
+ */
+@property (nonatomic, assign, readonly) CFTimeInterval stylerUpdateDuration;
+
+/**
+ The time (in seconds) spent in the updates of each styler class during the transition. The keys are the styler class names as `NSString` instances, and the values are `NSNumber` instances.
+ */
+@property (nonatomic, copy, readonly) NSDictionary *stylerClassUpdateDurations;
+
+/**
+ The time (in seconds) spent adding dynamics behaviors to move the `paneView` to rest during the transition.
+ */
+@property (nonatomic, assign, readonly) CFTimeInterval dynamicsBehaviorsDuration;
+
+@end
+
+/**
+ Records the deliveries of the pane pan gesture recognizer of a `MSDynamicsDrawerViewController` as a compact binary gesture trace, and reads gesture traces back.
+ 
+ Set a recorder as the `gestureRecorder` of a drawer view controller, then call `beginRecording` and `endRecording` around the drags that should be captured:
+ 
+     dynamicsDrawerViewController.gestureRecorder = [MSDynamicsDrawerGestureRecorder new];
+     [dynamicsDrawerViewController.gestureRecorder beginRecording];
+     // ...
+     NSData *trace = [dynamicsDrawerViewController.gestureRecorder endRecording];
+ 
+ A trace is a 24 byte header followed by a 16 byte record for each sample, with all fields in little endian byte order:
+ 
+ - Header: the magic `"MSGT"` (4 bytes), the format version (`uint16_t`, currently `1`), the size of each sample record (`uint16_t`), the width and height of the drawer view controller's view (`float` each), the `paneState` and `currentDrawerDirection` as the first sample was recorded (`uint8_t` each), 2 reserved bytes, and the number of samples (`uint32_t`).
+ - Sample: the timestamp relative to the first sample in microseconds (`uint32_t`), the `UIGestureRecognizerState` (`uint8_t`), 3 reserved bytes, and the location of the touch in the coordinate space of the drawer view controller's view (`float` each for x and y).
+ 
+ Readers skip samples by the sample record size in the header, so fields can be appended to each sample without changing the format version.
+ */
+@interface MSDynamicsDrawerGestureRecorder : NSObject
+
+/**
+ Whether the recorder is recording samples.
+ */
+@property (nonatomic, assign, readonly, getter = isRecording) BOOL recording;
+
+/**
+ Begins recording samples, discarding those of any previous recording.
+ 
+ @see endRecording
+ */
+- (void)beginRecording;
+
+/**
+ Ends recording samples, and returns the trace of the samples that were recorded.
+ 
+ @return The trace of the samples that were recorded since `beginRecording` was called, or `nil` if the recorder wasn't recording.
+ 
+ @see beginRecording
+ */
+- (NSData *)endRecording;
+
+/**
+ Reads a gesture trace, enumerating its samples in the order that they were recorded.
+ 
+ @param trace The gesture trace to read, as returned by `endRecording`.
+ @param header On return, the header of the trace. Can be `NULL`.
+ @param block The block to call with each sample. Setting `stop` to `YES` ends the enumeration. Can be `nil` to only validate the trace.
+ @return `YES` if the trace was read, `NO` if it isn't a gesture trace, it is an unsupported version of the format, or it is truncated. No samples are enumerated when `NO` is returned.
+ */
++ (BOOL)enumerateSamplesOfTrace:(NSData *)trace header:(MSDynamicsDrawerGestureTraceHeader *)header usingBlock:(void (^)(MSDynamicsDrawerGestureTraceSample sample, BOOL *stop))block;
+
 @end
 
 #import "MSDynamicsDrawerStyler.h"
@@ -27,6 +27,8 @@
 //
 
 #import <QuartzCore/QuartzCore.h>
+#import <UIKit/UIGestureRecognizerSubclass.h>
+#import <os/signpost.h>
 #import "MSDynamicsDrawerViewController.h"
 
 //#define DEBUG_LAYOUT
@@ -35,22 +37,19 @@ const CGFloat MSDynamicsDrawerDefaultOpenStateRevealWidthHorizontal = 267.0;
 const CGFloat MSDynamicsDrawerDefaultOpenStateRevealWidthVertical = 300.0;
 const CGFloat MSPaneViewVelocityThreshold = 5.0;
 const CGFloat MSPaneViewVelocityMultiplier = 5.0;
+const CFTimeInterval MSPaneViewVelocityReferenceInterval = (1.0 / 60.0); // The velocity threshold and multiplier are tuned to the points moved per 60 Hz frame
+const CFTimeInterval MSPanTrackerVelocitySampleWindow = 0.1;
+const CFTimeInterval MSPanTrackerReleasePredictionInterval = 0.05;
+const NSTimeInterval MSPaneDragPredictionDefaultInterval = (1.0 / 60.0);
 const CGFloat MSPaneViewScreenEdgeThreshold = 24.0; // After testing Apple's `UIScreenEdgePanGestureRecognizer` this seems to be the closest value to create an equivalent effect.
+const CGFloat MSSpringMotionRestDisplacement = 0.5;
+const CGFloat MSSpringMotionRestVelocity = 5.0;
+const CGFloat MSSpringMotionMinimumDampingRatio = 0.05;
+const CFTimeInterval MSSpringMotionMaximumPredictedDuration = 10.0;
+const CFTimeInterval MSCoreAnimationTransitionSampleInterval = (1.0 / 60.0);
 
 NSString * const MSDynamicsDrawerBoundaryIdentifier = @"MSDynamicsDrawerBoundaryIdentifier";
 
-typedef void (^ViewActionBlock)(UIView *view);
-@interface UIView (ViewHierarchyAction)
-- (void)superviewHierarchyAction:(ViewActionBlock)viewAction;
-@end
-@implementation UIView (ViewHierarchyAction)
-- (void)superviewHierarchyAction:(ViewActionBlock)viewAction
-{
-    viewAction(self);
-    [self.superview superviewHierarchyAction:viewAction];
-}
-@end
-
 BOOL __attribute__((const)) MSDynamicsDrawerDirectionIsNonMasked(MSDynamicsDrawerDirection drawerDirection)
 {
     switch (drawerDirection) {
@@ -103,35 +102,808 @@ void MSDynamicsDrawerDirectionActionForMaskedValues(NSInteger direction, MSDynam
     }
 }
 
-@interface MSDynamicsDrawerViewController () <UIGestureRecognizerDelegate, UIDynamicAnimatorDelegate>
+const MSDynamicsDrawerFrameRateRange MSDynamicsDrawerFrameRateRangeDefault = {0.0, 0.0, 0.0};
+
+MSDynamicsDrawerFrameRateRange MSDynamicsDrawerFrameRateRangeMake(float minimum, float maximum, float preferred)
+{
+    return (MSDynamicsDrawerFrameRateRange){minimum, maximum, preferred};
+}
+
+// The number of cardinal directions, and thus entries in the direction configuration table
+enum { MSDynamicsDrawerCardinalDirectionCount = 4 };
+// The number of values in `MSDynamicsDrawerPaneState`
+enum { MSDynamicsDrawerPaneStateCount = 3 };
+// The number of values in `MSDynamicsDrawerTransitionKind`
+enum { MSDynamicsDrawerTransitionKindCount = 4 };
+
+// Maps a cardinal direction onto its entry in the direction configuration table (Top: 0, Left: 1, Bottom: 2, Right: 3)
+static inline NSUInteger MSDynamicsDrawerCardinalDirectionIndex(MSDynamicsDrawerDirection direction)
+{
+    NSCAssert(MSDynamicsDrawerDirectionIsCardinal(direction), @"Only cardinal directions have a configuration table index");
+    return (NSUInteger)__builtin_ctzl((unsigned long)direction);
+}
+
+static inline MSDynamicsDrawerDirection MSDynamicsDrawerCardinalDirectionForIndex(NSUInteger index)
+{
+    return (MSDynamicsDrawerDirection)(1 << index);
+}
+
+static inline CGFloat MSDynamicsDrawerDefaultRevealWidthForDirection(MSDynamicsDrawerDirection direction)
+{
+    if (direction & MSDynamicsDrawerDirectionHorizontal) {
+        return MSDynamicsDrawerDefaultOpenStateRevealWidthHorizontal;
+    } else if (direction & MSDynamicsDrawerDirectionVertical) {
+        return MSDynamicsDrawerDefaultOpenStateRevealWidthVertical;
+    }
+    return 0.0;
+}
+
+// The axis and sign of a cardinal direction. The direction-dependent pane geometry is derived from these arithmetically, so that the hot geometry paths don't branch on the direction. One kernel is selected per direction change, rather than switching on the direction in every call.
+typedef struct {
+    CGPoint axis; // The unit vector of the axis that the pane moves along
+    CGFloat sign; // The sign of the pane's movement along the axis as it opens
+} MSDynamicsDrawerDirectionKernel;
+
+// Indexed by cardinal direction index
+static const MSDynamicsDrawerDirectionKernel MSDynamicsDrawerDirectionKernels[MSDynamicsDrawerCardinalDirectionCount] = {
+    { {0.0, 1.0}, 1.0 },  // Top
+    { {1.0, 0.0}, 1.0 },  // Left
+    { {0.0, 1.0}, -1.0 }, // Bottom
+    { {1.0, 0.0}, -1.0 }, // Right
+};
+
+// Returns `NULL` for directions that the pane can't move in, such as `MSDynamicsDrawerDirectionNone`
+static inline const MSDynamicsDrawerDirectionKernel *MSDynamicsDrawerDirectionKernelForDirection(MSDynamicsDrawerDirection direction)
+{
+    return (MSDynamicsDrawerDirectionIsCardinal(direction) ? &MSDynamicsDrawerDirectionKernels[MSDynamicsDrawerCardinalDirectionIndex(direction)] : NULL);
+}
+
+static inline CGFloat MSDynamicsDrawerDirectionKernelAxisComponent(const MSDynamicsDrawerDirectionKernel *kernel, CGPoint point)
+{
+    return ((point.x * kernel->axis.x) + (point.y * kernel->axis.y));
+}
+
+static inline CGFloat MSDynamicsDrawerDirectionKernelAxisExtent(const MSDynamicsDrawerDirectionKernel *kernel, CGSize size)
+{
+    return ((size.width * kernel->axis.x) + (size.height * kernel->axis.y));
+}
+
+static inline CGPoint MSDynamicsDrawerDirectionKernelPointAlongAxis(const MSDynamicsDrawerDirectionKernel *kernel, CGFloat distance)
+{
+    return (CGPoint){(kernel->axis.x * distance), (kernel->axis.y * distance)};
+}
+
+static inline CGPoint MSDynamicsDrawerDirectionKernelPaneViewOrigin(const MSDynamicsDrawerDirectionKernel *kernel, MSDynamicsDrawerPaneState paneState, CGSize paneViewSize, CGFloat revealWidth, CGFloat openWideEdgeOffset)
+{
+    // Indexed by pane state, the distance that the pane is moved along its axis in each state
+    CGFloat distances[MSDynamicsDrawerPaneStateCount] = {
+        0.0,
+        revealWidth,
+        (MSDynamicsDrawerDirectionKernelAxisExtent(kernel, paneViewSize) + openWideEdgeOffset)
+    };
+    return MSDynamicsDrawerDirectionKernelPointAlongAxis(kernel, (kernel->sign * distances[paneState]));
+}
+
+static inline CGFloat MSDynamicsDrawerDirectionKernelPaneClosedFraction(const MSDynamicsDrawerDirectionKernel *kernel, CGPoint paneViewOrigin, CGFloat revealWidth)
+{
+    CGFloat fraction = (1.0 - ((kernel->sign * MSDynamicsDrawerDirectionKernelAxisComponent(kernel, paneViewOrigin)) / revealWidth));
+    // Clip to 0.0 < fraction < 1.0
+    return MIN(MAX(fraction, 0.0), 1.0);
+}
+
+// The geometry functions only read their arguments and the constant kernel table, so they can be called from any thread
+
+// The distance (in points) along each axis within which the pane view is considered to be positioned in a pane state
+static const CGFloat MSDynamicsDrawerGeometryPaneStateEpsilon = 2.0;
+
+MSDynamicsDrawerGeometry MSDynamicsDrawerGeometryMake(MSDynamicsDrawerDirection direction, CGSize paneViewSize, CGFloat revealWidth, CGFloat openWideEdgeOffset)
+{
+    return (MSDynamicsDrawerGeometry){direction, paneViewSize, revealWidth, openWideEdgeOffset};
+}
+
+CGPoint MSDynamicsDrawerGeometryPaneViewOrigin(MSDynamicsDrawerGeometry geometry, MSDynamicsDrawerPaneState paneState)
+{
+    const MSDynamicsDrawerDirectionKernel *kernel = MSDynamicsDrawerDirectionKernelForDirection(geometry.direction);
+    return (kernel ? MSDynamicsDrawerDirectionKernelPaneViewOrigin(kernel, paneState, geometry.paneViewSize, geometry.revealWidth, geometry.openWideEdgeOffset) : CGPointZero);
+}
+
+CGFloat MSDynamicsDrawerGeometryPaneClosedFraction(MSDynamicsDrawerGeometry geometry, CGPoint paneViewOrigin)
+{
+    const MSDynamicsDrawerDirectionKernel *kernel = MSDynamicsDrawerDirectionKernelForDirection(geometry.direction);
+    // If we have no direction, we want 1.0 since the pane is closed when it has no direction
+    return (kernel ? MSDynamicsDrawerDirectionKernelPaneClosedFraction(kernel, paneViewOrigin, geometry.revealWidth) : 1.0);
+}
+
+CGFloat MSDynamicsDrawerGeometryCurrentRevealWidth(MSDynamicsDrawerGeometry geometry, CGPoint paneViewOrigin)
+{
+    const MSDynamicsDrawerDirectionKernel *kernel = MSDynamicsDrawerDirectionKernelForDirection(geometry.direction);
+    return (kernel ? fabs(MSDynamicsDrawerDirectionKernelAxisComponent(kernel, paneViewOrigin)) : 0.0);
+}
+
+BOOL MSDynamicsDrawerGeometryPaneStateAtPaneViewOrigin(MSDynamicsDrawerGeometry geometry, CGPoint paneViewOrigin, MSDynamicsDrawerPaneState *paneState)
+{
+    CGPoint roundedPaneViewOrigin = (CGPoint){round(paneViewOrigin.x), round(paneViewOrigin.y)};
+    for (MSDynamicsDrawerPaneState currentPaneState = MSDynamicsDrawerPaneStateClosed; currentPaneState <= MSDynamicsDrawerPaneStateOpenWide; currentPaneState++) {
+        CGPoint paneStatePaneViewOrigin = MSDynamicsDrawerGeometryPaneViewOrigin(geometry, currentPaneState);
+        if ((fabs(paneStatePaneViewOrigin.x - roundedPaneViewOrigin.x) < MSDynamicsDrawerGeometryPaneStateEpsilon) && (fabs(paneStatePaneViewOrigin.y - roundedPaneViewOrigin.y) < MSDynamicsDrawerGeometryPaneStateEpsilon)) {
+            if (paneState) {
+                *paneState = currentPaneState;
+            }
+            return YES;
+        }
+    }
+    return NO;
+}
+
+MSDynamicsDrawerPaneState MSDynamicsDrawerGeometryNearestPaneState(MSDynamicsDrawerGeometry geometry, CGPoint paneViewOrigin)
+{
+    CGPoint roundedPaneViewOrigin = (CGPoint){round(paneViewOrigin.x), round(paneViewOrigin.y)};
+    // Squared distances order the pane states identically to distances, without a square root per pane state
+    CGFloat minSquaredDistance = CGFLOAT_MAX;
+    MSDynamicsDrawerPaneState minPaneState = MSDynamicsDrawerPaneStateClosed;
+    for (MSDynamicsDrawerPaneState currentPaneState = MSDynamicsDrawerPaneStateClosed; currentPaneState <= MSDynamicsDrawerPaneStateOpenWide; currentPaneState++) {
+        CGPoint paneStatePaneViewOrigin = MSDynamicsDrawerGeometryPaneViewOrigin(geometry, currentPaneState);
+        CGFloat deltaX = (paneStatePaneViewOrigin.x - roundedPaneViewOrigin.x);
+        CGFloat deltaY = (paneStatePaneViewOrigin.y - roundedPaneViewOrigin.y);
+        CGFloat squaredDistance = ((deltaX * deltaX) + (deltaY * deltaY));
+        if (squaredDistance < minSquaredDistance) {
+            minSquaredDistance = squaredDistance;
+            minPaneState = currentPaneState;
+        }
+    }
+    return minPaneState;
+}
+
+CGRect MSDynamicsDrawerGeometryBoundaryForPaneState(MSDynamicsDrawerGeometry geometry, MSDynamicsDrawerPaneState paneState)
+{
+    const MSDynamicsDrawerDirectionKernel *kernel = MSDynamicsDrawerDirectionKernelForDirection(geometry.direction);
+    if (!kernel) {
+        return CGRectZero;
+    }
+    CGSize paneViewSize = geometry.paneViewSize;
+    CGFloat extent = MSDynamicsDrawerDirectionKernelAxisExtent(kernel, paneViewSize);
+    CGFloat crossExtent = ((paneViewSize.width + paneViewSize.height) - extent);
+    // Along the axis, the boundary extends from the closed pane to the pane in `paneState`, with a point of slack on either side
+    CGFloat length = ((paneState == MSDynamicsDrawerPaneStateOpen) ? ((extent + geometry.revealWidth) + 2.0) : ((extent * 2.0) + geometry.openWideEdgeOffset + 2.0));
+    CGFloat origin = ((kernel->sign > 0.0) ? -1.0 : ((extent + 1.0) - length));
+    // Compose the boundary from its components along and across the axis
+    CGPoint crossAxis = (CGPoint){kernel->axis.y, kernel->axis.x};
+    CGRect boundary;
+    boundary.origin = (CGPoint){((kernel->axis.x * origin) - crossAxis.x), ((kernel->axis.y * origin) - crossAxis.y)};
+    boundary.size = (CGSize){((kernel->axis.x * length) + (crossAxis.x * (crossExtent + 1.0))), ((kernel->axis.y * length) + (crossAxis.y * (crossExtent + 1.0)))};
+    return boundary;
+}
+
+MSDynamicsDrawerLayout MSDynamicsDrawerGeometryLayout(MSDynamicsDrawerGeometry geometry, CGPoint paneViewOrigin, BOOL paneViewResting)
+{
+    MSDynamicsDrawerLayout layout;
+    layout.direction = geometry.direction;
+    layout.paneViewFrame = (CGRect){paneViewOrigin, geometry.paneViewSize};
+    layout.revealWidth = geometry.revealWidth;
+    layout.currentRevealWidth = MSDynamicsDrawerGeometryCurrentRevealWidth(geometry, paneViewOrigin);
+    layout.paneClosedFraction = MSDynamicsDrawerGeometryPaneClosedFraction(geometry, paneViewOrigin);
+    layout.closedPaneViewOrigin = MSDynamicsDrawerGeometryPaneViewOrigin(geometry, MSDynamicsDrawerPaneStateClosed);
+    layout.openPaneViewOrigin = MSDynamicsDrawerGeometryPaneViewOrigin(geometry, MSDynamicsDrawerPaneStateOpen);
+    layout.openWidePaneViewOrigin = MSDynamicsDrawerGeometryPaneViewOrigin(geometry, MSDynamicsDrawerPaneStateOpenWide);
+    layout.paneViewResting = paneViewResting;
+    return layout;
+}
+
+// The gravity angles towards each pane state, indexed by cardinal direction index and then by whether the pane state is open
+static const CGFloat MSDynamicsDrawerGravityAngles[MSDynamicsDrawerCardinalDirectionCount][2] = {
+    { (3.0 * M_PI_2), M_PI_2 },  // Top
+    { M_PI, 0.0 },               // Left
+    { M_PI_2, (3.0 * M_PI_2) },  // Bottom
+    { 0.0, M_PI },               // Right
+};
+
+// The number of samples retained by the pan tracker's ring buffer
+enum { MSPanTrackerSampleCount = 16 };
+
+typedef struct {
+    CGPoint location;
+    CFTimeInterval timestamp;
+} MSPanTrackerSample;
+
+// Per-gesture pan state, including a fixed-size ring buffer of timestamped touch locations used to derive the pan velocity
+typedef struct {
+    CGPoint startLocation;
+    MSDynamicsDrawerDirection direction;
+    MSPanTrackerSample samples[MSPanTrackerSampleCount];
+    NSUInteger sampleCount;
+    NSUInteger nextSampleIndex;
+    BOOL movedPane; // Whether the pan has moved the pane, which begins its transition
+} MSPanTracker;
+
+static void MSPanTrackerBegin(MSPanTracker *tracker, CGPoint startLocation, MSDynamicsDrawerDirection direction)
+{
+    tracker->startLocation = startLocation;
+    tracker->direction = direction;
+    tracker->sampleCount = 0;
+    tracker->nextSampleIndex = 0;
+    tracker->movedPane = NO;
+}
+
+static void MSPanTrackerAddSample(MSPanTracker *tracker, CGPoint location, CFTimeInterval timestamp)
+{
+    tracker->samples[tracker->nextSampleIndex] = (MSPanTrackerSample){location, timestamp};
+    tracker->nextSampleIndex = ((tracker->nextSampleIndex + 1) % MSPanTrackerSampleCount);
+    tracker->sampleCount = MIN((tracker->sampleCount + 1), (NSUInteger)MSPanTrackerSampleCount);
+}
+
+// Returns the sample that is `age` samples older than the most recent one
+static inline MSPanTrackerSample MSPanTrackerSampleAtAge(const MSPanTracker *tracker, NSUInteger age)
+{
+    return tracker->samples[((tracker->nextSampleIndex + MSPanTrackerSampleCount) - 1 - age) % MSPanTrackerSampleCount];
+}
+
+// The screen edge arbitration of a pane pan. As the start location of a pan is fixed, it is resolved once per touch sequence and reused by every arbitration query during it.
+typedef struct {
+    BOOL started;
+    BOOL resolved;
+    CGPoint startLocation;
+    UIRectEdge edges; // The edges of the pane view that the pan started within the threshold of
+    MSDynamicsDrawerDirection revealableDirection; // The started edges with a drawer that can be revealed by dragging
+} MSPanEdgeArbitration;
+
+// The least-squares fit velocity (in points / second) of the samples that were taken within `MSPanTrackerVelocitySampleWindow` of `timestamp`
+static CGPoint MSPanTrackerVelocity(const MSPanTracker *tracker, CFTimeInterval timestamp)
+{
+    CGFloat n = 0.0, sumT = 0.0, sumTT = 0.0, sumX = 0.0, sumY = 0.0, sumTX = 0.0, sumTY = 0.0;
+    for (NSUInteger age = 0; age < tracker->sampleCount; age++) {
+        MSPanTrackerSample sample = MSPanTrackerSampleAtAge(tracker, age);
+        CGFloat t = (sample.timestamp - timestamp);
+        if (t < -MSPanTrackerVelocitySampleWindow) {
+            break;
+        }
+        n += 1.0;
+        sumT += t;
+        sumTT += (t * t);
+        sumX += sample.location.x;
+        sumY += sample.location.y;
+        sumTX += (t * sample.location.x);
+        sumTY += (t * sample.location.y);
+    }
+    CGFloat denominator = ((n * sumTT) - (sumT * sumT));
+    if ((n < 2.0) || (denominator <= 0.0)) {
+        return CGPointZero;
+    }
+    return (CGPoint){(((n * sumTX) - (sumT * sumX)) / denominator), (((n * sumTY) - (sumT * sumY)) / denominator)};
+}
+
+// Extrapolates the most recent sample location `interval` seconds into the future
+static CGPoint MSPanTrackerPredictedLocation(const MSPanTracker *tracker, CFTimeInterval interval)
+{
+    if (tracker->sampleCount == 0) {
+        return tracker->startLocation;
+    }
+    MSPanTrackerSample latestSample = MSPanTrackerSampleAtAge(tracker, 0);
+    CGPoint velocity = MSPanTrackerVelocity(tracker, latestSample.timestamp);
+    return (CGPoint){(latestSample.location.x + (velocity.x * interval)), (latestSample.location.y + (velocity.y * interval))};
+}
+
+// The parameters of a damped spring along the axis of a motion, with displacements relative to the target of the motion
+typedef struct {
+    CGFloat initialDisplacement;
+    CGFloat initialVelocity;
+    CGFloat angularFrequency;
+    CGFloat dampingRatio;
+    CGFloat displacementSide;
+} MSSpringMotionParameters;
+
+static CGFloat MSSpringMotionDisplacement(MSSpringMotionParameters parameters, CFTimeInterval time)
+{
+    CGFloat angularFrequency = parameters.angularFrequency;
+    CGFloat dampingRatio = parameters.dampingRatio;
+    CGFloat x0 = parameters.initialDisplacement;
+    CGFloat v0 = parameters.initialVelocity;
+    CGFloat displacement;
+    if (dampingRatio < 1.0) {
+        // Underdamped
+        CGFloat dampedFrequency = (angularFrequency * sqrt(1.0 - (dampingRatio * dampingRatio)));
+        CGFloat decay = exp(-dampingRatio * angularFrequency * time);
+        displacement = (decay * ((x0 * cos(dampedFrequency * time)) + (((v0 + (dampingRatio * angularFrequency * x0)) / dampedFrequency) * sin(dampedFrequency * time))));
+    } else if (dampingRatio == 1.0) {
+        // Critically damped
+        displacement = (exp(-angularFrequency * time) * (x0 + ((v0 + (angularFrequency * x0)) * time)));
+    } else {
+        // Overdamped
+        CGFloat root = (angularFrequency * sqrt((dampingRatio * dampingRatio) - 1.0));
+        CGFloat r1 = ((-dampingRatio * angularFrequency) + root);
+        CGFloat r2 = ((-dampingRatio * angularFrequency) - root);
+        CGFloat c1 = ((v0 - (r2 * x0)) / (r1 - r2));
+        CGFloat c2 = (x0 - c1);
+        displacement = ((c1 * exp(r1 * time)) + (c2 * exp(r2 * time)));
+    }
+    // The pane bounces off of its target rather than passing through it
+    return (parameters.displacementSide * fabs(displacement));
+}
+
+static inline BOOL MSSpringMotionIsResting(CGFloat displacement, CGFloat velocity)
+{
+    return ((fabs(displacement) < MSSpringMotionRestDisplacement) && (fabs(velocity) < MSSpringMotionRestVelocity));
+}
+
+// The phases that the pane moves through during a transition, which determine how a new pane motion is started. Derived from the pan, motion engine, and Core Animation state rather than stored, so it can't fall out of sync with them.
+typedef NS_ENUM(NSUInteger, MSDynamicsDrawerPaneMotionPhase) {
+    // The pane is at rest, so a new motion begins from zero velocity
+    MSDynamicsDrawerPaneMotionPhaseResting,
+    // The pane is following the user's pan, which ends in a new motion when released
+    MSDynamicsDrawerPaneMotionPhaseDragging,
+    // The motion engine is moving the pane, so a new motion retargets it with the pane's current velocity
+    MSDynamicsDrawerPaneMotionPhaseEngine,
+    // A Core Animation transition is presenting the pane, so a new motion begins from its presented position and velocity
+    MSDynamicsDrawerPaneMotionPhaseCoreAnimation
+};
+
+typedef NS_ENUM(NSUInteger, MSDynamicsDrawerStylerDispatch) {
+    MSDynamicsDrawerStylerDispatchComposition,
+    MSDynamicsDrawerStylerDispatchLayout,
+    MSDynamicsDrawerStylerDispatchPaneClosedFraction,
+};
+
+typedef void (*MSDynamicsDrawerStylerCompositionIMP)(id, SEL, MSDynamicsDrawerViewController *, MSDynamicsDrawerLayout, MSDynamicsDrawerStylerComposition *);
+typedef void (*MSDynamicsDrawerStylerLayoutIMP)(id, SEL, MSDynamicsDrawerViewController *, MSDynamicsDrawerLayout);
+typedef void (*MSDynamicsDrawerStylerPaneClosedFractionIMP)(id, SEL, MSDynamicsDrawerViewController *, CGFloat, MSDynamicsDrawerDirection);
+
+// The parts of the layout that were last delivered to a styler, used to skip updates that wouldn't change its styling
+typedef struct {
+    BOOL delivered;
+    MSDynamicsDrawerDirection direction;
+    CGFloat revealWidth;
+    CGSize paneViewSize;
+    BOOL paneViewResting;
+    CGFloat paneClosedFraction;
+    CGFloat currentRevealWidth;
+} MSDynamicsDrawerStylerDelivery;
+
+static BOOL MSDynamicsDrawerStylerDeliveryRequired(const MSDynamicsDrawerStylerDelivery *delivery, MSDynamicsDrawerLayout layout, MSDynamicsDrawerStylerUpdateGranularity granularity, CGFloat updateDistance, CGFloat threshold)
+{
+    // Changes in direction or geometry are always delivered, regardless of granularity
+    if (!delivery->delivered ||
+        (delivery->direction != layout.direction) ||
+        (delivery->revealWidth != layout.revealWidth) ||
+        !CGSizeEqualToSize(delivery->paneViewSize, layout.paneViewFrame.size)) {
+        return YES;
+    }
+    switch (granularity) {
+        case MSDynamicsDrawerStylerUpdateGranularityRest:
+            if (!layout.paneViewResting) {
+                return NO;
+            }
+            break;
+        case MSDynamicsDrawerStylerUpdateGranularityDistance:
+            if (!layout.paneViewResting && (fabs(layout.currentRevealWidth - delivery->currentRevealWidth) < updateDistance)) {
+                return NO;
+            }
+            break;
+        case MSDynamicsDrawerStylerUpdateGranularityContinuous:
+            break;
+    }
+    if (delivery->paneViewResting != layout.paneViewResting) {
+        return YES;
+    }
+    if (fabs(layout.paneClosedFraction - delivery->paneClosedFraction) > threshold) {
+        return YES;
+    }
+    // The closed fraction is clamped at the reveal width, so the pane moving beyond it (when sliding off to open wide, or overshooting) is only reflected by the reveal width, with the threshold scaled to points
+    return (fabs(layout.currentRevealWidth - delivery->currentRevealWidth) > (threshold * layout.revealWidth));
+}
+
+static inline void MSDynamicsDrawerStylerDeliveryRecord(MSDynamicsDrawerStylerDelivery *delivery, MSDynamicsDrawerLayout layout)
+{
+    delivery->delivered = YES;
+    delivery->direction = layout.direction;
+    delivery->revealWidth = layout.revealWidth;
+    delivery->paneViewSize = layout.paneViewFrame.size;
+    delivery->paneViewResting = layout.paneViewResting;
+    delivery->paneClosedFraction = layout.paneClosedFraction;
+    delivery->currentRevealWidth = layout.currentRevealWidth;
+}
+
+// A styler along with the update method that it is dispatched to, resolved once when the stylers change. The styler is retained by the table that contains the entry.
+typedef struct {
+    __unsafe_unretained id <MSDynamicsDrawerStyler> styler;
+    __unsafe_unretained Class stylerClass;
+    MSDynamicsDrawerStylerDispatch dispatch;
+    SEL selector;
+    IMP implementation;
+    MSDynamicsDrawerStylerUpdateGranularity updateGranularity;
+    CGFloat updateDistance;
+    MSDynamicsDrawerStylerDelivery delivery;
+    // The time spent updating the styler during the transition in progress, which is folded into the transition metrics once the transition finishes
+    CFTimeInterval transitionUpdateDuration;
+} MSDynamicsDrawerStylerEntry;
+
+// An immutable, ordered list of stylers, so that dispatching updates to them every frame neither allocates nor looks up methods
+@interface MSDynamicsDrawerStylerTable : NSObject
+{
+    @public
+    MSDynamicsDrawerStylerEntry *_entries;
+    NSUInteger _count;
+    // Compositing stylers are delivered to as a group, so that their contributions are always applied together
+    MSDynamicsDrawerStylerDelivery _compositionDelivery;
+}
+
+@property (nonatomic, copy, readonly) NSArray *stylers;
+
+- (instancetype)initWithStylers:(NSArray *)stylers dynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController;
+- (void)invalidateDeliveries;
+
+@end
+
+// The per-direction configuration, stored in a table indexed by `MSDynamicsDrawerCardinalDirectionIndex` so that hot paths avoid boxing and hashing directions
+typedef struct {
+    CGFloat revealWidth;
+    CGFloat screenEdgePanThreshold;
+    BOOL paneDragRevealEnabled;
+    BOOL paneTapToCloseEnabled;
+    MSDynamicsDrawerTransitionSnapshotOptions transitionSnapshotOptions;
+    __strong UIViewController *drawerViewController;
+    __strong NSMutableOrderedSet *stylers;
+    __strong MSDynamicsDrawerStylerTable *stylerTable;
+} MSDynamicsDrawerDirectionConfiguration;
+
+// Forwards display link callbacks to a dynamics drawer view controller without retaining it, as `CADisplayLink` retains its target
+@interface MSDynamicsDrawerDisplayLinkTarget : NSObject
+
+@property (nonatomic, weak) MSDynamicsDrawerViewController *dynamicsDrawerViewController;
+
+@end
+
+// The stylers that were added or removed during a batch of styler updates, and their memberships when the batch began
+@interface MSDynamicsDrawerStylerBatch : NSObject
+
+@property (nonatomic, strong) NSMutableOrderedSet *stylers;
+@property (nonatomic, strong) NSMapTable *initialMemberships;
+@property (nonatomic, strong) NSMapTable *addedDirections;
+@property (nonatomic, strong) NSMapTable *removedDirections;
+
+@end
+
+// An in-flight animated replacement of the pane view controller, which can be retargeted until the pane view controller has been replaced
+@interface MSDynamicsDrawerPaneTransition : NSObject
+
+@property (nonatomic, strong) UIViewController *paneViewController;
+@property (nonatomic, copy) void (^completion)(void);
+@property (nonatomic, assign) BOOL slidOff;
+@property (nonatomic, assign) BOOL prepared;
+// Incremented for each preparation that begins, so that the callbacks of cancelled preparations can be told apart from the current one
+@property (nonatomic, assign) NSUInteger preparationGeneration;
+@property (nonatomic, assign) BOOL replaced;
+
+@end
+
+typedef NS_OPTIONS(NSUInteger, MSDynamicsDrawerStylerCompositionComponents) {
+    MSDynamicsDrawerStylerCompositionComponentDrawerViewTranslation = (1 << 0),
+    MSDynamicsDrawerStylerCompositionComponentDrawerViewScale = (1 << 1),
+    MSDynamicsDrawerStylerCompositionComponentDrawerViewAlpha = (1 << 2),
+    MSDynamicsDrawerStylerCompositionComponentDrawerViewControllerViewFrame = (1 << 3),
+    MSDynamicsDrawerStylerCompositionComponentPaneShadowLayer = (1 << 4),
+};
+
+@interface MSDynamicsDrawerStylerComposition ()
+{
+    MSDynamicsDrawerStylerCompositionComponents _components;
+    CGPoint _drawerViewTranslation;
+    CGFloat _drawerViewScale;
+    CGFloat _drawerViewAlpha;
+    CGRect _drawerViewControllerViewFrame;
+    CALayer *_paneShadowLayer;
+    // The shadow layer that was last applied, which persists across resets so that it can be replaced
+    __weak CALayer *_appliedPaneShadowLayer;
+}
+
+@property (nonatomic, readonly) BOOL hasContributions;
+@property (nonatomic, readonly) BOOL hasDrawerViewTransformContributions;
+@property (nonatomic, readonly) BOOL hasDrawerViewAlphaContributions;
+@property (nonatomic, readonly) BOOL hasDrawerViewControllerViewFrameContributions;
+@property (nonatomic, readonly) BOOL hasPaneShadowLayerContributions;
+
+- (void)reset;
+- (CGAffineTransform)drawerViewTransformByCompositingTransform:(CGAffineTransform)transform;
+- (CGFloat)drawerViewAlpha;
+- (CALayer *)paneShadowLayer;
+- (void)applyToDrawerView:(UIView *)drawerView drawerViewControllerView:(UIView *)drawerViewControllerView paneView:(UIView *)paneView;
+- (void)applyPaneShadowLayerToPaneView:(UIView *)paneView;
+
+@end
+
+static const char *MSDynamicsDrawerTransitionKindName(MSDynamicsDrawerTransitionKind kind)
+{
+    switch (kind) {
+        case MSDynamicsDrawerTransitionKindGesture:
+            return "Gesture";
+        case MSDynamicsDrawerTransitionKindTapToClose:
+            return "Tap to Close";
+        case MSDynamicsDrawerTransitionKindBounce:
+            return "Bounce";
+        case MSDynamicsDrawerTransitionKindProgrammatic:
+            return "Programmatic";
+    }
+    return "Unknown";
+}
+
+static os_log_t MSDynamicsDrawerTransitionsLog(void) API_AVAILABLE(ios(12.0))
+{
+    static os_log_t transitionsLog;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        transitionsLog = os_log_create("com.monospacecollective.MSDynamicsDrawerViewController", "Transitions");
+    });
+    return transitionsLog;
+}
+
+@interface MSDynamicsDrawerTransitionMetrics ()
+{
+    // Accumulated durations keyed by styler class, which are only converted to class names once the transition has finished
+    NSMutableDictionary *_stylerClassDurations;
+    CFTimeInterval _firstFrameTimestamp;
+    CFTimeInterval _lastFrameTimestamp;
+}
+
+@property (nonatomic, assign) MSDynamicsDrawerTransitionKind kind;
+@property (nonatomic, assign) MSDynamicsDrawerDirection direction;
+@property (nonatomic, assign) MSDynamicsDrawerPaneState paneState;
+@property (nonatomic, assign, getter = isInterrupted) BOOL interrupted;
+@property (nonatomic, assign) CFTimeInterval startTimestamp;
+@property (nonatomic, assign) CFTimeInterval endTimestamp;
+@property (nonatomic, assign) NSUInteger framesRendered;
+@property (nonatomic, assign) NSUInteger framesDropped;
+@property (nonatomic, assign) CFTimeInterval hitchDuration;
+@property (nonatomic, assign) CFTimeInterval longestHitchDuration;
+@property (nonatomic, assign) CFTimeInterval refreshInterval;
+@property (nonatomic, assign) CFTimeInterval stylerUpdateDuration;
+@property (nonatomic, assign) CFTimeInterval dynamicsBehaviorsDuration;
+@property (nonatomic, assign) os_signpost_id_t signpostIdentifier;
+// Whether signposts are being recorded, evaluated once as the transition begins so that the per-frame intervals aren't emitted when they aren't observed
+@property (nonatomic, assign) BOOL emitsSignposts;
+
+- (instancetype)initWithKind:(MSDynamicsDrawerTransitionKind)kind direction:(MSDynamicsDrawerDirection)direction startTimestamp:(CFTimeInterval)startTimestamp;
+- (void)recordFrameAtTimestamp:(CFTimeInterval)timestamp refreshInterval:(CFTimeInterval)refreshInterval;
+- (void)recordUpdateDuration:(CFTimeInterval)duration forStylerClass:(Class)stylerClass;
+- (void)finishWithPaneState:(MSDynamicsDrawerPaneState)paneState interrupted:(BOOL)interrupted endTimestamp:(CFTimeInterval)endTimestamp;
+
+@end
+
+// Captures the timestamps and the coalesced and predicted touches of the events that drive the pan, which `UIPanGestureRecognizer` doesn't otherwise expose
+@interface MSDynamicsDrawerPanGestureRecognizer : UIPanGestureRecognizer
+
+@property (nonatomic, assign) BOOL capturesCoalescedAndPredictedTouches;
+@property (nonatomic, assign, readonly) NSTimeInterval latestTouchTimestamp;
+@property (nonatomic, copy, readonly) NSArray *coalescedTouches;
+@property (nonatomic, copy, readonly) NSArray *predictedTouches;
+
+@end
+
+@interface MSDynamicsDrawerGestureRecorder ()
+{
+    NSMutableData *_trace;
+    NSUInteger _sampleCount;
+    NSTimeInterval _firstSampleTimestamp;
+}
+
+@property (nonatomic, assign, readwrite, getter = isRecording) BOOL recording;
+
+- (void)recordSampleWithState:(UIGestureRecognizerState)state location:(CGPoint)location timestamp:(NSTimeInterval)timestamp ofDynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController;
+
+@end
+
+// The layout of a gesture trace, as documented on `MSDynamicsDrawerGestureRecorder`. All fields are little endian.
+static const uint8_t MSGestureTraceMagic[4] = {'M', 'S', 'G', 'T'};
+static const uint16_t MSGestureTraceVersion = 1;
+enum {
+    MSGestureTraceHeaderSize = 24,
+    MSGestureTraceSampleSize = 16,
+};
+
+static inline void MSGestureTraceWriteUInt16(uint8_t *bytes, uint16_t value)
+{
+    value = CFSwapInt16HostToLittle(value);
+    memcpy(bytes, &value, sizeof(value));
+}
+
+static inline void MSGestureTraceWriteUInt32(uint8_t *bytes, uint32_t value)
+{
+    value = CFSwapInt32HostToLittle(value);
+    memcpy(bytes, &value, sizeof(value));
+}
+
+static inline void MSGestureTraceWriteFloat32(uint8_t *bytes, float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    MSGestureTraceWriteUInt32(bytes, bits);
+}
+
+static inline uint16_t MSGestureTraceReadUInt16(const uint8_t *bytes)
+{
+    uint16_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return CFSwapInt16LittleToHost(value);
+}
+
+static inline uint32_t MSGestureTraceReadUInt32(const uint8_t *bytes)
+{
+    uint32_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return CFSwapInt32LittleToHost(value);
+}
+
+static inline float MSGestureTraceReadFloat32(const uint8_t *bytes)
+{
+    uint32_t bits = MSGestureTraceReadUInt32(bytes);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+NSString * const MSCoreAnimationTransitionPaneAnimationKey = @"MSCoreAnimationTransitionPaneAnimation";
+NSString * const MSCoreAnimationTransitionDrawerTransformAnimationKey = @"MSCoreAnimationTransitionDrawerTransformAnimation";
+NSString * const MSCoreAnimationTransitionDrawerOpacityAnimationKey = @"MSCoreAnimationTransitionDrawerOpacityAnimation";
+
+@interface MSDynamicsDrawerViewController () <UIGestureRecognizerDelegate, MSDynamicsDrawerPaneMotionEngineDelegate, CAAnimationDelegate>
+{
+    MSDynamicsDrawerDirectionConfiguration _directionConfigurations[MSDynamicsDrawerCardinalDirectionCount];
+    // The stylers of all directions, updated when there's no current direction
+    MSDynamicsDrawerStylerTable *_allStylerTable;
+    // The number of directions that each styler is set in, so that membership is known without scanning every direction
+    NSCountedSet *_stylerMemberships;
+    // The depth of nested styler update batches, and the changes made during the outermost batch
+    NSUInteger _stylerUpdateDepth;
+    MSDynamicsDrawerStylerBatch *_stylerBatch;
+    MSPanTracker _panTracker;
+    MSPanEdgeArbitration _panEdgeArbitration;
+    MSDynamicsDrawerFrameRateRange _frameRateRanges[MSDynamicsDrawerTransitionKindCount];
+    // The geometry kernels of the current direction (`NULL` when closed), and of the axis of the possible directions, selected when the directions change
+    const MSDynamicsDrawerDirectionKernel *_currentDirectionKernel;
+    const MSDynamicsDrawerDirectionKernel *_possibleDirectionKernel;
+    // Balances nested calls to `setViewUserInteractionEnabled:` on this instance
+    NSInteger _viewUserInteractionDisableCount;
+}
 
 // State
 @property (nonatomic, assign) BOOL animatingRotation;
 @property (nonatomic, assign) MSDynamicsDrawerDirection currentDrawerDirection;
 @property (nonatomic, assign) MSDynamicsDrawerDirection possibleDrawerDirection;
 @property (nonatomic, assign) MSDynamicsDrawerPaneState potentialPaneState;
+@property (nonatomic, assign) MSDynamicsDrawerDirection potentialDrawerDirection;
 // View Controller Container Views
 @property (nonatomic, strong) UIView *drawerView;
 @property (nonatomic, strong) UIView *paneView;
 // Visible View Controllers
 @property (nonatomic, strong) UIViewController *drawerViewController;
-// Internal Properties
-@property (nonatomic, strong) NSMutableDictionary *drawerViewControllers;
-@property (nonatomic, strong) NSMutableDictionary *revealWidth;
-@property (nonatomic, strong) NSMutableDictionary *paneDragRevealEnabled;
-@property (nonatomic, strong) NSMutableDictionary *paneTapToCloseEnabled;
-@property (nonatomic, strong) NSMutableDictionary *stylers;
+@property (nonatomic, strong) MSDynamicsDrawerPaneTransition *paneTransition;
+// Cached pane view controllers by key, with their keys ordered from most to least recently shown
+@property (nonatomic, strong) NSMutableDictionary *cachedPaneViewControllers;
+@property (nonatomic, strong) NSMutableArray *cachedPaneViewControllerKeys;
+// Kept alive drawer view controllers that aren't visible, ordered from most to least recently visible
+@property (nonatomic, strong) NSMutableArray *keptAliveDrawerViewControllers;
 // Gestures
 @property (nonatomic, strong) NSMutableSet *touchForwardingClasses;
-@property (nonatomic, strong) UIPanGestureRecognizer *panePanGestureRecognizer;
+@property (nonatomic, strong) NSMutableDictionary *touchForwardingClassVerdicts;
+@property (nonatomic, strong) MSDynamicsDrawerPanGestureRecognizer *panePanGestureRecognizer;
 @property (nonatomic, strong) UITapGestureRecognizer *paneTapGestureRecognizer;
 // Dynamics
-@property (nonatomic, strong) UIDynamicAnimator *dynamicAnimator;
-@property (nonatomic, strong) UIPushBehavior *panePushBehavior;
-@property (nonatomic, strong) UIDynamicItemBehavior *paneElasticityBehavior;
-@property (nonatomic, strong) UIGravityBehavior *paneGravityBehavior;
-@property (nonatomic, strong) UICollisionBehavior *paneBoundaryCollisionBehavior;
-@property (nonatomic, copy) void (^dynamicAnimatorCompletion)(void);
+// The completions of every pane motion since the pane was last at rest, invoked in order once it comes to rest
+@property (nonatomic, strong) NSMutableArray *paneMotionCompletions;
+@property (nonatomic, strong) CAAnimation *coreAnimationTransitionAnimation;
+// The frame that the pane view is moved to once the Core Animation transition finishes, as its model frame remains at its start until then
+@property (nonatomic, assign) CGRect coreAnimationTransitionPaneViewFrame;
+// Pane Updates
+@property (nonatomic, strong) CADisplayLink *displayLink;
+// The frame rate range of the transition in progress, applied to everything that drives pane updates
+@property (nonatomic, assign) MSDynamicsDrawerFrameRateRange activeFrameRateRange;
+@property (nonatomic, assign) BOOL paneViewNeedsUpdate;
+// Stylers
+@property (nonatomic, strong) MSDynamicsDrawerStylerComposition *stylerComposition;
+// Transition Snapshots
+@property (nonatomic, assign) BOOL transitionSnapshotsActive;
+@property (nonatomic, strong) UIView *paneSnapshotView;
+@property (nonatomic, strong) UIView *paneSnapshotLiveView;
+@property (nonatomic, strong) UIView *drawerSnapshotView;
+@property (nonatomic, strong) UIView *drawerSnapshotLiveView;
+// Transition Metrics
+@property (nonatomic, strong) MSDynamicsDrawerTransitionMetrics *transitionMetrics;
+
+- (void)displayLinkDidFire:(CADisplayLink *)displayLink;
+
+@end
+
+static inline void MSDynamicsDrawerStylerEntryUpdate(const MSDynamicsDrawerStylerEntry *entry, MSDynamicsDrawerViewController *dynamicsDrawerViewController, MSDynamicsDrawerLayout layout, MSDynamicsDrawerStylerComposition *composition)
+{
+    switch (entry->dispatch) {
+        case MSDynamicsDrawerStylerDispatchComposition:
+            ((MSDynamicsDrawerStylerCompositionIMP)entry->implementation)(entry->styler, entry->selector, dynamicsDrawerViewController, layout, composition);
+            break;
+        case MSDynamicsDrawerStylerDispatchLayout:
+            ((MSDynamicsDrawerStylerLayoutIMP)entry->implementation)(entry->styler, entry->selector, dynamicsDrawerViewController, layout);
+            break;
+        case MSDynamicsDrawerStylerDispatchPaneClosedFraction:
+            ((MSDynamicsDrawerStylerPaneClosedFractionIMP)entry->implementation)(entry->styler, entry->selector, dynamicsDrawerViewController, layout.paneClosedFraction, layout.direction);
+            break;
+    }
+}
+
+@implementation MSDynamicsDrawerDisplayLinkTarget
+
+- (void)displayLinkDidFire:(CADisplayLink *)displayLink
+{
+    [self.dynamicsDrawerViewController displayLinkDidFire:displayLink];
+}
+
+@end
+
+@implementation MSDynamicsDrawerStylerBatch
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        self.stylers = [NSMutableOrderedSet new];
+        self.initialMemberships = [NSMapTable strongToStrongObjectsMapTable];
+        self.addedDirections = [NSMapTable strongToStrongObjectsMapTable];
+        self.removedDirections = [NSMapTable strongToStrongObjectsMapTable];
+    }
+    return self;
+}
+
+@end
+
+@implementation MSDynamicsDrawerPaneTransition
+
+@end
+
+@interface MSDynamicsDrawerPanGestureRecognizer ()
+
+@property (nonatomic, assign, readwrite) NSTimeInterval latestTouchTimestamp;
+@property (nonatomic, copy, readwrite) NSArray *coalescedTouches;
+@property (nonatomic, copy, readwrite) NSArray *predictedTouches;
+
+@end
+
+@implementation MSDynamicsDrawerPanGestureRecognizer
+
+- (void)touchesBegan:(NSSet *)touches withEvent:(UIEvent *)event
+{
+    // Capture before forwarding to super, as super may send the action message synchronously
+    [self captureTouches:touches withEvent:event];
+    [super touchesBegan:touches withEvent:event];
+}
+
+- (void)touchesMoved:(NSSet *)touches withEvent:(UIEvent *)event
+{
+    [self captureTouches:touches withEvent:event];
+    [super touchesMoved:touches withEvent:event];
+}
+
+- (void)touchesEnded:(NSSet *)touches withEvent:(UIEvent *)event
+{
+    [self captureTouches:touches withEvent:event];
+    [super touchesEnded:touches withEvent:event];
+}
+
+- (void)reset
+{
+    [super reset];
+    self.latestTouchTimestamp = 0.0;
+    self.coalescedTouches = nil;
+    self.predictedTouches = nil;
+}
+
+- (void)captureTouches:(NSSet *)touches withEvent:(UIEvent *)event
+{
+    UITouch *touch = [touches anyObject];
+    self.latestTouchTimestamp = touch.timestamp;
+    // Coalesced and predicted touches are only available on iOS 9+
+    if (self.capturesCoalescedAndPredictedTouches && [event respondsToSelector:@selector(coalescedTouchesForTouch:)]) {
+        self.coalescedTouches = [event coalescedTouchesForTouch:touch];
+        self.predictedTouches = [event predictedTouchesForTouch:touch];
+    } else {
+        self.coalescedTouches = nil;
+        self.predictedTouches = nil;
+    }
+}
 
 @end
 
@@ -155,7 +927,9 @@ void MSDynamicsDrawerDirectionActionForMaskedValues(NSInteger direction, MSDynam
 
 - (void)dealloc
 {
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(performDrawerViewControllerPrewarm) object:nil];
     [self.paneView removeObserver:self forKeyPath:NSStringFromSelector(@selector(frame))];
+    [_displayLink invalidate];
 }
 
 #pragma mark - UIViewController
@@ -176,19 +950,6 @@ void MSDynamicsDrawerDirectionActionForMaskedValues(NSInteger direction, MSDynam
     self.paneView.frame = self.view.bounds;
     [self.view addSubview:self.drawerView];
     [self.view addSubview:self.paneView];
-    
-    self.dynamicAnimator = [[UIDynamicAnimator alloc] initWithReferenceView:self.view];
-    self.dynamicAnimator.delegate = self;
-    
-    self.paneBoundaryCollisionBehavior = [[UICollisionBehavior alloc] initWithItems:@[self.paneView]];
-    self.paneGravityBehavior = [[UIGravityBehavior alloc] initWithItems:@[self.paneView]];
-    self.panePushBehavior = [[UIPushBehavior alloc] initWithItems:@[self.paneView] mode:UIPushBehaviorModeInstantaneous];
-    self.paneElasticityBehavior = [[UIDynamicItemBehavior alloc] initWithItems:@[self.paneView]];
-    
-    __weak typeof(self) weakSelf = self;
-    self.paneGravityBehavior.action = ^{
-        [weakSelf didUpdateDynamicAnimatorAction];
-    };
 }
 
 //- (void)willRotateToInterfaceOrientation:(UIInterfaceOrientation)toInterfaceOrientation duration:(NSTimeInterval)duration
@@ -220,6 +981,15 @@ void MSDynamicsDrawerDirectionActionForMaskedValues(NSInteger direction, MSDynam
 //    return supportedInterfaceOrientations;
 //}
 
+- (void)didReceiveMemoryWarning
+{
+    [super didReceiveMemoryWarning];
+    if (self.drawerViewControllerKeepAlivePolicy == MSDynamicsDrawerKeepAlivePolicyEvictOnMemoryWarning) {
+        [self detachKeptAliveDrawerViewControllersInRange:NSMakeRange(0, self.keptAliveDrawerViewControllers.count)];
+    }
+    [self trimCachedPaneViewControllersToCount:0];
+}
+
 - (UIViewController *)childViewControllerForStatusBarStyle
 {
     return self.paneViewController;
@@ -227,9 +997,21 @@ void MSDynamicsDrawerDirectionActionForMaskedValues(NSInteger direction, MSDynam
 
 - (UIViewController *)childViewControllerForStatusBarHidden
 {
+    // When the status bar aligner hides the status bar, the pane view controller is no longer in charge of it
+    if ([self statusBarHiddenByAligner]) {
+        return nil;
+    }
     return self.paneViewController;
 }
 
+- (BOOL)prefersStatusBarHidden
+{
+    if ([self statusBarHiddenByAligner]) {
+        return YES;
+    }
+    return [super prefersStatusBarHidden];
+}
+
 #pragma mark - MSDynamicsDrawerViewController
 
 - (void)initialize
@@ -237,18 +1019,45 @@ void MSDynamicsDrawerDirectionActionForMaskedValues(NSInteger direction, MSDynam
     _paneState = MSDynamicsDrawerPaneStateClosed;
     _currentDrawerDirection = MSDynamicsDrawerDirectionNone;
     self.potentialPaneState = NSIntegerMax;
+    self.potentialDrawerDirection = MSDynamicsDrawerDirectionNone;
+    self.paneMotionCompletions = [NSMutableArray new];
+    
+    for (NSUInteger kind = 0; kind < MSDynamicsDrawerTransitionKindCount; kind++) {
+        _frameRateRanges[kind] = MSDynamicsDrawerFrameRateRangeDefault;
+    }
+    // Bounces are ambient rather than interactive, so they don't need the maximum refresh rate of the display
+    _frameRateRanges[MSDynamicsDrawerTransitionKindBounce] = MSDynamicsDrawerFrameRateRangeMake(30.0, 60.0, 60.0);
+    self.activeFrameRateRange = MSDynamicsDrawerFrameRateRangeDefault;
     
     self.paneViewSlideOffAnimationEnabled = (UI_USER_INTERFACE_IDIOM() == UIUserInterfaceIdiomPhone);
+    self.paneViewControllerPreparationTimeout = 1.0;
+    
+    self.cachedPaneViewControllers = [NSMutableDictionary new];
+    self.cachedPaneViewControllerKeys = [NSMutableArray new];
+    self.paneViewControllerCacheCapacity = 3;
+    // Snapshot alignment costs a screen snapshot as each drag begins and freezes the status bar contents, so it's opt-in
+    self.statusBarAligner = [MSDynamicsDrawerStatusBarTransformAligner new];
     self.shouldAlignStatusBarToPaneView = YES;
     self.screenEdgePanCancelsConflictingGestures = YES;
     
-    self.drawerViewControllers = [NSMutableDictionary new];
-    self.revealWidth = [NSMutableDictionary new];
-    self.paneDragRevealEnabled = [NSMutableDictionary new];
-    self.paneTapToCloseEnabled = [NSMutableDictionary new];
-    self.stylers = [NSMutableDictionary new];
+    for (NSUInteger index = 0; index < MSDynamicsDrawerCardinalDirectionCount; index++) {
+        MSDynamicsDrawerDirectionConfiguration *configuration = &_directionConfigurations[index];
+        configuration->revealWidth = MSDynamicsDrawerDefaultRevealWidthForDirection(MSDynamicsDrawerCardinalDirectionForIndex(index));
+        configuration->screenEdgePanThreshold = MSPaneViewScreenEdgeThreshold;
+        configuration->paneDragRevealEnabled = YES;
+        configuration->paneTapToCloseEnabled = YES;
+        configuration->transitionSnapshotOptions = MSDynamicsDrawerTransitionSnapshotOptionNone;
+        configuration->stylers = [NSMutableOrderedSet new];
+    }
+    _stylerMemberships = [NSCountedSet new];
+    [self rebuildStylerTables];
+    self.stylerComposition = [MSDynamicsDrawerStylerComposition new];
+    
+    self.keptAliveDrawerViewControllers = [NSMutableArray new];
+    self.drawerViewControllerKeepAlivePolicy = MSDynamicsDrawerKeepAlivePolicyNone;
     
     self.touchForwardingClasses = [NSMutableSet setWithArray:@[[UISlider class], [UISwitch class]]];
+    self.touchForwardingClassVerdicts = [NSMutableDictionary new];
     
     self.drawerView = [UIView new];
     self.drawerView.autoresizingMask = (UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight);
@@ -257,12 +1066,15 @@ void MSDynamicsDrawerDirectionActionForMaskedValues(NSInteger direction, MSDynam
     self.paneView.autoresizingMask = (UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight);
     [self.paneView addObserver:self forKeyPath:NSStringFromSelector(@selector(frame)) options:0 context:NULL];
     
-    self.panePanGestureRecognizer = [[UIPanGestureRecognizer alloc] initWithTarget:self action:@selector(panePanned:)];
+    self.panePanGestureRecognizer = [[MSDynamicsDrawerPanGestureRecognizer alloc] initWithTarget:self action:@selector(panePanned:)];
     self.panePanGestureRecognizer.minimumNumberOfTouches = 1;
     self.panePanGestureRecognizer.maximumNumberOfTouches = 1;
     self.panePanGestureRecognizer.delegate = self;
     [self.paneView addGestureRecognizer:self.panePanGestureRecognizer];
     
+    self.paneDragPredictionEnabled = NO;
+    self.paneDragPredictionInterval = MSPaneDragPredictionDefaultInterval;
+    
     self.paneTapGestureRecognizer = [[UITapGestureRecognizer alloc] initWithTarget:self action:@selector(paneTapped:)];
     self.paneTapGestureRecognizer.numberOfTouchesRequired = 1;
     self.paneTapGestureRecognizer.numberOfTapsRequired = 1;
@@ -274,6 +1086,7 @@ void MSDynamicsDrawerDirectionActionForMaskedValues(NSInteger direction, MSDynam
     self.bounceElasticity = 0.5;
     self.bounceMagnitude = 60.0;
     self.paneStateOpenWideEdgeOffset = 20.0;
+    self.paneMotionEngine = [MSDynamicsDrawerDynamicsMotionEngine new];
     
 #if defined(DEBUG_LAYOUT)
     self.drawerView.backgroundColor = [[UIColor redColor] colorWithAlphaComponent:0.5];
@@ -308,15 +1121,20 @@ void MSDynamicsDrawerDirectionActionForMaskedValues(NSInteger direction, MSDynam
     NSAssert(((self.possibleDrawerDirection & direction) == direction), @"Unable to bounce open with impossible/multiple directions");
     
     self.currentDrawerDirection = direction;
+    
+    // A coalesced motion continues the transition in progress, along with its metrics and frame rate
+    if (![self paneMotionCoalescesWithPaneState:MSDynamicsDrawerPaneStateClosed pushMagnitude:self.bounceMagnitude]) {
+        [self beginTransitionWithKind:MSDynamicsDrawerTransitionKindBounce];
+    }
 
-    [self addDynamicsBehaviorsToCreatePaneState:MSDynamicsDrawerPaneStateClosed pushMagnitude:self.bounceMagnitude pushAngle:[self gravityAngleForState:MSDynamicsDrawerPaneStateOpen direction:direction] pushElasticity:self.bounceElasticity];
+    [self addDynamicsBehaviorsToCreatePaneState:MSDynamicsDrawerPaneStateClosed pushMagnitude:self.bounceMagnitude pushAngle:[self gravityAngleForState:MSDynamicsDrawerPaneStateOpen direction:direction] pushElasticity:self.bounceElasticity programmatic:YES];
     
     if (!allowUserInterruption) [self setViewUserInteractionEnabled:NO];
     __weak typeof(self) weakSelf = self;
-    self.dynamicAnimatorCompletion = ^{
+    [self addPaneMotionCompletion:^{
         if (!allowUserInterruption) [weakSelf setViewUserInteractionEnabled:YES];
         if (completion) completion();
-    };
+    }];
 }
 
 #pragma mark Generic View Controller Containment
@@ -367,49 +1185,164 @@ void MSDynamicsDrawerDirectionActionForMaskedValues(NSInteger direction, MSDynam
 
 - (void)setDrawerViewController:(UIViewController *)drawerViewController
 {
-    [self replaceViewController:self.drawerViewController withViewController:drawerViewController inContainerView:self.drawerView completion:^{
-        self->_drawerViewController = drawerViewController;
-    }];
+    if (self.drawerViewControllerKeepAlivePolicy == MSDynamicsDrawerKeepAlivePolicyNone) {
+        [self replaceViewController:self.drawerViewController withViewController:drawerViewController inContainerView:self.drawerView completion:^{
+            self->_drawerViewController = drawerViewController;
+        }];
+        return;
+    }
+    UIViewController *existingDrawerViewController = self.drawerViewController;
+    if (existingDrawerViewController == drawerViewController) {
+        return;
+    }
+    // Rather than removing the existing drawer view controller, hide it and keep it attached
+    if (existingDrawerViewController) {
+        [existingDrawerViewController beginAppearanceTransition:NO animated:NO];
+        existingDrawerViewController.view.hidden = YES;
+        [existingDrawerViewController endAppearanceTransition];
+        [self.keptAliveDrawerViewControllers insertObject:existingDrawerViewController atIndex:0];
+    }
+    if (drawerViewController) {
+        if (drawerViewController.parentViewController != self) {
+            [self attachHiddenDrawerViewController:drawerViewController];
+        }
+        [self.keptAliveDrawerViewControllers removeObject:drawerViewController];
+        [drawerViewController beginAppearanceTransition:YES animated:NO];
+        drawerViewController.view.frame = self.drawerView.bounds;
+        [self.drawerView bringSubviewToFront:drawerViewController.view];
+        drawerViewController.view.hidden = NO;
+        [drawerViewController endAppearanceTransition];
+    }
+    _drawerViewController = drawerViewController;
+    [self trimKeptAliveDrawerViewControllers];
 }
 
 - (void)setDrawerViewController:(UIViewController *)drawerViewController forDirection:(MSDynamicsDrawerDirection)direction
 {
     NSAssert(MSDynamicsDrawerDirectionIsCardinal(direction), @"Only accepts cardinal reveal directions");
-    for (UIViewController * __unused currentDrawerViewController in self.drawerViewControllers) {
-        NSAssert(currentDrawerViewController != drawerViewController, @"Unable to add a drawer view controller when it's previously been added");
+    for (NSUInteger index = 0; index < MSDynamicsDrawerCardinalDirectionCount; index++) {
+        NSAssert(!drawerViewController || (_directionConfigurations[index].drawerViewController != drawerViewController), @"Unable to add a drawer view controller when it's previously been added");
     }
     if (direction & MSDynamicsDrawerDirectionHorizontal) {
-        NSAssert(!(self.drawerViewControllers[@(MSDynamicsDrawerDirectionTop)] || self.drawerViewControllers[@(MSDynamicsDrawerDirectionBottom)]), @"Unable to simultaneously have top/bottom drawer view controllers while setting left/right drawer view controllers");
+        NSAssert(!([self drawerViewControllerForDirection:MSDynamicsDrawerDirectionTop] || [self drawerViewControllerForDirection:MSDynamicsDrawerDirectionBottom]), @"Unable to simultaneously have top/bottom drawer view controllers while setting left/right drawer view controllers");
     } else if (direction & MSDynamicsDrawerDirectionVertical) {
-        NSAssert(!(self.drawerViewControllers[@(MSDynamicsDrawerDirectionLeft)] || self.drawerViewControllers[@(MSDynamicsDrawerDirectionRight)]), @"Unable to simultaneously have left/right drawer view controllers while setting top/bottom drawer view controllers");
+        NSAssert(!([self drawerViewControllerForDirection:MSDynamicsDrawerDirectionLeft] || [self drawerViewControllerForDirection:MSDynamicsDrawerDirectionRight]), @"Unable to simultaneously have left/right drawer view controllers while setting top/bottom drawer view controllers");
+    }
+    MSDynamicsDrawerDirectionConfiguration *configuration = &_directionConfigurations[MSDynamicsDrawerCardinalDirectionIndex(direction)];
+    UIViewController *existingDrawerViewController = configuration->drawerViewController;
+    // A replaced or removed drawer view controller should no longer be kept alive
+    if (existingDrawerViewController != drawerViewController) {
+        [self detachKeptAliveDrawerViewController:existingDrawerViewController];
     }
-    UIViewController *existingDrawerViewController = self.drawerViewControllers[@(direction)];
     // New drawer view controller
     if (drawerViewController && !existingDrawerViewController) {
         self.possibleDrawerDirection |= direction;
-        self.drawerViewControllers[@(direction)] = drawerViewController;
+        configuration->drawerViewController = drawerViewController;
     }
     // Removing existing drawer view controller
     else if (!drawerViewController && existingDrawerViewController) {
         self.possibleDrawerDirection ^= direction;
-        [self.drawerViewControllers removeObjectForKey:@(direction)];
+        configuration->drawerViewController = nil;
     }
     // Replace existing drawer view controller
     else if (drawerViewController && existingDrawerViewController) {
-        self.drawerViewControllers[@(direction)] = drawerViewController;
+        configuration->drawerViewController = drawerViewController;
     }
 }
 
 - (UIViewController *)drawerViewControllerForDirection:(MSDynamicsDrawerDirection)direction
 {
     NSAssert(MSDynamicsDrawerDirectionIsCardinal(direction), @"Only cardinal reveal directions are accepted");
-    return self.drawerViewControllers[@(direction)];
+    return _directionConfigurations[MSDynamicsDrawerCardinalDirectionIndex(direction)].drawerViewController;
+}
+
+#pragma mark Drawer View Controller Keep Alive
+
+- (void)setDrawerViewControllerKeepAlivePolicy:(MSDynamicsDrawerKeepAlivePolicy)drawerViewControllerKeepAlivePolicy
+{
+    _drawerViewControllerKeepAlivePolicy = drawerViewControllerKeepAlivePolicy;
+    [self trimKeptAliveDrawerViewControllers];
+}
+
+- (void)attachHiddenDrawerViewController:(UIViewController *)drawerViewController
+{
+    [drawerViewController willMoveToParentViewController:self];
+    [self addChildViewController:drawerViewController];
+    drawerViewController.view.frame = self.drawerView.bounds;
+    drawerViewController.view.hidden = YES;
+    [self.drawerView addSubview:drawerViewController.view];
+    [drawerViewController didMoveToParentViewController:self];
+}
+
+- (void)detachKeptAliveDrawerViewControllersInRange:(NSRange)range
+{
+    // Kept alive drawer view controllers have already disappeared, so they only need to be removed from the hierarchy
+    for (UIViewController *drawerViewController in [self.keptAliveDrawerViewControllers subarrayWithRange:range]) {
+        [drawerViewController willMoveToParentViewController:nil];
+        [drawerViewController.view removeFromSuperview];
+        drawerViewController.view.hidden = NO;
+        [drawerViewController removeFromParentViewController];
+        [drawerViewController didMoveToParentViewController:nil];
+    }
+    [self.keptAliveDrawerViewControllers removeObjectsInRange:range];
+}
+
+- (void)detachKeptAliveDrawerViewController:(UIViewController *)drawerViewController
+{
+    NSUInteger index = [self.keptAliveDrawerViewControllers indexOfObjectIdenticalTo:drawerViewController];
+    if (index != NSNotFound) {
+        [self detachKeptAliveDrawerViewControllersInRange:NSMakeRange(index, 1)];
+    }
+}
+
+- (void)trimKeptAliveDrawerViewControllers
+{
+    NSUInteger keptAliveCount = self.keptAliveDrawerViewControllers.count;
+    switch (self.drawerViewControllerKeepAlivePolicy) {
+        case MSDynamicsDrawerKeepAlivePolicyNone:
+            [self detachKeptAliveDrawerViewControllersInRange:NSMakeRange(0, keptAliveCount)];
+            break;
+        case MSDynamicsDrawerKeepAlivePolicyKeepLast:
+            if (keptAliveCount > 1) {
+                [self detachKeptAliveDrawerViewControllersInRange:NSMakeRange(1, (keptAliveCount - 1))];
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+- (void)prewarmDrawerViewControllers
+{
+    // Coalesce repeated requests, and defer the work until the run loop isn't tracking
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(performDrawerViewControllerPrewarm) object:nil];
+    [self performSelector:@selector(performDrawerViewControllerPrewarm) withObject:nil afterDelay:0.0 inModes:@[NSDefaultRunLoopMode]];
+}
+
+- (void)performDrawerViewControllerPrewarm
+{
+    for (NSUInteger index = 0; index < MSDynamicsDrawerCardinalDirectionCount; index++) {
+        UIViewController *drawerViewController = _directionConfigurations[index].drawerViewController;
+        if (!drawerViewController || (drawerViewController == self.drawerViewController)) {
+            continue;
+        }
+        // Accessing the view loads it
+        drawerViewController.view.frame = self.drawerView.bounds;
+        [drawerViewController.view layoutIfNeeded];
+        if ((self.drawerViewControllerKeepAlivePolicy != MSDynamicsDrawerKeepAlivePolicyNone) && (drawerViewController.parentViewController != self)) {
+            [self attachHiddenDrawerViewController:drawerViewController];
+            [self.keptAliveDrawerViewControllers addObject:drawerViewController];
+        }
+    }
+    [self trimKeptAliveDrawerViewControllers];
 }
 
 #pragma mark Pane View Controller
 
 - (void)setPaneViewController:(UIViewController *)paneViewController
 {
+    // A snapshot of the existing pane would otherwise cover the new pane until the pane comes to rest
+    [self endTransitionSnapshots];
     [self replaceViewController:self.paneViewController withViewController:paneViewController inContainerView:self.paneView completion:^{
         self->_paneViewController = paneViewController;
         [self setNeedsStatusBarAppearanceUpdate];
@@ -420,43 +1353,43 @@ void MSDynamicsDrawerDirectionActionForMaskedValues(NSInteger direction, MSDynam
 {
     NSParameterAssert(paneViewController);
     if (!animated) {
+        [self abandonPaneTransition];
         self.paneViewController = paneViewController;
         if (completion) completion();
         return;
     }
+    MSDynamicsDrawerPaneTransition *paneTransition = self.paneTransition;
+    // Retarget a transition that hasn't replaced the pane view controller yet, rather than queuing another animation
+    if (paneTransition && !paneTransition.replaced) {
+        paneTransition.completion = completion;
+        if (paneTransition.paneViewController != paneViewController) {
+            [self cancelPreparationForPaneTransition:paneTransition];
+            paneTransition.paneViewController = paneViewController;
+            [self beginPreparationForPaneTransition:paneTransition];
+        }
+        return;
+    }
+    // A transition that is closing the pane over its new pane view controller is completed where it is
+    [self finishPaneTransition:paneTransition];
+    
     if (self.paneViewController != paneViewController) {
+        paneTransition = [MSDynamicsDrawerPaneTransition new];
+        paneTransition.paneViewController = paneViewController;
+        paneTransition.completion = completion;
+        self.paneTransition = paneTransition;
         [self.paneViewController willMoveToParentViewController:nil];
         [self.paneViewController beginAppearanceTransition:NO animated:animated];
-        void(^transitionToNewPaneViewController)(void) = ^{
-            [paneViewController willMoveToParentViewController:self];
-            [self.paneViewController.view removeFromSuperview];
-            [self.paneViewController removeFromParentViewController];
-            [self.paneViewController didMoveToParentViewController:nil];
-            [self.paneViewController endAppearanceTransition];
-            [self addChildViewController:paneViewController];
-            paneViewController.view.frame = self.paneView.bounds;
-            [paneViewController beginAppearanceTransition:YES animated:animated];
-            [self.paneView addSubview:paneViewController.view];
-            self->_paneViewController = paneViewController;
-            // Force redraw of the new pane view (drastically smoothes animation)
-            [self.paneView setNeedsDisplay];
-            [CATransaction flush];
-            [self setNeedsStatusBarAppearanceUpdate];
-            // After drawing has finished, set new pane view controller view and close
-            dispatch_async(dispatch_get_main_queue(), ^{
-                __weak typeof(self) weakSelf = self;
-                self->_paneViewController = paneViewController;
-                [self setPaneState:MSDynamicsDrawerPaneStateClosed animated:animated allowUserInterruption:YES completion:^{
-                    [paneViewController didMoveToParentViewController:weakSelf];
-                    [paneViewController endAppearanceTransition];
-                    if (completion) completion();
-                }];
-            });
-        };
+        // Preparation overlaps with the pane sliding off
+        [self beginPreparationForPaneTransition:paneTransition];
         if (self.paneViewSlideOffAnimationEnabled) {
-            [self setPaneState:MSDynamicsDrawerPaneStateOpenWide animated:animated allowUserInterruption:NO completion:transitionToNewPaneViewController];
+            __weak typeof(self) weakSelf = self;
+            [self setPaneState:MSDynamicsDrawerPaneStateOpenWide animated:animated allowUserInterruption:NO completion:^{
+                paneTransition.slidOff = YES;
+                [weakSelf continuePaneTransition:paneTransition];
+            }];
         } else {
-            transitionToNewPaneViewController();
+            paneTransition.slidOff = YES;
+            [self continuePaneTransition:paneTransition];
         }
     }
     // If trying to set to the currently visible pane view controller, just close
@@ -467,911 +1400,2687 @@ void MSDynamicsDrawerDirectionActionForMaskedValues(NSInteger direction, MSDynam
     }
 }
 
-#pragma mark Dynamics
+#pragma mark Pane View Controller Transitions
 
-- (void)didUpdateDynamicAnimatorAction
+- (void)beginPreparationForPaneTransition:(MSDynamicsDrawerPaneTransition *)paneTransition
 {
-    [self paneViewDidUpdateFrame];
+    UIViewController *paneViewController = paneTransition.paneViewController;
+    // The currently visible pane view controller is already prepared, as is one that doesn't ask to be
+    if ((paneViewController == self.paneViewController) || ![paneViewController conformsToProtocol:@protocol(MSDynamicsDrawerPaneTransitionPreparing)]) {
+        paneTransition.prepared = YES;
+        [self continuePaneTransition:paneTransition];
+        return;
+    }
+    paneTransition.prepared = NO;
+    NSUInteger preparationGeneration = ++paneTransition.preparationGeneration;
+    __weak typeof(self) weakSelf = self;
+    __weak MSDynamicsDrawerPaneTransition *weakPaneTransition = paneTransition;
+    void (^preparationDidFinish)(void) = ^{
+        MSDynamicsDrawerPaneTransition *strongPaneTransition = weakPaneTransition;
+        // Ignore preparations that finish after the timeout, or after the transition has been retargeted. The generation distinguishes a cancelled preparation from a later one of the same pane view controller, as when retargeted from A to B and back to A.
+        if (!strongPaneTransition || strongPaneTransition.prepared || (strongPaneTransition.preparationGeneration != preparationGeneration)) {
+            return;
+        }
+        strongPaneTransition.prepared = YES;
+        [weakSelf continuePaneTransition:strongPaneTransition];
+    };
+    [(id <MSDynamicsDrawerPaneTransitionPreparing>)paneViewController prepareForPaneTransitionInDynamicsDrawerViewController:self completion:^{
+        if ([NSThread isMainThread]) {
+            preparationDidFinish();
+        } else {
+            dispatch_async(dispatch_get_main_queue(), preparationDidFinish);
+        }
+    }];
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.paneViewControllerPreparationTimeout * NSEC_PER_SEC)), dispatch_get_main_queue(), preparationDidFinish);
 }
 
-- (void)addDynamicsBehaviorsToCreatePaneState:(MSDynamicsDrawerPaneState)paneState;
+- (void)cancelPreparationForPaneTransition:(MSDynamicsDrawerPaneTransition *)paneTransition
 {
-    [self addDynamicsBehaviorsToCreatePaneState:paneState pushMagnitude:0.0 pushAngle:0.0 pushElasticity:self.elasticity];
+    UIViewController *paneViewController = paneTransition.paneViewController;
+    if (!paneTransition.prepared && [paneViewController respondsToSelector:@selector(cancelPaneTransitionPreparationInDynamicsDrawerViewController:)]) {
+        [(id <MSDynamicsDrawerPaneTransitionPreparing>)paneViewController cancelPaneTransitionPreparationInDynamicsDrawerViewController:self];
+    }
 }
 
-- (void)addDynamicsBehaviorsToCreatePaneState:(MSDynamicsDrawerPaneState)paneState pushMagnitude:(CGFloat)pushMagnitude pushAngle:(CGFloat)pushAngle pushElasticity:(CGFloat)elasticity
+- (void)continuePaneTransition:(MSDynamicsDrawerPaneTransition *)paneTransition
 {
-    if (self.currentDrawerDirection == MSDynamicsDrawerDirectionNone) {
+    // Hold until the pane has slid off and the new pane view controller is prepared
+    if ((self.paneTransition != paneTransition) || paneTransition.replaced || !paneTransition.slidOff || !paneTransition.prepared) {
         return;
     }
-    
-    [self setPaneViewControllerViewUserInteractionEnabled:(paneState == MSDynamicsDrawerPaneStateClosed)];
-    
-    [self.paneBoundaryCollisionBehavior removeAllBoundaries];
-    [self.paneBoundaryCollisionBehavior addBoundaryWithIdentifier:MSDynamicsDrawerBoundaryIdentifier forPath:[self boundaryPathForState:paneState direction:self.currentDrawerDirection]];
-    [self.dynamicAnimator addBehavior:self.paneBoundaryCollisionBehavior];
-    
-    self.paneGravityBehavior.magnitude = [self gravityMagnitude];
-    self.paneGravityBehavior.angle = [self gravityAngleForState:paneState direction:self.currentDrawerDirection];
-    [self.dynamicAnimator addBehavior:self.paneGravityBehavior];
-    
-    if (elasticity != 0.0) {
-        self.paneElasticityBehavior.elasticity = elasticity;
-        [self.dynamicAnimator addBehavior:self.paneElasticityBehavior];
-    }
-    
-    if (pushMagnitude != 0.0) {
-        self.panePushBehavior.angle = pushAngle;
-        self.panePushBehavior.magnitude = pushMagnitude;
-        self.panePushBehavior.active = YES;
-        [self.dynamicAnimator addBehavior:self.panePushBehavior];
+    paneTransition.replaced = YES;
+    UIViewController *paneViewController = paneTransition.paneViewController;
+    // If the transition was retargeted back to the visible pane view controller, it reappears rather than being replaced. Its disappearance began as the pane slid off, so it's ended before the reappearance begins to keep the appearance callbacks balanced.
+    if (paneViewController == self.paneViewController) {
+        [paneViewController endAppearanceTransition];
+        [paneViewController beginAppearanceTransition:YES animated:YES];
+    } else {
+        [paneViewController willMoveToParentViewController:self];
+        [self.paneViewController.view removeFromSuperview];
+        [self.paneViewController removeFromParentViewController];
+        [self.paneViewController didMoveToParentViewController:nil];
+        [self.paneViewController endAppearanceTransition];
+        [self addChildViewController:paneViewController];
+        paneViewController.view.frame = self.paneView.bounds;
+        [paneViewController beginAppearanceTransition:YES animated:YES];
+        [self.paneView addSubview:paneViewController.view];
+        self->_paneViewController = paneViewController;
+        // Lay out the new pane view before closing, so that its first layout doesn't land in the first frames of the close
+        [paneViewController.view layoutIfNeeded];
+        [self setNeedsStatusBarAppearanceUpdate];
     }
-    
-    self.potentialPaneState = paneState;
-    
-    if ([self.delegate respondsToSelector:@selector(dynamicsDrawerViewController:mayUpdateToPaneState:forDirection:)]) {
-        [self.delegate dynamicsDrawerViewController:self mayUpdateToPaneState:paneState forDirection:self.currentDrawerDirection];
+    __weak typeof(self) weakSelf = self;
+    [self setPaneState:MSDynamicsDrawerPaneStateClosed animated:YES allowUserInterruption:YES completion:^{
+        [weakSelf finishPaneTransition:paneTransition];
+    }];
+}
+
+- (void)finishPaneTransition:(MSDynamicsDrawerPaneTransition *)paneTransition
+{
+    if (!paneTransition || (self.paneTransition != paneTransition) || !paneTransition.replaced) {
+        return;
     }
+    self.paneTransition = nil;
+    [paneTransition.paneViewController didMoveToParentViewController:self];
+    [paneTransition.paneViewController endAppearanceTransition];
+    // The replaced pane view controller is no longer in use, so it can be evicted
+    [self trimCachedPaneViewControllersToCount:self.paneViewControllerCacheCapacity];
+    if (paneTransition.completion) paneTransition.completion();
 }
 
-- (UIBezierPath *)boundaryPathForState:(MSDynamicsDrawerPaneState)state direction:(MSDynamicsDrawerDirection)direction
+- (void)abandonPaneTransition
 {
-    NSAssert(MSDynamicsDrawerDirectionIsCardinal(direction), @"Boundary is undefined for a non-cardinal reveal direction");
-    CGRect boundary = CGRectZero;
-    boundary.origin = (CGPoint){-1.0, -1.0};
-    if (self.possibleDrawerDirection & MSDynamicsDrawerDirectionHorizontal) {
-        boundary.size.height = (CGRectGetHeight(self.paneView.frame) + 1.0);
-        switch (state) {
-            case MSDynamicsDrawerPaneStateClosed:
-                boundary.size.width = ((CGRectGetWidth(self.paneView.frame) * 2.0) + self.paneStateOpenWideEdgeOffset + 2.0);
-                break;
-            case MSDynamicsDrawerPaneStateOpen:
-                boundary.size.width = ((CGRectGetWidth(self.paneView.frame) + self.openStateRevealWidth) + 2.0);
-                break;
-            case MSDynamicsDrawerPaneStateOpenWide:
-                boundary.size.width = ((CGRectGetWidth(self.paneView.frame) * 2.0) + self.paneStateOpenWideEdgeOffset + 2.0);
-                break;
-        }
-    } else if (self.possibleDrawerDirection & MSDynamicsDrawerDirectionVertical) {
-        boundary.size.width = (CGRectGetWidth(self.paneView.frame) + 1.0);
-        switch (state) {
-            case MSDynamicsDrawerPaneStateClosed:
-                boundary.size.height = ((CGRectGetHeight(self.paneView.frame) * 2.0) + self.paneStateOpenWideEdgeOffset + 2.0);
-                break;
-            case MSDynamicsDrawerPaneStateOpen:
-                boundary.size.height = ((CGRectGetHeight(self.paneView.frame) + self.openStateRevealWidth) + 2.0);
-                break;
-            case MSDynamicsDrawerPaneStateOpenWide:
-                boundary.size.height = ((CGRectGetHeight(self.paneView.frame) * 2.0) + self.paneStateOpenWideEdgeOffset + 2.0);
-                break;
-        }
+    MSDynamicsDrawerPaneTransition *paneTransition = self.paneTransition;
+    if (!paneTransition) {
+        return;
     }
-    switch (direction) {
-        case MSDynamicsDrawerDirectionRight:
-            boundary.origin.x = ((CGRectGetWidth(self.paneView.frame) + 1.0) - boundary.size.width);
-            break;
-        case MSDynamicsDrawerDirectionBottom:
-            boundary.origin.y = ((CGRectGetHeight(self.paneView.frame) + 1.0) - boundary.size.height);
-            break;
-        case MSDynamicsDrawerDirectionNone:
-            boundary = CGRectZero;
-            break;
-        default:
-            break;
+    if (paneTransition.replaced) {
+        [self finishPaneTransition:paneTransition];
+        return;
     }
-    return [UIBezierPath bezierPathWithRect:boundary];
+    // The pane view controller was never replaced, so the visible one finishes disappearing and reappears before it's replaced without animation
+    [self cancelPreparationForPaneTransition:paneTransition];
+    self.paneTransition = nil;
+    [self.paneViewController endAppearanceTransition];
+    [self.paneViewController beginAppearanceTransition:YES animated:NO];
+    [self.paneViewController didMoveToParentViewController:self];
+    [self.paneViewController endAppearanceTransition];
 }
 
-- (CGFloat)gravityAngleForState:(MSDynamicsDrawerPaneState)state direction:(MSDynamicsDrawerDirection)direction
+#pragma mark Pane View Controller Cache
+
+- (void)setPaneViewControllerForKey:(id <NSCopying>)key builder:(UIViewController *(^)(void))builder animated:(BOOL)animated completion:(void (^)(void))completion
 {
-    NSAssert(MSDynamicsDrawerDirectionIsCardinal(direction), @"Indeterminate gravity angle for non-cardinal reveal direction");
-    switch (direction) {
-        case MSDynamicsDrawerDirectionTop:
-            return (CGFloat) ((state != MSDynamicsDrawerPaneStateClosed) ? M_PI_2 : (3.0 * M_PI_2));
-        case MSDynamicsDrawerDirectionLeft:
-            return (CGFloat) ((state != MSDynamicsDrawerPaneStateClosed) ? 0.0 : M_PI);
-        case MSDynamicsDrawerDirectionBottom:
-            return (CGFloat) ((state != MSDynamicsDrawerPaneStateClosed) ? (3.0 * M_PI_2) : M_PI_2);
-        case MSDynamicsDrawerDirectionRight:
-            return (CGFloat) ((state != MSDynamicsDrawerPaneStateClosed) ? M_PI : 0.0);
-        default:
-            return 0.0;
+    NSParameterAssert(key);
+    NSParameterAssert(builder);
+    UIViewController *paneViewController = self.cachedPaneViewControllers[key];
+    if (!paneViewController) {
+        paneViewController = builder();
+        NSAssert(paneViewController, @"The builder must return a pane view controller");
+        self.cachedPaneViewControllers[key] = paneViewController;
+    } else {
+        [self.cachedPaneViewControllerKeys removeObject:key];
     }
+    [self.cachedPaneViewControllerKeys insertObject:key atIndex:0];
+    [self setPaneViewController:paneViewController animated:animated completion:completion];
+    [self trimCachedPaneViewControllersToCount:self.paneViewControllerCacheCapacity];
 }
 
-#pragma mark Closed Fraction
+- (UIViewController *)cachedPaneViewControllerForKey:(id <NSCopying>)key
+{
+    return self.cachedPaneViewControllers[key];
+}
 
-- (CGFloat)paneViewClosedFraction
+- (void)removeCachedPaneViewControllerForKey:(id <NSCopying>)key
 {
-    CGFloat fraction = 0;
-    switch (self.currentDrawerDirection) {
-        case MSDynamicsDrawerDirectionTop:
-            fraction = ((self.openStateRevealWidth - self.paneView.frame.origin.y) / self.openStateRevealWidth);
-            break;
-        case MSDynamicsDrawerDirectionLeft:
-            fraction = ((self.openStateRevealWidth - self.paneView.frame.origin.x) / self.openStateRevealWidth);
-            break;
-        case MSDynamicsDrawerDirectionBottom:
-            fraction = (1.0 - (fabs(self.paneView.frame.origin.y) / self.openStateRevealWidth));
-            break;
-        case MSDynamicsDrawerDirectionRight:
-            fraction = (1.0 - (fabs(self.paneView.frame.origin.x) / self.openStateRevealWidth));
-            break;
-        case MSDynamicsDrawerDirectionNone:
-            fraction = 1.0; // If we have no direction, we want 1.0 since the pane is closed when it has no direction
-            break;
-        default:
-            break;
+    UIViewController *paneViewController = self.cachedPaneViewControllers[key];
+    if (!paneViewController) {
+        return;
+    }
+    [self.cachedPaneViewControllers removeObjectForKey:key];
+    [self.cachedPaneViewControllerKeys removeObject:key];
+    if (![self paneViewControllerIsInUse:paneViewController]) {
+        [self evictCachedPaneViewController:paneViewController];
     }
-    // Clip to 0.0 < fraction < 1.0
-    fraction = (fraction < 0.0) ? 0.0 : fraction;
-    fraction = (fraction > 1.0) ? 1.0 : fraction;
-    return fraction;
 }
 
-#pragma mark Stylers
+- (void)setPaneViewControllerCacheCapacity:(NSUInteger)paneViewControllerCacheCapacity
+{
+    _paneViewControllerCacheCapacity = paneViewControllerCacheCapacity;
+    [self trimCachedPaneViewControllersToCount:paneViewControllerCacheCapacity];
+}
 
-- (void)addStyler:(id <MSDynamicsDrawerStyler>)styler forDirection:(MSDynamicsDrawerDirection)direction
+- (void)trimCachedPaneViewControllersToCount:(NSUInteger)count
 {
-    MSDynamicsDrawerDirectionActionForMaskedValues(direction, ^(MSDynamicsDrawerDirection maskedValue){
-        // Lazy creation of stylers sets
-        if (!self.stylers[@(maskedValue)]) {
-            self.stylers[@(maskedValue)] = [NSMutableSet new];
-        }
-        NSMutableSet *stylersSet = self.stylers[@(maskedValue)];
-        [stylersSet addObject:styler];
-        BOOL existsInCurrentStylers = NO;
-        for (NSSet *currentStylersSet in [self.stylers allValues]) {
-            if ([currentStylersSet containsObject:styler]) {
-                existsInCurrentStylers = YES;
-            }
-        }
-        if (existsInCurrentStylers) {
-            if ([styler respondsToSelector:@selector(stylerWasAddedToDynamicsDrawerViewController:forDirection:)]) {
-                [styler stylerWasAddedToDynamicsDrawerViewController:self forDirection:direction];
-            }
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wdeprecated-declarations"
-            if ([styler respondsToSelector:@selector(stylerWasAddedToDynamicsDrawerViewController:)]) {
-                [styler stylerWasAddedToDynamicsDrawerViewController:self];
-            }
-#pragma clang diagnostic pop
+    // Evict from the least recently shown, skipping the pane view controllers that are visible or being transitioned to
+    for (NSInteger index = ((NSInteger)self.cachedPaneViewControllerKeys.count - 1); (index >= 0) && (self.cachedPaneViewControllerKeys.count > count); index--) {
+        id key = self.cachedPaneViewControllerKeys[index];
+        UIViewController *paneViewController = self.cachedPaneViewControllers[key];
+        if ([self paneViewControllerIsInUse:paneViewController]) {
+            continue;
         }
-    });
+        [self.cachedPaneViewControllers removeObjectForKey:key];
+        [self.cachedPaneViewControllerKeys removeObjectAtIndex:index];
+        [self evictCachedPaneViewController:paneViewController];
+    }
 }
 
-- (void)removeStyler:(id <MSDynamicsDrawerStyler>)styler forDirection:(MSDynamicsDrawerDirection)direction
+- (BOOL)paneViewControllerIsInUse:(UIViewController *)paneViewController
 {
-    MSDynamicsDrawerDirectionActionForMaskedValues(direction, ^(MSDynamicsDrawerDirection maskedValue){
-        NSMutableSet *stylersSet = self.stylers[@(maskedValue)];
-        [stylersSet removeObject:styler];
-        NSInteger containedCount = 0;
-        for (NSSet *currentStylersSet in [self.stylers allValues]) {
-            if ([currentStylersSet containsObject:styler]) {
-                containedCount++;
-            }
-        }
-        if (containedCount == 0) {
-            if ([styler respondsToSelector:@selector(stylerWasRemovedFromDynamicsDrawerViewController:forDirection:)]) {
-                [styler stylerWasRemovedFromDynamicsDrawerViewController:self forDirection:direction];
-            }
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wdeprecated-declarations"
-            if ([styler respondsToSelector:@selector(stylerWasRemovedFromDynamicsDrawerViewController:)]) {
-                [styler stylerWasRemovedFromDynamicsDrawerViewController:self];
-            }
-#pragma clang diagnostic pop
-        }
-    });
+    return ((paneViewController == self.paneViewController) || (paneViewController == self.paneTransition.paneViewController));
 }
 
-- (void)addStylersFromArray:(NSArray *)stylers forDirection:(MSDynamicsDrawerDirection)direction
+- (void)evictCachedPaneViewController:(UIViewController *)paneViewController
 {
-    for (id <MSDynamicsDrawerStyler> styler in stylers) {
-        [self addStyler:styler forDirection:direction];
+    if ([paneViewController respondsToSelector:@selector(paneViewControllerWasEvictedFromDynamicsDrawerViewController:)]) {
+        [(id <MSDynamicsDrawerCachedPaneViewController>)paneViewController paneViewControllerWasEvictedFromDynamicsDrawerViewController:self];
     }
 }
 
-- (void)updateStylers
+#pragma mark Memory Footprint
+
+- (NSDictionary *)memoryFootprintReport
 {
-    // Prevent weird animation issues on rotation
-    if (self.animatingRotation) {
+    NSUInteger drawerViewControllerCount = 0;
+    NSMutableSet *stylers = [NSMutableSet new];
+    for (NSUInteger index = 0; index < MSDynamicsDrawerCardinalDirectionCount; index++) {
+        drawerViewControllerCount += (_directionConfigurations[index].drawerViewController ? 1 : 0);
+        [stylers addObjectsFromArray:_directionConfigurations[index].stylers.array];
+    }
+    NSUInteger transitionSnapshotViewCount = ((self.paneSnapshotView ? 1 : 0) + (self.drawerSnapshotView ? 1 : 0));
+    NSMutableDictionary *report = [@{
+        @"drawerViewControllers" : @(drawerViewControllerCount),
+        @"keptAliveDrawerViewControllers" : @(self.keptAliveDrawerViewControllers.count),
+        @"cachedPaneViewControllers" : @(self.cachedPaneViewControllers.count),
+        @"stylers" : @(stylers.count),
+        @"transitionSnapshotViews" : @(transitionSnapshotViewCount),
+        @"displayLink" : @(self.displayLink ? 1 : 0)
+    } mutableCopy];
+    if ([self.paneMotionEngine respondsToSelector:@selector(memoryFootprintReport)]) {
+        report[@"paneMotionEngine"] = [self.paneMotionEngine memoryFootprintReport];
+    }
+    return [report copy];
+}
+
+#pragma mark Status Bar Alignment
+
+- (void)setShouldAlignStatusBarToPaneView:(BOOL)shouldAlignStatusBarToPaneView
+{
+    if (_shouldAlignStatusBarToPaneView == shouldAlignStatusBarToPaneView) {
         return;
     }
-    NSMutableSet *activeStylers = [NSMutableSet new];
-    if (MSDynamicsDrawerDirectionIsCardinal(self.currentDrawerDirection)) {
-        [activeStylers unionSet:self.stylers[@(self.currentDrawerDirection)]];
-    } else {
-        for (NSSet *stylers in [self.stylers allValues]) {
-            [activeStylers unionSet:stylers];
-        }
+    _shouldAlignStatusBarToPaneView = shouldAlignStatusBarToPaneView;
+    if (!shouldAlignStatusBarToPaneView) {
+        [self.statusBarAligner restoreStatusBarForDynamicsDrawerViewController:self];
     }
-    for (id <MSDynamicsDrawerStyler> styler in activeStylers) {
-        [styler dynamicsDrawerViewController:self didUpdatePaneClosedFraction:[self paneViewClosedFraction] forDirection:self.currentDrawerDirection];
+}
+
+- (void)setStatusBarAligner:(id <MSDynamicsDrawerStatusBarAligner>)statusBarAligner
+{
+    NSParameterAssert(statusBarAligner);
+    if (_statusBarAligner == statusBarAligner) {
+        return;
     }
+    [_statusBarAligner restoreStatusBarForDynamicsDrawerViewController:self];
+    _statusBarAligner = statusBarAligner;
 }
 
-- (NSArray *)stylersForDirection:(MSDynamicsDrawerDirection)direction
+- (BOOL)statusBarHiddenByAligner
 {
-    NSMutableSet *stlyerCollection = [NSMutableSet new];
-    MSDynamicsDrawerDirectionActionForMaskedValues(direction, ^(MSDynamicsDrawerDirection maskedValue){
-        [stlyerCollection unionSet:self.stylers[@(maskedValue)]];
-    });
-    return [stlyerCollection allObjects];
+    if (!self.shouldAlignStatusBarToPaneView || ![self.statusBarAligner respondsToSelector:@selector(statusBarHiddenForDynamicsDrawerViewController:)]) {
+        return NO;
+    }
+    return [self.statusBarAligner statusBarHiddenForDynamicsDrawerViewController:self];
 }
 
-#pragma mark Pane State
+#pragma mark Dynamics
 
-- (void)paneViewDidUpdateFrame
+- (void)setPaneMotionEngine:(id <MSDynamicsDrawerPaneMotionEngine>)paneMotionEngine
 {
-    if (self.shouldAlignStatusBarToPaneView) {
-        NSString *key = [[NSString alloc] initWithData:[NSData dataWithBytes:(unsigned char []){0x73, 0x74, 0x61, 0x74, 0x75, 0x73, 0x42, 0x61, 0x72} length:9] encoding:NSASCIIStringEncoding];
-        id object = [UIApplication sharedApplication];
-        UIView *statusBar;
-        if ([object respondsToSelector:NSSelectorFromString(key)]) {
-            statusBar = [object valueForKey:key];
-        }
-        statusBar.transform = CGAffineTransformMakeTranslation(self.paneView.frame.origin.x, self.paneView.frame.origin.y);
-    }
-    
-    CGPoint openWidePoint = [self paneViewOriginForPaneState:MSDynamicsDrawerPaneStateOpenWide];
-    CGRect paneFrame = self.paneView.frame;
-    CGFloat *openWideLocation = NULL;
-    CGFloat *paneLocation = NULL;
-    if (self.currentDrawerDirection & MSDynamicsDrawerDirectionHorizontal) {
-        openWideLocation = &openWidePoint.x;
-        paneLocation = &paneFrame.origin.x;
-    } else if (self.currentDrawerDirection & MSDynamicsDrawerDirectionVertical) {
-        openWideLocation = &openWidePoint.y;
-        paneLocation = &paneFrame.origin.y;
-    }
-    BOOL reachedOpenWideState = NO;
-    if (self.currentDrawerDirection & (MSDynamicsDrawerDirectionLeft | MSDynamicsDrawerDirectionTop)) {
-        if (paneLocation && (*paneLocation >= *openWideLocation)) {
-            reachedOpenWideState = YES;
-        }
-    } else if (self.currentDrawerDirection & (MSDynamicsDrawerDirectionRight | MSDynamicsDrawerDirectionBottom)) {
-        if (paneLocation && (*paneLocation <= *openWideLocation)) {
-            reachedOpenWideState = YES;
-        }
-    }
-    if (reachedOpenWideState && (self.potentialPaneState == MSDynamicsDrawerPaneStateOpenWide)) {
-        [self.dynamicAnimator removeAllBehaviors];
+    NSParameterAssert(paneMotionEngine);
+    if (_paneMotionEngine == paneMotionEngine) {
+        return;
     }
-    
-    [self updateStylers];
+    // Stop the existing engine before detaching it, so that the pane still comes to rest in a valid state
+    [_paneMotionEngine stopMotion];
+    _paneMotionEngine.delegate = nil;
+    _paneMotionEngine = paneMotionEngine;
+    _paneMotionEngine.delegate = self;
 }
 
-- (void)setPaneState:(MSDynamicsDrawerPaneState)paneState
+- (BOOL)paneMotionEngineIsSteppedByDisplayLink
 {
-    [self setPaneState:paneState animated:NO allowUserInterruption:NO completion:nil];
+    return [self.paneMotionEngine respondsToSelector:@selector(stepMotionToTimestamp:)];
 }
 
-- (void)setPaneState:(MSDynamicsDrawerPaneState)paneState inDirection:(MSDynamicsDrawerDirection)direction
+- (void)addDynamicsBehaviorsToCreatePaneState:(MSDynamicsDrawerPaneState)paneState;
 {
-    [self setPaneState:paneState inDirection:direction animated:NO allowUserInterruption:NO completion:nil];
+    [self addDynamicsBehaviorsToCreatePaneState:paneState pushMagnitude:0.0 pushAngle:0.0 pushElasticity:self.elasticity];
 }
 
-- (void)setPaneState:(MSDynamicsDrawerPaneState)paneState animated:(BOOL)animated allowUserInterruption:(BOOL)allowUserInterruption completion:(void (^)(void))completion
+- (void)addDynamicsBehaviorsToCreatePaneState:(MSDynamicsDrawerPaneState)paneState pushMagnitude:(CGFloat)pushMagnitude pushAngle:(CGFloat)pushAngle pushElasticity:(CGFloat)elasticity
 {
-    // If the drawer is getting opened and there's more than one possible direction enforce that the directional eqivalent is used
-    MSDynamicsDrawerDirection direction;
-    if ((paneState != MSDynamicsDrawerPaneStateClosed) && (self.currentDrawerDirection == MSDynamicsDrawerDirectionNone)) {
-        NSAssert(MSDynamicsDrawerDirectionIsCardinal(self.possibleDrawerDirection), @"Unable to set the pane to an open state with multiple possible drawer directions, as the drawer direction to open in is indeterminate. Use `setPaneState:inDirection:animated:allowUserInterruption:completion:` instead.");
-        direction = self.possibleDrawerDirection;
-    } else {
-        direction = self.currentDrawerDirection;
-    }
-    [self setPaneState:paneState inDirection:direction animated:animated allowUserInterruption:allowUserInterruption completion:completion];
+    [self addDynamicsBehaviorsToCreatePaneState:paneState pushMagnitude:pushMagnitude pushAngle:pushAngle pushElasticity:elasticity programmatic:NO];
 }
 
-- (void)setPaneState:(MSDynamicsDrawerPaneState)paneState inDirection:(MSDynamicsDrawerDirection)direction animated:(BOOL)animated allowUserInterruption:(BOOL)allowUserInterruption completion:(void (^)(void))completion
+- (BOOL)paneMotionCoalescesWithPaneState:(MSDynamicsDrawerPaneState)paneState pushMagnitude:(CGFloat)pushMagnitude
 {
-    NSAssert(((self.possibleDrawerDirection & direction) == direction), @"Unable to bounce open with impossible or multiple directions");
-    if ((paneState != MSDynamicsDrawerPaneStateClosed)) {
-        self.currentDrawerDirection = direction;
-    }
-    if (animated) {
-        [self addDynamicsBehaviorsToCreatePaneState:paneState];
-        if (!allowUserInterruption) [self setViewUserInteractionEnabled:NO];
-        __weak typeof(self) weakSelf = self;
-        self.dynamicAnimatorCompletion = ^{
-            if (!allowUserInterruption) [weakSelf setViewUserInteractionEnabled:YES];
-            if (completion) completion();
-        };
-    } else {
-        [self _setPaneState:paneState];
-        if (completion) completion();
+    // A motion towards the target that the pane is already moving to would only restart it, so rapid repeated state changes are coalesced into the existing motion
+    switch ([self paneMotionPhase]) {
+        case MSDynamicsDrawerPaneMotionPhaseEngine:
+        case MSDynamicsDrawerPaneMotionPhaseCoreAnimation:
+            return ((pushMagnitude == 0.0) && (paneState == self.potentialPaneState) && (self.currentDrawerDirection == self.potentialDrawerDirection));
+        case MSDynamicsDrawerPaneMotionPhaseResting:
+        case MSDynamicsDrawerPaneMotionPhaseDragging:
+            return NO;
     }
+    return NO;
 }
 
-- (void)_setPaneState:(MSDynamicsDrawerPaneState)paneState
+- (void)addDynamicsBehaviorsToCreatePaneState:(MSDynamicsDrawerPaneState)paneState pushMagnitude:(CGFloat)pushMagnitude pushAngle:(CGFloat)pushAngle pushElasticity:(CGFloat)elasticity programmatic:(BOOL)programmatic
 {
-    MSDynamicsDrawerDirection previousDirection = self.currentDrawerDirection;
+    if (self.currentDrawerDirection == MSDynamicsDrawerDirectionNone) {
+        return;
+    }
     
-    // When we've actually upated to a pane state, invalidate the `potentialPaneState`
-    self.potentialPaneState = NSIntegerMax;
+    MSDynamicsDrawerTransitionMetrics *transitionMetrics = self.transitionMetrics;
+    CFTimeInterval startTimestamp = (transitionMetrics ? CACurrentMediaTime() : 0.0);
+    if (transitionMetrics.emitsSignposts) {
+        if (@available(iOS 12.0, *)) {
+            os_signpost_interval_begin(MSDynamicsDrawerTransitionsLog(), OS_SIGNPOST_ID_EXCLUSIVE, "Add Dynamics Behaviors");
+        }
+    }
     
-    if (_paneState != paneState) {
-        [self willChangeValueForKey:NSStringFromSelector(@selector(paneState))];
-        _paneState = paneState;
-        if ([self.delegate respondsToSelector:@selector(dynamicsDrawerViewController:didUpdateToPaneState:forDirection:)]) {
-            if (self.paneState & (MSDynamicsDrawerPaneStateOpen | MSDynamicsDrawerPaneStateOpenWide)) {
-                [self.delegate dynamicsDrawerViewController:self didUpdateToPaneState:paneState forDirection:self.currentDrawerDirection];
-            } else {
-                [self.delegate dynamicsDrawerViewController:self didUpdateToPaneState:paneState forDirection:previousDirection];
+    CGPoint paneViewVelocity = CGPointZero;
+    if ([self paneMotionCoalescesWithPaneState:paneState pushMagnitude:pushMagnitude]) {
+        if (transitionMetrics) {
+            transitionMetrics.dynamicsBehaviorsDuration += (CACurrentMediaTime() - startTimestamp);
+        }
+        if (transitionMetrics.emitsSignposts) {
+            if (@available(iOS 12.0, *)) {
+                os_signpost_interval_end(MSDynamicsDrawerTransitionsLog(), OS_SIGNPOST_ID_EXCLUSIVE, "Add Dynamics Behaviors");
             }
         }
-        [self didChangeValueForKey:NSStringFromSelector(@selector(paneState))];
+        return;
     }
     
-    // Update pane frame regardless of if it's changed
-    self.paneView.frame = (CGRect){[self paneViewOriginForPaneState:paneState], self.paneView.frame.size};
+    // A new motion begins from wherever an in-flight Core Animation transition is presented, at the velocity it was presented with. The motion engine carries over its own velocity when retargeted.
+    if ([self paneMotionPhase] == MSDynamicsDrawerPaneMotionPhaseCoreAnimation) {
+        paneViewVelocity = [self cancelCoreAnimationTransition];
+    }
     
-    // Update `currentDirection` to `MSDynamicsDrawerDirectionNone` if the `paneState` is `MSDynamicsDrawerPaneStateClosed`
-    if (paneState == MSDynamicsDrawerPaneStateClosed) {
-        self.currentDrawerDirection = MSDynamicsDrawerDirectionNone;
+    [self setPaneViewControllerViewUserInteractionEnabled:(paneState == MSDynamicsDrawerPaneStateClosed)];
+    
+    [self beginTransitionSnapshotsIfNeeded];
+    
+    MSDynamicsDrawerPaneMotion motion;
+    motion.paneState = paneState;
+    motion.direction = self.currentDrawerDirection;
+    motion.targetPaneViewOrigin = [self paneViewOriginForPaneState:paneState];
+    motion.boundary = [self boundaryForState:paneState direction:self.currentDrawerDirection];
+    motion.gravityAngle = [self gravityAngleForState:paneState direction:self.currentDrawerDirection];
+    motion.gravityMagnitude = self.gravityMagnitude;
+    motion.pushAngle = pushAngle;
+    motion.pushMagnitude = pushMagnitude;
+    motion.elasticity = elasticity;
+    motion.initialVelocity = paneViewVelocity;
+    if (!(programmatic && [self beginCoreAnimationTransitionWithMotion:motion])) {
+        [self.paneMotionEngine beginMotion:motion ofPaneView:self.paneView inReferenceView:self.view];
+        if ([self paneMotionEngineIsSteppedByDisplayLink]) {
+            self.displayLink.paused = NO;
+        }
     }
-}
-
-- (CGPoint)paneViewOriginForPaneState:(MSDynamicsDrawerPaneState)paneState
-{
-    CGPoint paneViewOrigin = CGPointZero;
-    switch (paneState) {
-        case MSDynamicsDrawerPaneStateOpen:
-            switch (self.currentDrawerDirection) {
-                case MSDynamicsDrawerDirectionTop:
-                    paneViewOrigin.y = self.openStateRevealWidth;
-                    break;
-                case MSDynamicsDrawerDirectionLeft:
-                    paneViewOrigin.x = self.openStateRevealWidth;
-                    break;
-                case MSDynamicsDrawerDirectionBottom:
-                    paneViewOrigin.y = -self.openStateRevealWidth;
-                    break;
-                case MSDynamicsDrawerDirectionRight:
-                    paneViewOrigin.x = -self.openStateRevealWidth;
-                    break;
-                default:
-                    break;
-            }
-            break;
-        case MSDynamicsDrawerPaneStateOpenWide:
-            switch (self.currentDrawerDirection) {
-                case MSDynamicsDrawerDirectionLeft:
-                    paneViewOrigin.x = (CGRectGetWidth(self.paneView.frame) + self.paneStateOpenWideEdgeOffset);
-                    break;
-                case MSDynamicsDrawerDirectionTop:
-                    paneViewOrigin.y = (CGRectGetHeight(self.paneView.frame) + self.paneStateOpenWideEdgeOffset);
-                    break;
-                case MSDynamicsDrawerDirectionBottom:
-                    paneViewOrigin.y = (CGRectGetHeight(self.paneView.frame) + self.paneStateOpenWideEdgeOffset);
-                    break;
-                case MSDynamicsDrawerDirectionRight:
-                    paneViewOrigin.x = -(CGRectGetWidth(self.paneView.frame) + self.paneStateOpenWideEdgeOffset);
-                    break;
-                default:
-                    break;
-            }
-            break;
-        default:
-            break;
+    
+    self.potentialPaneState = paneState;
+    self.potentialDrawerDirection = self.currentDrawerDirection;
+    
+    if ([self.delegate respondsToSelector:@selector(dynamicsDrawerViewController:mayUpdateToPaneState:forDirection:)]) {
+        [self.delegate dynamicsDrawerViewController:self mayUpdateToPaneState:paneState forDirection:self.currentDrawerDirection];
+    }
+    
+    if (transitionMetrics) {
+        transitionMetrics.dynamicsBehaviorsDuration += (CACurrentMediaTime() - startTimestamp);
+    }
+    if (transitionMetrics.emitsSignposts) {
+        if (@available(iOS 12.0, *)) {
+            os_signpost_interval_end(MSDynamicsDrawerTransitionsLog(), OS_SIGNPOST_ID_EXCLUSIVE, "Add Dynamics Behaviors");
+        }
     }
-    return paneViewOrigin;
 }
 
-- (BOOL)paneViewIsPositionedInValidState:(inout MSDynamicsDrawerPaneState *)paneState
+- (CGRect)boundaryForState:(MSDynamicsDrawerPaneState)state direction:(MSDynamicsDrawerDirection)direction
 {
-    BOOL validState = NO;
-    for (MSDynamicsDrawerPaneState currentPaneState = MSDynamicsDrawerPaneStateClosed; currentPaneState <= MSDynamicsDrawerPaneStateOpenWide; currentPaneState++) {
-        CGPoint paneStatePaneViewOrigin = [self paneViewOriginForPaneState:currentPaneState];
-        CGPoint currentPaneViewOrigin = (CGPoint){roundf(self.paneView.frame.origin.x), roundf(self.paneView.frame.origin.y)};
-        CGFloat epsilon = 2.0;
-        if ((fabs(paneStatePaneViewOrigin.x - currentPaneViewOrigin.x) < epsilon) && (fabs(paneStatePaneViewOrigin.y - currentPaneViewOrigin.y) < epsilon)) {
-            validState = YES;
-            *paneState = currentPaneState;
-            break;
-        }
-    }
-    return validState;
+    NSAssert(MSDynamicsDrawerDirectionIsCardinal(direction), @"Boundary is undefined for a non-cardinal reveal direction");
+    return MSDynamicsDrawerGeometryBoundaryForPaneState([self geometryForDirection:direction], state);
 }
 
-- (MSDynamicsDrawerPaneState)nearestPaneState
+- (CGFloat)gravityAngleForState:(MSDynamicsDrawerPaneState)state direction:(MSDynamicsDrawerDirection)direction
 {
-    CGFloat minDistance = CGFLOAT_MAX;
-    MSDynamicsDrawerPaneState minPaneState = NSIntegerMax;
-    for (MSDynamicsDrawerPaneState currentPaneState = MSDynamicsDrawerPaneStateClosed; currentPaneState <= MSDynamicsDrawerPaneStateOpenWide; currentPaneState++) {
-        CGPoint paneStatePaneViewOrigin = [self paneViewOriginForPaneState:currentPaneState];
-        CGPoint currentPaneViewOrigin = (CGPoint){roundf(self.paneView.frame.origin.x), roundf(self.paneView.frame.origin.y)};
-        CGFloat distance = sqrt(pow((paneStatePaneViewOrigin.x - currentPaneViewOrigin.x), 2) + pow((paneStatePaneViewOrigin.y - currentPaneViewOrigin.y), 2));
-        if (distance < minDistance) {
-            minDistance = distance;
-            minPaneState = currentPaneState;
-        }
+    NSAssert(MSDynamicsDrawerDirectionIsCardinal(direction), @"Indeterminate gravity angle for non-cardinal reveal direction");
+    if (!MSDynamicsDrawerDirectionIsCardinal(direction)) {
+        return 0.0;
     }
-    return minPaneState;
+    return MSDynamicsDrawerGravityAngles[MSDynamicsDrawerCardinalDirectionIndex(direction)][(state != MSDynamicsDrawerPaneStateClosed)];
 }
 
-#pragma mark Current Reveal Direction
+#pragma mark Core Animation Transitions
 
-- (void)setCurrentDrawerDirection:(MSDynamicsDrawerDirection)currentDrawerDirection
+- (BOOL)beginCoreAnimationTransitionWithMotion:(MSDynamicsDrawerPaneMotion)motion
 {
-    NSAssert(MSDynamicsDrawerDirectionIsNonMasked(currentDrawerDirection), @"Only accepts non-masked directions as current reveal direction");
-    NSAssert(!((currentDrawerDirection == MSDynamicsDrawerDirectionNone) && (self.paneState != MSDynamicsDrawerPaneStateClosed)), @"Can't set direction to none while we have a non-closed pane state");
-    
-    if (_currentDrawerDirection == currentDrawerDirection) return;
-    
-    // Inform stylers about the transition between directions when directly transitioning
-    if (_currentDrawerDirection != MSDynamicsDrawerDirectionNone) {
-        NSMutableSet *allStylers = [NSMutableSet new];
-        for (NSSet *stylers in [self.stylers allValues]) {
-            [allStylers unionSet:stylers];
-        }
-        for (id <MSDynamicsDrawerStyler> styler in allStylers) {
-            [styler dynamicsDrawerViewController:self didUpdatePaneClosedFraction:1.0 forDirection:MSDynamicsDrawerDirectionNone];
+    if (!self.coreAnimationTransitionsEnabled || self.paneMotionEngine.isRunning || ![self.paneMotionEngine respondsToSelector:@selector(paneViewOriginsForMotion:ofPaneView:sampleInterval:)]) {
+        return NO;
+    }
+    // Only compositing stylers can be sampled along the trajectory
+    MSDynamicsDrawerStylerTable *stylerTable = _directionConfigurations[MSDynamicsDrawerCardinalDirectionIndex(motion.direction)].stylerTable;
+    for (NSUInteger index = 0; index < stylerTable->_count; index++) {
+        if (stylerTable->_entries[index].dispatch != MSDynamicsDrawerStylerDispatchComposition) {
+            return NO;
         }
     }
+    NSArray *paneViewOrigins = [self.paneMotionEngine paneViewOriginsForMotion:motion ofPaneView:self.paneView sampleInterval:MSCoreAnimationTransitionSampleInterval];
+    if (paneViewOrigins.count < 2) {
+        return NO;
+    }
     
-    _currentDrawerDirection = currentDrawerDirection;
+    // Sample the pane position and the composited drawer styling along the trajectory
+    CGRect paneViewFrame = self.paneView.frame;
+    CGAffineTransform drawerViewTransform = self.drawerView.transform;
+    NSMutableArray *paneViewPositions = [NSMutableArray arrayWithCapacity:paneViewOrigins.count];
+    NSMutableArray *drawerViewTransforms = [NSMutableArray arrayWithCapacity:paneViewOrigins.count];
+    NSMutableArray *drawerViewOpacities = [NSMutableArray arrayWithCapacity:paneViewOrigins.count];
+    BOOL transformContributed = NO;
+    BOOL alphaContributed = NO;
+    MSDynamicsDrawerGeometry geometry = [self geometryForDirection:motion.direction];
+    MSDynamicsDrawerStylerComposition *stylerComposition = self.stylerComposition;
+    for (NSUInteger sampleIndex = 0; sampleIndex < paneViewOrigins.count; sampleIndex++) {
+        paneViewFrame.origin = [paneViewOrigins[sampleIndex] CGPointValue];
+        [paneViewPositions addObject:[NSValue valueWithCGPoint:(CGPoint){CGRectGetMidX(paneViewFrame), CGRectGetMidY(paneViewFrame)}]];
+        // The pane is only at rest in the final sample, as the transition is in flight for all of the others
+        BOOL paneViewResting = (sampleIndex == (paneViewOrigins.count - 1));
+        MSDynamicsDrawerLayout layout = MSDynamicsDrawerGeometryLayout(geometry, paneViewFrame.origin, paneViewResting);
+        CALayer *previousPaneShadowLayer = stylerComposition.paneShadowLayer;
+        BOOL previousPaneShadowLayerContributed = stylerComposition.hasPaneShadowLayerContributions;
+        [stylerComposition reset];
+        for (NSUInteger index = 0; index < stylerTable->_count; index++) {
+            MSDynamicsDrawerStylerEntryUpdate(&stylerTable->_entries[index], self, layout, stylerComposition);
+        }
+        // Frame changes can't be reproduced by the render server, as they require layout
+        if (stylerComposition.hasDrawerViewControllerViewFrameContributions) {
+            [stylerComposition reset];
+            return NO;
+        }
+        // The shadow layer moves with the pane view, so it's attached once for the whole transition. Swapping it mid-transition can't be reproduced.
+        if ((sampleIndex != 0) && ((stylerComposition.hasPaneShadowLayerContributions != previousPaneShadowLayerContributed) || (stylerComposition.paneShadowLayer != previousPaneShadowLayer))) {
+            [stylerComposition reset];
+            return NO;
+        }
+        transformContributed |= stylerComposition.hasDrawerViewTransformContributions;
+        alphaContributed |= stylerComposition.hasDrawerViewAlphaContributions;
+        [drawerViewTransforms addObject:[NSValue valueWithCATransform3D:CATransform3DMakeAffineTransform([stylerComposition drawerViewTransformByCompositingTransform:drawerViewTransform])]];
+        [drawerViewOpacities addObject:@([stylerComposition drawerViewAlpha])];
+    }
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    [stylerComposition applyPaneShadowLayerToPaneView:self.paneView];
+    [CATransaction commit];
+    [stylerComposition reset];
     
-    self.drawerViewController = self.drawerViewControllers[@(currentDrawerDirection)];
+    CFTimeInterval duration = ((paneViewOrigins.count - 1) * MSCoreAnimationTransitionSampleInterval);
+    CAKeyframeAnimation *paneAnimation = [CAKeyframeAnimation animationWithKeyPath:@"position"];
+    paneAnimation.values = paneViewPositions;
+    paneAnimation.duration = duration;
+    paneAnimation.delegate = self;
+    [self applyCoreAnimationTransitionTimingToAnimation:paneAnimation];
+    self.coreAnimationTransitionAnimation = paneAnimation;
     
-    // Disable pane view interaction when not closed
-    [self setPaneViewControllerViewUserInteractionEnabled:(currentDrawerDirection == MSDynamicsDrawerDirectionNone)];
+    // The views keep their model state at the start of the trajectory until the animations finish, so that the model never leads what is presented. The final frame is committed in `animationDidStop:finished:`.
+    paneViewFrame.origin = [[paneViewOrigins lastObject] CGPointValue];
+    self.coreAnimationTransitionPaneViewFrame = paneViewFrame;
     
-    [self updateStylers];
+    [self.paneView.layer addAnimation:paneAnimation forKey:MSCoreAnimationTransitionPaneAnimationKey];
+    if (transformContributed) {
+        CAKeyframeAnimation *drawerTransformAnimation = [CAKeyframeAnimation animationWithKeyPath:@"transform"];
+        drawerTransformAnimation.values = drawerViewTransforms;
+        drawerTransformAnimation.duration = duration;
+        [self applyCoreAnimationTransitionTimingToAnimation:drawerTransformAnimation];
+        [self.drawerView.layer addAnimation:drawerTransformAnimation forKey:MSCoreAnimationTransitionDrawerTransformAnimationKey];
+    }
+    if (alphaContributed) {
+        CAKeyframeAnimation *drawerOpacityAnimation = [CAKeyframeAnimation animationWithKeyPath:@"opacity"];
+        drawerOpacityAnimation.values = drawerViewOpacities;
+        drawerOpacityAnimation.duration = duration;
+        [self applyCoreAnimationTransitionTimingToAnimation:drawerOpacityAnimation];
+        [self.drawerView.layer addAnimation:drawerOpacityAnimation forKey:MSCoreAnimationTransitionDrawerOpacityAnimationKey];
+    }
+    return YES;
 }
 
-#pragma mark Possible Reveal Direction
+- (CGPoint)cancelCoreAnimationTransition
+{
+    if (!self.coreAnimationTransitionAnimation) {
+        return CGPointZero;
+    }
+    // The trajectory is sampled at a fixed interval, so the presented velocity is the difference between the samples surrounding the presented time
+    CGPoint presentedVelocity = CGPointZero;
+    CAKeyframeAnimation *paneAnimation = (CAKeyframeAnimation *)[self.paneView.layer animationForKey:MSCoreAnimationTransitionPaneAnimationKey];
+    if ([paneAnimation isKindOfClass:[CAKeyframeAnimation class]] && (paneAnimation.values.count >= 2)) {
+        CFTimeInterval elapsed = ([self.paneView.layer convertTime:CACurrentMediaTime() fromLayer:nil] - paneAnimation.beginTime);
+        NSUInteger sampleIndex = (NSUInteger)MIN(MAX(floor(elapsed / MSCoreAnimationTransitionSampleInterval), 0.0), (paneAnimation.values.count - 2));
+        CGPoint position = [paneAnimation.values[sampleIndex] CGPointValue];
+        CGPoint nextPosition = [paneAnimation.values[(sampleIndex + 1)] CGPointValue];
+        presentedVelocity = (CGPoint){((nextPosition.x - position.x) / MSCoreAnimationTransitionSampleInterval), ((nextPosition.y - position.y) / MSCoreAnimationTransitionSampleInterval)};
+    }
+    self.coreAnimationTransitionAnimation = nil;
+    // Stop the pane where it is currently presented, and restyle the drawer for that position
+    CALayer *presentationLayer = [self.paneView.layer presentationLayer];
+    CGRect presentedPaneViewFrame = (presentationLayer ? presentationLayer.frame : self.paneView.frame);
+    [self removeCoreAnimationTransitionAnimations];
+    self.paneView.frame = presentedPaneViewFrame;
+    [self updatePaneViewIfNeeded];
+    return presentedVelocity;
+}
 
-- (void)setPossibleDrawerDirection:(MSDynamicsDrawerDirection)possibleDrawerDirection
+- (void)finishCoreAnimationTransition
 {
-    NSAssert(MSDynamicsDrawerDirectionIsValid(possibleDrawerDirection), @"Only accepts valid reveal directions as possible reveal direction");
-    _possibleDrawerDirection = possibleDrawerDirection;
+    self.coreAnimationTransitionAnimation = nil;
+    // Commit the final state that the animations have been presenting since they ended
+    [self removeCoreAnimationTransitionAnimations];
+    self.paneView.frame = self.coreAnimationTransitionPaneViewFrame;
+    [self updatePaneViewIfNeeded];
 }
 
-#pragma mark Reveal Width
+- (void)applyCoreAnimationTransitionTimingToAnimation:(CAAnimation *)animation
+{
+    // Hold the final keyframe until the model is updated to match it, so that the views don't snap back to their start
+    animation.removedOnCompletion = NO;
+    animation.fillMode = kCAFillModeForwards;
+    [self applyActiveFrameRateRangeToAnimation:animation];
+}
 
-- (CGFloat)revealWidthForDirection:(MSDynamicsDrawerDirection)direction;
+- (void)removeCoreAnimationTransitionAnimations
 {
-    NSAssert(MSDynamicsDrawerDirectionIsValid(direction), @"Only accepts cardinal directions when querying for reveal width");
-    NSNumber *revealWidth = self.revealWidth[@(direction)];
-    // Default values
-    if (![revealWidth boolValue]) {
-        if (direction & MSDynamicsDrawerDirectionHorizontal) {
-            revealWidth = @(MSDynamicsDrawerDefaultOpenStateRevealWidthHorizontal);
-        } else if (direction & MSDynamicsDrawerDirectionVertical) {
-            revealWidth = @(MSDynamicsDrawerDefaultOpenStateRevealWidthVertical);
-        } else {
-            revealWidth = @0;
-        }
-    }
-    return [revealWidth floatValue];
+    [self.paneView.layer removeAnimationForKey:MSCoreAnimationTransitionPaneAnimationKey];
+    [self.drawerView.layer removeAnimationForKey:MSCoreAnimationTransitionDrawerTransformAnimationKey];
+    [self.drawerView.layer removeAnimationForKey:MSCoreAnimationTransitionDrawerOpacityAnimationKey];
 }
 
-- (void)setRevealWidth:(CGFloat)revealWidth forDirection:(MSDynamicsDrawerDirection)direction
+#pragma mark Closed Fraction
+
+- (CGFloat)paneViewClosedFraction
 {
-    NSAssert((self.paneState == MSDynamicsDrawerPaneStateClosed), @"Only able to update the reveal width while the pane view is closed");
-    MSDynamicsDrawerDirectionActionForMaskedValues(direction, ^(MSDynamicsDrawerDirection maskedValue){
-        self.revealWidth[@(maskedValue)] = @(revealWidth);
-    });
+    return MSDynamicsDrawerGeometryPaneClosedFraction([self geometryForDirection:self.currentDrawerDirection], self.paneView.frame.origin);
 }
 
-- (CGFloat)openStateRevealWidth
+#pragma mark Layout
+
+- (MSDynamicsDrawerLayout)layoutForPaneViewFrame:(CGRect)paneViewFrame direction:(MSDynamicsDrawerDirection)direction
 {
-    return [self revealWidthForDirection:self.currentDrawerDirection];
+    MSDynamicsDrawerGeometry geometry = MSDynamicsDrawerGeometryMake(direction, paneViewFrame.size, [self revealWidthForDirection:direction], self.paneStateOpenWideEdgeOffset);
+    return MSDynamicsDrawerGeometryLayout(geometry, paneViewFrame.origin, [self paneViewIsResting]);
 }
 
-- (CGFloat)currentRevealWidth
+- (BOOL)paneViewIsResting
 {
-    switch (self.currentDrawerDirection) {
-        case MSDynamicsDrawerDirectionLeft:
-        case MSDynamicsDrawerDirectionRight:
-            return fabs(self.paneView.frame.origin.x);
-        case MSDynamicsDrawerDirectionTop:
-        case MSDynamicsDrawerDirectionBottom:
-            return fabs(self.paneView.frame.origin.y);
-        default:
-            return 0.0;
+    return ([self paneMotionPhase] == MSDynamicsDrawerPaneMotionPhaseResting);
+}
+
+- (MSDynamicsDrawerPaneMotionPhase)paneMotionPhase
+{
+    UIGestureRecognizerState panState = self.panePanGestureRecognizer.state;
+    if ((panState == UIGestureRecognizerStateBegan) || (panState == UIGestureRecognizerStateChanged)) {
+        return MSDynamicsDrawerPaneMotionPhaseDragging;
+    }
+    if (self.coreAnimationTransitionAnimation) {
+        return MSDynamicsDrawerPaneMotionPhaseCoreAnimation;
     }
+    if (self.paneMotionEngine.isRunning) {
+        return MSDynamicsDrawerPaneMotionPhaseEngine;
+    }
+    return MSDynamicsDrawerPaneMotionPhaseResting;
 }
 
-#pragma mark Gestures
+- (MSDynamicsDrawerLayout)currentLayout
+{
+    return [self layoutForPaneViewFrame:self.paneView.frame direction:self.currentDrawerDirection];
+}
 
-- (void)setPaneDragRevealEnabled:(BOOL)paneDraggingEnabled forDirection:(MSDynamicsDrawerDirection)direction
+#pragma mark Stylers
+
+- (void)addStyler:(id <MSDynamicsDrawerStyler>)styler forDirection:(MSDynamicsDrawerDirection)direction
 {
+    NSParameterAssert(styler);
+    [self beginStylerUpdates];
+    MSDynamicsDrawerStylerBatch *stylerBatch = [self stylerBatchRecordingStyler:styler];
     MSDynamicsDrawerDirectionActionForMaskedValues(direction, ^(MSDynamicsDrawerDirection maskedValue){
-        self.paneDragRevealEnabled[@(maskedValue)] = @(paneDraggingEnabled);
+        NSMutableOrderedSet *stylers = self->_directionConfigurations[MSDynamicsDrawerCardinalDirectionIndex(maskedValue)].stylers;
+        if (![stylers containsObject:styler]) {
+            [stylers addObject:styler];
+            [self->_stylerMemberships addObject:styler];
+        }
     });
+    [stylerBatch.addedDirections setObject:@([[stylerBatch.addedDirections objectForKey:styler] integerValue] | direction) forKey:styler];
+    [self commitStylerUpdates];
 }
 
-- (BOOL)paneDragRevealEnabledForDirection:(MSDynamicsDrawerDirection)direction
+- (void)removeStyler:(id <MSDynamicsDrawerStyler>)styler forDirection:(MSDynamicsDrawerDirection)direction
 {
-    NSAssert(MSDynamicsDrawerDirectionIsCardinal(direction), @"Only accepts singular directions when querying for drag reveal enabled");
-    NSNumber *paneDragRevealEnabled = self.paneDragRevealEnabled[@(direction)];
-    if (![paneDragRevealEnabled boolValue]) paneDragRevealEnabled = @(YES);
-    return [paneDragRevealEnabled boolValue];
+    NSParameterAssert(styler);
+    [self beginStylerUpdates];
+    MSDynamicsDrawerStylerBatch *stylerBatch = [self stylerBatchRecordingStyler:styler];
+    MSDynamicsDrawerDirectionActionForMaskedValues(direction, ^(MSDynamicsDrawerDirection maskedValue){
+        NSMutableOrderedSet *stylers = self->_directionConfigurations[MSDynamicsDrawerCardinalDirectionIndex(maskedValue)].stylers;
+        if ([stylers containsObject:styler]) {
+            [stylers removeObject:styler];
+            [self->_stylerMemberships removeObject:styler];
+        }
+    });
+    [stylerBatch.removedDirections setObject:@([[stylerBatch.removedDirections objectForKey:styler] integerValue] | direction) forKey:styler];
+    [self commitStylerUpdates];
 }
 
-- (void)setPaneTapToCloseEnabled:(BOOL)paneTapToCloseEnabled forDirection:(MSDynamicsDrawerDirection)direction
+- (BOOL)stylerIsContainedInAnyDirection:(id <MSDynamicsDrawerStyler>)styler
 {
-    MSDynamicsDrawerDirectionActionForMaskedValues(direction, ^(MSDynamicsDrawerDirection maskedValue){
-        self.paneTapToCloseEnabled[@(maskedValue)] = @(paneTapToCloseEnabled);
-    });
+    return ([_stylerMemberships countForObject:styler] != 0);
 }
 
-- (BOOL)paneTapToCloseEnabledForDirection:(MSDynamicsDrawerDirection)direction
+- (void)beginStylerUpdates
 {
-    NSAssert(MSDynamicsDrawerDirectionIsCardinal(direction), @"Only accepts singular directions when querying for drag reveal enabled");
-    NSNumber *paneTapToCloseEnabled = self.paneTapToCloseEnabled[@(direction)];
-    if (![paneTapToCloseEnabled boolValue]) paneTapToCloseEnabled = @(YES);
-    return [paneTapToCloseEnabled boolValue];
+    if (_stylerUpdateDepth++ == 0) {
+        _stylerBatch = [MSDynamicsDrawerStylerBatch new];
+    }
 }
 
-- (void)registerTouchForwardingClass:(Class)touchForwardingClass
+- (void)commitStylerUpdates
 {
-    NSAssert([touchForwardingClass isSubclassOfClass:[UIView class]], @"Registered touch forwarding classes must be a subclass of UIView");
-    [self.touchForwardingClasses addObject:touchForwardingClass];
+    NSAssert((_stylerUpdateDepth > 0), @"Unbalanced call to `commitStylerUpdates` without a matching `beginStylerUpdates`");
+    if ((_stylerUpdateDepth == 0) || (--_stylerUpdateDepth != 0)) {
+        return;
+    }
+    // Detach the batch first, so that stylers that add or remove stylers from their callbacks begin a batch of their own
+    MSDynamicsDrawerStylerBatch *stylerBatch = _stylerBatch;
+    _stylerBatch = nil;
+    
+    [self rebuildStylerTables];
+    
+    // Commit the layer work of all added and removed stylers, and the styling of the stylers that are now set, as a single set of layer changes
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    for (id <MSDynamicsDrawerStyler> styler in stylerBatch.stylers) {
+        BOOL wasContained = [[stylerBatch.initialMemberships objectForKey:styler] boolValue];
+        BOOL isContained = [self stylerIsContainedInAnyDirection:styler];
+        // Only changes in membership are reported, so a styler that was moved between directions or re-added keeps its state
+        if (!wasContained && isContained) {
+            MSDynamicsDrawerDirection direction = [[stylerBatch.addedDirections objectForKey:styler] integerValue];
+            if ([styler respondsToSelector:@selector(stylerWasAddedToDynamicsDrawerViewController:forDirection:)]) {
+                [styler stylerWasAddedToDynamicsDrawerViewController:self forDirection:direction];
+            }
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-declarations"
+            if ([styler respondsToSelector:@selector(stylerWasAddedToDynamicsDrawerViewController:)]) {
+                [styler stylerWasAddedToDynamicsDrawerViewController:self];
+            }
+#pragma clang diagnostic pop
+        } else if (wasContained && !isContained) {
+            MSDynamicsDrawerDirection direction = [[stylerBatch.removedDirections objectForKey:styler] integerValue];
+            if ([styler respondsToSelector:@selector(stylerWasRemovedFromDynamicsDrawerViewController:forDirection:)]) {
+                [styler stylerWasRemovedFromDynamicsDrawerViewController:self forDirection:direction];
+            }
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-declarations"
+            if ([styler respondsToSelector:@selector(stylerWasRemovedFromDynamicsDrawerViewController:)]) {
+                [styler stylerWasRemovedFromDynamicsDrawerViewController:self];
+            }
+#pragma clang diagnostic pop
+        }
+    }
+    if (self.isViewLoaded && (stylerBatch.stylers.count != 0)) {
+        [self updateStylers];
+    }
+    [CATransaction commit];
 }
 
-- (CGFloat)deltaForPanWithStartLocation:(CGPoint)startLocation currentLocation:(CGPoint)currentLocation
+- (MSDynamicsDrawerStylerBatch *)stylerBatchRecordingStyler:(id <MSDynamicsDrawerStyler>)styler
 {
-    CGFloat panDelta = 0.0;
-    if (self.possibleDrawerDirection & MSDynamicsDrawerDirectionHorizontal) {
-        panDelta = (currentLocation.x - startLocation.x);
-    } else if (self.possibleDrawerDirection & MSDynamicsDrawerDirectionVertical) {
-        panDelta = (currentLocation.y - startLocation.y);
+    MSDynamicsDrawerStylerBatch *stylerBatch = _stylerBatch;
+    if (![stylerBatch.stylers containsObject:styler]) {
+        [stylerBatch.stylers addObject:styler];
+        [stylerBatch.initialMemberships setObject:@([self stylerIsContainedInAnyDirection:styler]) forKey:styler];
     }
-    return panDelta;
+    return stylerBatch;
 }
 
-- (MSDynamicsDrawerDirection)directionForPanWithStartLocation:(CGPoint)startLocation currentLocation:(CGPoint)currentLocation
+- (void)rebuildStylerTables
 {
-    CGFloat delta = [self deltaForPanWithStartLocation:startLocation currentLocation:currentLocation];
-    MSDynamicsDrawerDirection direction = MSDynamicsDrawerDirectionNone;
-    if (self.possibleDrawerDirection & MSDynamicsDrawerDirectionHorizontal) {
-        if (delta > 0.0) {
-            direction = MSDynamicsDrawerDirectionLeft;
-        } else if (delta < 0.0) {
-            direction = MSDynamicsDrawerDirectionRight;
-        }
-    } else if (self.possibleDrawerDirection & MSDynamicsDrawerDirectionVertical) {
-        if (delta > 0.0) {
-            direction = MSDynamicsDrawerDirectionTop;
-        } else if (delta < 0.0) {
-            direction = MSDynamicsDrawerDirectionBottom;
-        }
+    // The durations accumulated by the tables being replaced would otherwise be lost
+    [self recordStylerUpdateDurationsIntoTransitionMetrics:self.transitionMetrics];
+    NSMutableOrderedSet *allStylers = [NSMutableOrderedSet new];
+    for (NSUInteger index = 0; index < MSDynamicsDrawerCardinalDirectionCount; index++) {
+        MSDynamicsDrawerDirectionConfiguration *configuration = &_directionConfigurations[index];
+        configuration->stylerTable = [[MSDynamicsDrawerStylerTable alloc] initWithStylers:configuration->stylers.array dynamicsDrawerViewController:self];
+        [allStylers unionOrderedSet:configuration->stylers];
     }
-    return direction;
+    _allStylerTable = [[MSDynamicsDrawerStylerTable alloc] initWithStylers:allStylers.array dynamicsDrawerViewController:self];
 }
 
-- (CGRect)paneViewFrameForPanWithStartLocation:(CGPoint)startLocation currentLocation:(CGPoint)currentLocation bounded:(inout BOOL *)bounded
+- (void)invalidateStylerDeliveries
 {
-    CGFloat panDelta = [self deltaForPanWithStartLocation:startLocation currentLocation:currentLocation];
-    // Track the pane frame to the pan gesture
-    CGRect paneFrame = self.paneView.frame;
-    if (self.possibleDrawerDirection & MSDynamicsDrawerDirectionHorizontal) {
-        paneFrame.origin.x += panDelta;
-    } else if (self.possibleDrawerDirection & MSDynamicsDrawerDirectionVertical) {
-        paneFrame.origin.y += panDelta;
+    for (NSUInteger index = 0; index < MSDynamicsDrawerCardinalDirectionCount; index++) {
+        [_directionConfigurations[index].stylerTable invalidateDeliveries];
     }
-    // Pane view edge bounding
-    CGFloat paneBoundOpenLocation = 0.0;
-    CGFloat paneBoundClosedLocation = 0.0;
-    CGFloat *paneLocation = NULL;
-    switch (self.currentDrawerDirection) {
-        case MSDynamicsDrawerDirectionLeft:
-            paneLocation = &paneFrame.origin.x;
-            paneBoundOpenLocation = [self openStateRevealWidth];
-            break;
-        case MSDynamicsDrawerDirectionRight:
-            paneLocation = &paneFrame.origin.x;
-            paneBoundClosedLocation = -[self openStateRevealWidth];
-            break;
-        case MSDynamicsDrawerDirectionTop:
-            paneLocation = &paneFrame.origin.y;
-            paneBoundOpenLocation = [self openStateRevealWidth];
-            break;
-        case MSDynamicsDrawerDirectionBottom:
-            paneLocation = &paneFrame.origin.y;
-            paneBoundClosedLocation = -[self openStateRevealWidth];
-            break;
-        default:
-            break;
+    [_allStylerTable invalidateDeliveries];
+}
+
+- (void)recordStylerUpdateDurationsIntoTransitionMetrics:(MSDynamicsDrawerTransitionMetrics *)transitionMetrics
+{
+    if (!transitionMetrics) {
+        return;
     }
-    // Bounded open
-    if (paneLocation && (*paneLocation <= paneBoundClosedLocation)) {
-        *paneLocation = paneBoundClosedLocation;
-        *bounded = YES;
+    NSMutableArray *stylerTables = [NSMutableArray arrayWithCapacity:(MSDynamicsDrawerCardinalDirectionCount + 1)];
+    for (NSUInteger index = 0; index < MSDynamicsDrawerCardinalDirectionCount; index++) {
+        if (_directionConfigurations[index].stylerTable) {
+            [stylerTables addObject:_directionConfigurations[index].stylerTable];
+        }
     }
-    // Bounded closed
-    else if (paneLocation && (*paneLocation >= paneBoundOpenLocation)) {
-        *paneLocation = paneBoundOpenLocation;
-        *bounded = YES;
+    if (_allStylerTable) {
+        [stylerTables addObject:_allStylerTable];
     }
-    else {
-        *bounded = NO;
+    for (MSDynamicsDrawerStylerTable *stylerTable in stylerTables) {
+        for (NSUInteger index = 0; index < stylerTable->_count; index++) {
+            MSDynamicsDrawerStylerEntry *entry = &stylerTable->_entries[index];
+            if (entry->transitionUpdateDuration != 0.0) {
+                [transitionMetrics recordUpdateDuration:entry->transitionUpdateDuration forStylerClass:entry->stylerClass];
+                entry->transitionUpdateDuration = 0.0;
+            }
+        }
     }
-    return paneFrame;
 }
 
-- (CGFloat)velocityForPanWithStartLocation:(CGPoint)startLocation currentLocation:(CGPoint)currentLocation
+- (void)addStylersFromArray:(NSArray *)stylers forDirection:(MSDynamicsDrawerDirection)direction
 {
-    CGFloat velocity = 0.0;
-    if (self.possibleDrawerDirection & MSDynamicsDrawerDirectionHorizontal) {
-        velocity = -(startLocation.x - currentLocation.x);
-    } else if (self.possibleDrawerDirection & MSDynamicsDrawerDirectionVertical) {
-        velocity = -(startLocation.y - currentLocation.y);
+    [self beginStylerUpdates];
+    for (id <MSDynamicsDrawerStyler> styler in stylers) {
+        [self addStyler:styler forDirection:direction];
     }
-    return velocity;
+    [self commitStylerUpdates];
 }
 
-- (MSDynamicsDrawerPaneState)paneStateForPanVelocity:(CGFloat)panVelocity
+- (void)updateStylers
+{
+    [self updateStylersWithLayout:[self currentLayout]];
+}
+
+- (void)updateStylersWithLayout:(MSDynamicsDrawerLayout)layout
 {
-    MSDynamicsDrawerPaneState state = MSDynamicsDrawerPaneStateClosed;
-    if (self.currentDrawerDirection & (MSDynamicsDrawerDirectionTop | MSDynamicsDrawerDirectionLeft)) {
-        state = ((panVelocity > 0) ? MSDynamicsDrawerPaneStateOpen : MSDynamicsDrawerPaneStateClosed);
-    } else if (self.currentDrawerDirection & (MSDynamicsDrawerDirectionBottom | MSDynamicsDrawerDirectionRight)) {
-        state = ((panVelocity < 0) ? MSDynamicsDrawerPaneStateOpen : MSDynamicsDrawerPaneStateClosed);
+    // Prevent weird animation issues on rotation
+    if (self.animatingRotation) {
+        return;
     }
-    return state;
+    MSDynamicsDrawerStylerTable *activeStylerTable;
+    if (MSDynamicsDrawerDirectionIsCardinal(self.currentDrawerDirection)) {
+        activeStylerTable = _directionConfigurations[MSDynamicsDrawerCardinalDirectionIndex(self.currentDrawerDirection)].stylerTable;
+    } else {
+        activeStylerTable = _allStylerTable;
+    }
+    [self updateStylerTable:activeStylerTable withLayout:layout];
 }
 
-- (UIRectEdge)panGestureRecognizer:(UIPanGestureRecognizer *)panGestureRecognizer didStartAtEdgesOfView:(UIView *)view
+- (void)updateStylerTable:(MSDynamicsDrawerStylerTable *)stylerTable withLayout:(MSDynamicsDrawerLayout)layout
 {
-    CGPoint translation = [panGestureRecognizer translationInView:view];
-    CGPoint currentLocation = [panGestureRecognizer locationInView:view];
-    CGPoint startLocation = CGPointMake((currentLocation.x - translation.x), (currentLocation.y - translation.y));
-    UIEdgeInsets distanceToEdges = UIEdgeInsetsMake(startLocation.y, startLocation.x, (view.bounds.size.height - startLocation.y), (view.bounds.size.width - startLocation.x));
-    UIRectEdge rectEdge = UIRectEdgeNone;
-    if (distanceToEdges.top < MSPaneViewScreenEdgeThreshold) {
-        rectEdge |= UIRectEdgeTop;
+    MSDynamicsDrawerTransitionMetrics *transitionMetrics = self.transitionMetrics;
+    CFTimeInterval startTimestamp = (transitionMetrics ? CACurrentMediaTime() : 0.0);
+    if (transitionMetrics.emitsSignposts) {
+        if (@available(iOS 12.0, *)) {
+            os_signpost_interval_begin(MSDynamicsDrawerTransitionsLog(), OS_SIGNPOST_ID_EXCLUSIVE, "Update Stylers");
+        }
     }
-    if (distanceToEdges.left < MSPaneViewScreenEdgeThreshold) {
-        rectEdge |= UIRectEdgeLeft;
+    MSDynamicsDrawerStylerComposition *stylerComposition = self.stylerComposition;
+    [stylerComposition reset];
+    // The strong local reference keeps the table and its stylers alive if a styler is added or removed during the updates
+    MSDynamicsDrawerStylerTable *dispatchingStylerTable = stylerTable;
+    BOOL deliversComposition = MSDynamicsDrawerStylerDeliveryRequired(&dispatchingStylerTable->_compositionDelivery, layout, MSDynamicsDrawerStylerUpdateGranularityContinuous, 0.0, self.stylerUpdateThreshold);
+    if (deliversComposition) {
+        MSDynamicsDrawerStylerDeliveryRecord(&dispatchingStylerTable->_compositionDelivery, layout);
+    }
+    for (NSUInteger index = 0; index < dispatchingStylerTable->_count; index++) {
+        MSDynamicsDrawerStylerEntry *entry = &dispatchingStylerTable->_entries[index];
+        // Skip the stylers whose last delivered layout is equivalent to this one
+        if (entry->dispatch == MSDynamicsDrawerStylerDispatchComposition) {
+            if (!deliversComposition) {
+                continue;
+            }
+        } else {
+            if (!MSDynamicsDrawerStylerDeliveryRequired(&entry->delivery, layout, entry->updateGranularity, entry->updateDistance, self.stylerUpdateThreshold)) {
+                continue;
+            }
+            MSDynamicsDrawerStylerDeliveryRecord(&entry->delivery, layout);
+        }
+        if (transitionMetrics) {
+            CFTimeInterval stylerStartTimestamp = CACurrentMediaTime();
+            MSDynamicsDrawerStylerEntryUpdate(entry, self, layout, stylerComposition);
+            entry->transitionUpdateDuration += (CACurrentMediaTime() - stylerStartTimestamp);
+        } else {
+            MSDynamicsDrawerStylerEntryUpdate(entry, self, layout, stylerComposition);
+        }
     }
-    if (distanceToEdges.right < MSPaneViewScreenEdgeThreshold) {
-        rectEdge |= UIRectEdgeRight;
+    BOOL alignsStatusBar = self.shouldAlignStatusBarToPaneView;
+    if (stylerComposition.hasContributions || alignsStatusBar) {
+        // Apply the contributions of all compositing stylers and the status bar alignment at once, committing them as a single set of layer changes without implicit animations
+        [CATransaction begin];
+        [CATransaction setDisableActions:YES];
+        if (stylerComposition.hasContributions) {
+            [stylerComposition applyToDrawerView:self.drawerView drawerViewControllerView:(self.drawerViewController.isViewLoaded ? self.drawerViewController.view : nil) paneView:self.paneView];
+        }
+        if (alignsStatusBar) {
+            [self.statusBarAligner dynamicsDrawerViewController:self alignStatusBarToLayout:layout];
+        }
+        [CATransaction commit];
     }
-    if (distanceToEdges.bottom < MSPaneViewScreenEdgeThreshold) {
-        rectEdge |= UIRectEdgeBottom;
+    if (transitionMetrics) {
+        transitionMetrics.stylerUpdateDuration += (CACurrentMediaTime() - startTimestamp);
+    }
+    if (transitionMetrics.emitsSignposts) {
+        if (@available(iOS 12.0, *)) {
+            os_signpost_interval_end(MSDynamicsDrawerTransitionsLog(), OS_SIGNPOST_ID_EXCLUSIVE, "Update Stylers");
+        }
     }
-    return rectEdge;
 }
 
-#pragma mark User Interaction
+- (NSArray *)stylersForDirection:(MSDynamicsDrawerDirection)direction
+{
+    NSMutableOrderedSet *stlyerCollection = [NSMutableOrderedSet new];
+    MSDynamicsDrawerDirectionActionForMaskedValues(direction, ^(MSDynamicsDrawerDirection maskedValue){
+        [stlyerCollection unionOrderedSet:self->_directionConfigurations[MSDynamicsDrawerCardinalDirectionIndex(maskedValue)].stylers];
+    });
+    return [stlyerCollection array];
+}
 
-- (void)setViewUserInteractionEnabled:(BOOL)enabled
+#pragma mark Pane Updates
+
+- (void)setNeedsPaneViewUpdate
 {
-    static NSInteger disableCount;
-    if (!enabled) {
-        disableCount++;
-    } else {
-        disableCount = MAX((disableCount - 1), 0);
+    if (!self.paneUpdateCoalescingEnabled) {
+        [self paneViewDidUpdateFrame];
+        return;
     }
-    self.view.userInteractionEnabled = (disableCount == 0);
+    self.paneViewNeedsUpdate = YES;
+    self.displayLink.paused = NO;
 }
 
-- (void)setPaneViewControllerViewUserInteractionEnabled:(BOOL)enabled
+- (void)updatePaneViewIfNeeded
 {
-    self.paneViewController.view.userInteractionEnabled = enabled;
+    if (self.paneViewNeedsUpdate) {
+        self.paneViewNeedsUpdate = NO;
+        [self paneViewDidUpdateFrame];
+    }
 }
 
-#pragma mark UIGestureRecognizer Callbacks
-
-- (void)paneTapped:(UIPanGestureRecognizer *)gestureRecognizer
+- (void)setPaneUpdateCoalescingEnabled:(BOOL)paneUpdateCoalescingEnabled
 {
-    if ([self paneTapToCloseEnabledForDirection:self.currentDrawerDirection]) {
-        [self addDynamicsBehaviorsToCreatePaneState:MSDynamicsDrawerPaneStateClosed];
+    _paneUpdateCoalescingEnabled = paneUpdateCoalescingEnabled;
+    if (!paneUpdateCoalescingEnabled) {
+        // Flush any pending update immediately, since the display link will no longer deliver it
+        [self updatePaneViewIfNeeded];
+        _displayLink.paused = YES;
     }
 }
 
-- (void)panePanned:(UIPanGestureRecognizer *)gestureRecognizer
+- (CADisplayLink *)displayLink
 {
-    static CGPoint panStartLocation;
-    static CGFloat paneVelocity;
-    static MSDynamicsDrawerDirection panDirection;
-    
-    switch (gestureRecognizer.state) {
-        case UIGestureRecognizerStateBegan: {
-            // Initialize static variables
-            panStartLocation = [gestureRecognizer locationInView:self.paneView];
-            paneVelocity = 0.0;
-            panDirection = self.currentDrawerDirection;
-            break;
-        }
-        case UIGestureRecognizerStateChanged: {
-            CGPoint currentPanLocation = [gestureRecognizer locationInView:self.paneView];
-            MSDynamicsDrawerDirection currentPanDirection = [self directionForPanWithStartLocation:panStartLocation currentLocation:currentPanLocation];
-            // If there's no current direction, try to determine it
-            if (self.currentDrawerDirection == MSDynamicsDrawerDirectionNone) {
-                MSDynamicsDrawerDirection currentDrawerDirection = MSDynamicsDrawerDirectionNone;
-                // If a direction has not yet been previousy determined, use the pan direction
-                if (panDirection == MSDynamicsDrawerDirectionNone) {
-                    currentDrawerDirection = currentPanDirection;
-                } else {
-                    // Only allow a new direction to be in the same direction as before to prevent swiping between drawers in one gesture
-                    if (currentPanDirection == panDirection) {
-                        currentDrawerDirection = panDirection;
-                    }
-                }
-                // If the new direction is still none, don't continue
-                if (currentDrawerDirection == MSDynamicsDrawerDirectionNone) {
-                    return;
-                }
-                // Ensure that the new current direction is:
-                if ((self.possibleDrawerDirection & currentDrawerDirection) &&         // Possible
-                    ([self paneDragRevealEnabledForDirection:currentDrawerDirection])) // Has drag to reveal enabled
-                {
-                    self.currentDrawerDirection = currentDrawerDirection;
-                    // Establish the initial drawer direction if there was none
-                    if (panDirection == MSDynamicsDrawerDirectionNone) {
-                        panDirection = self.currentDrawerDirection;
-                    }
-                }
-                // If these criteria aren't met, cancel the gesture
-                else {
-                    gestureRecognizer.enabled = NO;
-                    gestureRecognizer.enabled = YES;
-                    return;
-                }
-            }
-            // If the current reveal direction's pane drag reveal is disabled, cancel the gesture
-            else if (![self paneDragRevealEnabledForDirection:self.currentDrawerDirection]) {
-                gestureRecognizer.enabled = NO;
-                gestureRecognizer.enabled = YES;
-                return;
-            }
-            // At this point, panning is able to move the pane independently from the dynamic animator, so remove all behaviors to prevent conflicting frames
-            [self.dynamicAnimator removeAllBehaviors];
-            // Update the pane frame based on the pan gesture
-            BOOL paneViewFrameBounded;
-            self.paneView.frame = [self paneViewFrameForPanWithStartLocation:panStartLocation currentLocation:currentPanLocation bounded:&paneViewFrameBounded];
-            // Update the pane velocity based on the pan gesture
-            CGFloat currentPaneVelocity = [self velocityForPanWithStartLocation:panStartLocation currentLocation:currentPanLocation];
-            // If the pane view is bounded or the determined velocity is 0, don't update it
-            if (!paneViewFrameBounded && (currentPaneVelocity != 0.0)) {
-                paneVelocity = currentPaneVelocity;
-            }
-            // If the drawer is being swiped into the closed state, set the direciton to none and the state to closed since the user is manually doing so
-            if ((self.currentDrawerDirection != MSDynamicsDrawerDirectionNone) &&
-                (currentPanDirection != MSDynamicsDrawerDirectionNone) &&
-                CGPointEqualToPoint(self.paneView.frame.origin, [self paneViewOriginForPaneState:MSDynamicsDrawerPaneStateClosed])) {
-                [self _setPaneState:MSDynamicsDrawerPaneStateClosed];
-                self.currentDrawerDirection = MSDynamicsDrawerDirectionNone;
-            }
-            break;
-        }
-        case UIGestureRecognizerStateEnded: {
-            if (self.currentDrawerDirection != MSDynamicsDrawerDirectionNone) {
-                // If the user released the pane over the velocity threshold
-                if (fabs(paneVelocity) > MSPaneViewVelocityThreshold) {
-                    MSDynamicsDrawerPaneState state = [self paneStateForPanVelocity:paneVelocity];
-                    [self addDynamicsBehaviorsToCreatePaneState:state pushMagnitude:(fabs(paneVelocity) * MSPaneViewVelocityMultiplier) pushAngle:[self gravityAngleForState:state direction:self.currentDrawerDirection] pushElasticity:self.elasticity];
-                }
-                // If not released with a velocity over the threhold, update to nearest `paneState`
-                else {
-                    [self addDynamicsBehaviorsToCreatePaneState:[self nearestPaneState]];
-                }
-            }
-            break;
-        }
-        default:
-            break;
+    if (!_displayLink) {
+        MSDynamicsDrawerDisplayLinkTarget *displayLinkTarget = [MSDynamicsDrawerDisplayLinkTarget new];
+        displayLinkTarget.dynamicsDrawerViewController = self;
+        _displayLink = [CADisplayLink displayLinkWithTarget:displayLinkTarget selector:@selector(displayLinkDidFire:)];
+        _displayLink.paused = YES;
+        [self applyFrameRateRange:self.activeFrameRateRange toDisplayLink:_displayLink];
+        [_displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
     }
+    return _displayLink;
 }
 
-#pragma mark - NSKeyValueObserving
+- (void)displayLinkDidFire:(CADisplayLink *)displayLink
+{
+    MSDynamicsDrawerTransitionMetrics *transitionMetrics = self.transitionMetrics;
+    if (transitionMetrics) {
+        // Dropped frames are measured against the rate that the display link was paced at, rather than the maximum refresh rate of the display
+        CFTimeInterval refreshInterval = (displayLink.targetTimestamp - displayLink.timestamp);
+        [transitionMetrics recordFrameAtTimestamp:displayLink.timestamp refreshInterval:refreshInterval];
+    }
+    BOOL steppingPaneMotion = ([self paneMotionEngineIsSteppedByDisplayLink] && self.paneMotionEngine.isRunning);
+    if (steppingPaneMotion) {
+        [self.paneMotionEngine stepMotionToTimestamp:displayLink.timestamp];
+    }
+    if (self.paneViewNeedsUpdate) {
+        [self updatePaneViewIfNeeded];
+    } else if (!steppingPaneMotion && !transitionMetrics) {
+        // Nothing changed since the last refresh, so stop firing until the pane is marked as needing an update again
+        displayLink.paused = YES;
+    }
+}
 
-- (void)observeValueForKeyPath:(NSString *)keyPath ofObject:(id)object change:(NSDictionary *)change context:(void *)context
+#pragma mark Frame Rate
+
+- (void)setFrameRateRange:(MSDynamicsDrawerFrameRateRange)frameRateRange forTransitionKind:(MSDynamicsDrawerTransitionKind)kind
 {
-    if ([keyPath isEqualToString:NSStringFromSelector(@selector(frame))] && (object == self.paneView)) {
-        if ([object valueForKeyPath:keyPath] != [NSNull null]) {
-            [self paneViewDidUpdateFrame];
-        }
+    NSParameterAssert((kind >= 0) && (kind < MSDynamicsDrawerTransitionKindCount));
+    NSParameterAssert((frameRateRange.minimum <= frameRateRange.maximum) || (frameRateRange.maximum == 0.0));
+    _frameRateRanges[kind] = frameRateRange;
+}
+
+- (MSDynamicsDrawerFrameRateRange)frameRateRangeForTransitionKind:(MSDynamicsDrawerTransitionKind)kind
+{
+    NSParameterAssert((kind >= 0) && (kind < MSDynamicsDrawerTransitionKindCount));
+    return _frameRateRanges[kind];
+}
+
+- (void)setActiveFrameRateRange:(MSDynamicsDrawerFrameRateRange)activeFrameRateRange
+{
+    _activeFrameRateRange = activeFrameRateRange;
+    // Only an existing display link is updated, a display link that's created later is paced when it's created
+    if (_displayLink) {
+        [self applyFrameRateRange:activeFrameRateRange toDisplayLink:_displayLink];
     }
 }
 
-#pragma mark - UIGestureRecognizerDelegate
+- (void)applyFrameRateRange:(MSDynamicsDrawerFrameRateRange)frameRateRange toDisplayLink:(CADisplayLink *)displayLink
+{
+    if (@available(iOS 15.0, *)) {
+        displayLink.preferredFrameRateRange = CAFrameRateRangeMake(frameRateRange.minimum, frameRateRange.maximum, frameRateRange.preferred);
+    } else {
+        displayLink.preferredFramesPerSecond = (NSInteger)frameRateRange.preferred;
+    }
+}
 
-- (BOOL)gestureRecognizerShouldBegin:(UIGestureRecognizer *)gestureRecognizer
+- (void)applyActiveFrameRateRangeToAnimation:(CAAnimation *)animation
 {
-    if (gestureRecognizer == self.panePanGestureRecognizer) {
-        if ([self.delegate respondsToSelector:@selector(dynamicsDrawerViewController:shouldBeginPanePan:)]) {
-            if (![self.delegate dynamicsDrawerViewController:self shouldBeginPanePan:self.panePanGestureRecognizer]) {
-                return NO;
-            }
-        }
-        if (self.paneDragRequiresScreenEdgePan) {
-            MSDynamicsDrawerPaneState paneState;
-            if ([self paneViewIsPositionedInValidState:&paneState] && (paneState == MSDynamicsDrawerPaneStateClosed)) {
-                UIRectEdge edges = [self panGestureRecognizer:self.panePanGestureRecognizer didStartAtEdgesOfView:self.paneView];
-                // Mask out edges that aren't possible
-                BOOL validEdges = (edges & self.possibleDrawerDirection);
-                // If there is a valid edge and pane drag is revealed for that edge's direction
-                if (validEdges && [self paneDragRevealEnabledForDirection:validEdges]) {
-                    return YES;
-                }
-                return NO;
-            }
-        }
+    if (@available(iOS 15.0, *)) {
+        MSDynamicsDrawerFrameRateRange frameRateRange = self.activeFrameRateRange;
+        animation.preferredFrameRateRange = CAFrameRateRangeMake(frameRateRange.minimum, frameRateRange.maximum, frameRateRange.preferred);
     }
-	return YES;
 }
 
-- (BOOL)gestureRecognizer:(UIGestureRecognizer *)gestureRecognizer shouldReceiveTouch:(UITouch *)touch
+#pragma mark Transition Snapshots
+
+- (void)setTransitionSnapshotOptions:(MSDynamicsDrawerTransitionSnapshotOptions)options forDirection:(MSDynamicsDrawerDirection)direction
 {
-    if (gestureRecognizer == self.panePanGestureRecognizer) {
-        __block BOOL shouldReceiveTouch = YES;
-        // Enumerate the view's superviews, checking for a touch-forwarding class
-        [touch.view superviewHierarchyAction:^(UIView *view) {
-            // Only enumerate while still receiving the touch
-            if (!shouldReceiveTouch) {
-                return;
-            }
-            // If the touch was in a touch forwarding view, don't handle the gesture
-            [self.touchForwardingClasses enumerateObjectsUsingBlock:^(Class touchForwardingClass, BOOL *stop) {
-                if ([view isKindOfClass:touchForwardingClass]) {
-                    shouldReceiveTouch = NO;
-                    *stop = YES;
-                }
-            }];
-        }];
-        return shouldReceiveTouch;
-    } else if (gestureRecognizer == self.paneTapGestureRecognizer) {
-        MSDynamicsDrawerPaneState paneState;
-        if ([self paneViewIsPositionedInValidState:&paneState]) {
-            return (paneState != MSDynamicsDrawerPaneStateClosed);
-        }
+    MSDynamicsDrawerDirectionActionForMaskedValues(direction, ^(MSDynamicsDrawerDirection maskedValue){
+        self->_directionConfigurations[MSDynamicsDrawerCardinalDirectionIndex(maskedValue)].transitionSnapshotOptions = options;
+    });
+}
+
+- (MSDynamicsDrawerTransitionSnapshotOptions)transitionSnapshotOptionsForDirection:(MSDynamicsDrawerDirection)direction
+{
+    NSAssert(MSDynamicsDrawerDirectionIsCardinal(direction), @"Only accepts singular directions when querying for transition snapshot options");
+    return _directionConfigurations[MSDynamicsDrawerCardinalDirectionIndex(direction)].transitionSnapshotOptions;
+}
+
+- (void)beginTransitionSnapshotsIfNeeded
+{
+    // Only attempt snapshots once per transition, so that the delegate isn't queried on every pan
+    if (self.transitionSnapshotsActive || (self.currentDrawerDirection == MSDynamicsDrawerDirectionNone)) {
+        return;
+    }
+    MSDynamicsDrawerTransitionSnapshotOptions options = [self transitionSnapshotOptionsForDirection:self.currentDrawerDirection];
+    if (options == MSDynamicsDrawerTransitionSnapshotOptionNone) {
+        return;
+    }
+    self.transitionSnapshotsActive = YES;
+    if (options & MSDynamicsDrawerTransitionSnapshotOptionPane) {
+        // The pane is already on screen, so its existing rendering can be used
+        self.paneSnapshotView = [self transitionSnapshotViewForViewController:self.paneViewController afterScreenUpdates:NO];
+        self.paneSnapshotLiveView = (self.paneSnapshotView ? self.paneViewController.view : nil);
+    }
+    if (options & MSDynamicsDrawerTransitionSnapshotOptionDrawer) {
+        // The drawer has likely only just been added to the drawer view, so it must be rendered before it can be snapshotted
+        self.drawerSnapshotView = [self transitionSnapshotViewForViewController:self.drawerViewController afterScreenUpdates:YES];
+        self.drawerSnapshotLiveView = (self.drawerSnapshotView ? self.drawerViewController.view : nil);
     }
-    return YES;
 }
 
-- (BOOL)gestureRecognizer:(UIGestureRecognizer *)gestureRecognizer shouldBeRequiredToFailByGestureRecognizer:(UIGestureRecognizer *)otherGestureRecognizer
+- (UIView *)transitionSnapshotViewForViewController:(UIViewController *)viewController afterScreenUpdates:(BOOL)afterScreenUpdates
 {
-    if ((gestureRecognizer == self.panePanGestureRecognizer) && self.screenEdgePanCancelsConflictingGestures) {
-        UIRectEdge edges = [self panGestureRecognizer:self.panePanGestureRecognizer didStartAtEdgesOfView:self.paneView];
-        // Mask out edges that aren't possible
-        BOOL validEdges = (edges & self.possibleDrawerDirection);
-        // If there is a valid edge and pane drag is revealed for that edge's direction
-        if (validEdges && [self paneDragRevealEnabledForDirection:validEdges]) {
-            return YES;
-        }
+    if (!viewController.isViewLoaded || !viewController.view.superview) {
+        return nil;
     }
-    return NO;
+    if ([self.delegate respondsToSelector:@selector(dynamicsDrawerViewController:shouldSnapshotViewController:forDirection:)] &&
+        ![self.delegate dynamicsDrawerViewController:self shouldSnapshotViewController:viewController forDirection:self.currentDrawerDirection]) {
+        return nil;
+    }
+    UIView *liveView = viewController.view;
+    UIView *snapshotView = [liveView snapshotViewAfterScreenUpdates:afterScreenUpdates];
+    if (!snapshotView) {
+        return nil;
+    }
+    snapshotView.frame = liveView.frame;
+    snapshotView.autoresizingMask = liveView.autoresizingMask;
+    [liveView.superview insertSubview:snapshotView aboveSubview:liveView];
+    // Hiding the live view removes its layers from compositing until it is restored
+    liveView.hidden = YES;
+    return snapshotView;
 }
 
-- (BOOL)gestureRecognizer:(UIGestureRecognizer *)gestureRecognizer shouldRequireFailureOfGestureRecognizer:(UIGestureRecognizer *)otherGestureRecognizer
+- (void)endTransitionSnapshots
 {
-    // If the other gesture recognizer's view is a `UITableViewCell` instance's internal `UIScrollView`, require failure
-    if ([[otherGestureRecognizer.view nextResponder] isKindOfClass:[UITableViewCell class]] && [otherGestureRecognizer.view isKindOfClass:[UIScrollView class]]) {
+    if (!self.transitionSnapshotsActive) {
+        return;
+    }
+    self.transitionSnapshotsActive = NO;
+    self.paneSnapshotLiveView.hidden = NO;
+    [self.paneSnapshotView removeFromSuperview];
+    self.paneSnapshotView = nil;
+    self.paneSnapshotLiveView = nil;
+    self.drawerSnapshotLiveView.hidden = NO;
+    [self.drawerSnapshotView removeFromSuperview];
+    self.drawerSnapshotView = nil;
+    self.drawerSnapshotLiveView = nil;
+}
+
+#pragma mark Transition Metrics
+
+- (BOOL)transitionMetricsRequired
+{
+    if ([self.delegate respondsToSelector:@selector(dynamicsDrawerViewController:didFinishTransitionWithMetrics:)]) {
         return YES;
     }
+    if (@available(iOS 12.0, *)) {
+        return os_signpost_enabled(MSDynamicsDrawerTransitionsLog());
+    }
     return NO;
 }
 
-#pragma mark - UIDynamicAnimatorDelegate
+- (void)beginTransitionWithKind:(MSDynamicsDrawerTransitionKind)kind
+{
+    // Pace the pane updates for the kind of transition before any of its frames are produced
+    self.activeFrameRateRange = _frameRateRanges[kind];
+    [self beginTransitionMetricsWithKind:kind];
+}
 
-- (void)dynamicAnimatorDidPause:(UIDynamicAnimator *)animator
+- (void)beginTransitionMetricsWithKind:(MSDynamicsDrawerTransitionKind)kind
 {
-    // If the dynaimc animator has paused while the `panePanGestureRecognizer` is active, ignore it as it's a side effect of removing behaviors, not a resting state
-    if (self.panePanGestureRecognizer.state != UIGestureRecognizerStatePossible) return;
+    // A new transition interrupts the one in progress
+    [self finishTransitionMetricsInterrupted:YES];
+    if (![self transitionMetricsRequired]) {
+        return;
+    }
+    MSDynamicsDrawerTransitionMetrics *transitionMetrics = [[MSDynamicsDrawerTransitionMetrics alloc] initWithKind:kind direction:self.currentDrawerDirection startTimestamp:CACurrentMediaTime()];
+    if (@available(iOS 12.0, *)) {
+        os_log_t transitionsLog = MSDynamicsDrawerTransitionsLog();
+        transitionMetrics.emitsSignposts = os_signpost_enabled(transitionsLog);
+        if (transitionMetrics.emitsSignposts) {
+            transitionMetrics.signpostIdentifier = os_signpost_id_generate(transitionsLog);
+            if (@available(iOS 14.0, *)) {
+                // Marked as an animation, so that `XCTOSSignpostMetric` reports the hitches of the transition
+                os_signpost_animation_interval_begin(transitionsLog, transitionMetrics.signpostIdentifier, "Transition", "%{public}s", MSDynamicsDrawerTransitionKindName(kind));
+            } else {
+                os_signpost_interval_begin(transitionsLog, transitionMetrics.signpostIdentifier, "Transition", "%{public}s", MSDynamicsDrawerTransitionKindName(kind));
+            }
+        }
+    }
+    self.transitionMetrics = transitionMetrics;
+    // Keep the display link running for the duration of the transition so that it can count the frames
+    self.displayLink.paused = NO;
+}
+
+- (void)finishTransitionMetricsInterrupted:(BOOL)interrupted
+{
+    MSDynamicsDrawerTransitionMetrics *transitionMetrics = self.transitionMetrics;
+    if (!transitionMetrics) {
+        return;
+    }
+    self.transitionMetrics = nil;
+    [self recordStylerUpdateDurationsIntoTransitionMetrics:transitionMetrics];
+    [transitionMetrics finishWithPaneState:self.paneState interrupted:interrupted endTimestamp:CACurrentMediaTime()];
+    if (transitionMetrics.emitsSignposts) {
+        if (@available(iOS 12.0, *)) {
+            os_signpost_interval_end(MSDynamicsDrawerTransitionsLog(), transitionMetrics.signpostIdentifier, "Transition", "frames: %lu, dropped: %lu, fps: %.1f, hitch ratio: %.1f ms/s, interrupted: %d", (unsigned long)transitionMetrics.framesRendered, (unsigned long)transitionMetrics.framesDropped, transitionMetrics.achievedFrameRate, transitionMetrics.hitchTimeRatio, interrupted);
+        }
+    }
+    if ([self.delegate respondsToSelector:@selector(dynamicsDrawerViewController:didFinishTransitionWithMetrics:)]) {
+        [self.delegate dynamicsDrawerViewController:self didFinishTransitionWithMetrics:transitionMetrics];
+    }
+}
+
+#pragma mark Pane State
+
+- (void)paneViewDidUpdateFrame
+{
+    // Compute the layout once for this frame, it's shared by the open wide detection and all stylers
+    MSDynamicsDrawerLayout layout = [self currentLayout];
     
-    // Since a resting pane state has been reached, we can remove all behaviors
-    [self.dynamicAnimator removeAllBehaviors];
+    // The layout is of the current direction, so the pane has reached open wide once it's at least as far along the current kernel's signed axis as the open wide origin
+    const MSDynamicsDrawerDirectionKernel *kernel = _currentDirectionKernel;
+    BOOL reachedOpenWideState = (kernel && ((kernel->sign * MSDynamicsDrawerDirectionKernelAxisComponent(kernel, layout.paneViewFrame.origin)) >= (kernel->sign * MSDynamicsDrawerDirectionKernelAxisComponent(kernel, layout.openWidePaneViewOrigin))));
+    if (reachedOpenWideState && (self.potentialPaneState == MSDynamicsDrawerPaneStateOpenWide)) {
+        [self.paneMotionEngine stopMotion];
+    }
     
-    // Update the pane state to the nearest pane state
-    [self _setPaneState:[self nearestPaneState]];
+    [self updateStylersWithLayout:layout];
+}
+
+- (void)setPaneState:(MSDynamicsDrawerPaneState)paneState
+{
+    [self setPaneState:paneState animated:NO allowUserInterruption:NO completion:nil];
+}
+
+- (void)setPaneState:(MSDynamicsDrawerPaneState)paneState inDirection:(MSDynamicsDrawerDirection)direction
+{
+    [self setPaneState:paneState inDirection:direction animated:NO allowUserInterruption:NO completion:nil];
+}
+
+- (void)setPaneState:(MSDynamicsDrawerPaneState)paneState animated:(BOOL)animated allowUserInterruption:(BOOL)allowUserInterruption completion:(void (^)(void))completion
+{
+    // If the drawer is getting opened and there's more than one possible direction enforce that the directional eqivalent is used
+    MSDynamicsDrawerDirection direction;
+    if ((paneState != MSDynamicsDrawerPaneStateClosed) && (self.currentDrawerDirection == MSDynamicsDrawerDirectionNone)) {
+        NSAssert(MSDynamicsDrawerDirectionIsCardinal(self.possibleDrawerDirection), @"Unable to set the pane to an open state with multiple possible drawer directions, as the drawer direction to open in is indeterminate. Use `setPaneState:inDirection:animated:allowUserInterruption:completion:` instead.");
+        direction = self.possibleDrawerDirection;
+    } else {
+        direction = self.currentDrawerDirection;
+    }
+    [self setPaneState:paneState inDirection:direction animated:animated allowUserInterruption:allowUserInterruption completion:completion];
+}
+
+- (void)setPaneState:(MSDynamicsDrawerPaneState)paneState inDirection:(MSDynamicsDrawerDirection)direction animated:(BOOL)animated allowUserInterruption:(BOOL)allowUserInterruption completion:(void (^)(void))completion
+{
+    NSAssert(((self.possibleDrawerDirection & direction) == direction), @"Unable to bounce open with impossible or multiple directions");
+    if ((paneState != MSDynamicsDrawerPaneStateClosed)) {
+        self.currentDrawerDirection = direction;
+    }
+    if (animated) {
+        // A coalesced motion continues the transition in progress, along with its metrics and frame rate
+        if (![self paneMotionCoalescesWithPaneState:paneState pushMagnitude:0.0]) {
+            [self beginTransitionWithKind:MSDynamicsDrawerTransitionKindProgrammatic];
+        }
+        [self addDynamicsBehaviorsToCreatePaneState:paneState pushMagnitude:0.0 pushAngle:0.0 pushElasticity:self.elasticity programmatic:YES];
+        if (!allowUserInterruption) [self setViewUserInteractionEnabled:NO];
+        __weak typeof(self) weakSelf = self;
+        [self addPaneMotionCompletion:^{
+            if (!allowUserInterruption) [weakSelf setViewUserInteractionEnabled:YES];
+            if (completion) completion();
+        }];
+    } else {
+        [self _setPaneState:paneState];
+        if (completion) completion();
+    }
+}
+
+- (void)_setPaneState:(MSDynamicsDrawerPaneState)paneState
+{
+    MSDynamicsDrawerDirection previousDirection = self.currentDrawerDirection;
     
-    // Update pane user interaction appropriately
-    [self setPaneViewControllerViewUserInteractionEnabled:(self.paneState == MSDynamicsDrawerPaneStateClosed)];
+    // When we've actually upated to a pane state, invalidate the `potentialPaneState`
+    self.potentialPaneState = NSIntegerMax;
+    self.potentialDrawerDirection = MSDynamicsDrawerDirectionNone;
     
-    // Since rotation is disabled while the dynamic animator is running, we invoke this method to cause rotation to happen (if device rotation has occured during state transition)
-    [UIViewController attemptRotationToDeviceOrientation];
+    if (_paneState != paneState) {
+        [self willChangeValueForKey:NSStringFromSelector(@selector(paneState))];
+        _paneState = paneState;
+        if ([self.delegate respondsToSelector:@selector(dynamicsDrawerViewController:didUpdateToPaneState:forDirection:)]) {
+            if (self.paneState & (MSDynamicsDrawerPaneStateOpen | MSDynamicsDrawerPaneStateOpenWide)) {
+                [self.delegate dynamicsDrawerViewController:self didUpdateToPaneState:paneState forDirection:self.currentDrawerDirection];
+            } else {
+                [self.delegate dynamicsDrawerViewController:self didUpdateToPaneState:paneState forDirection:previousDirection];
+            }
+        }
+        [self didChangeValueForKey:NSStringFromSelector(@selector(paneState))];
+    }
+    
+    // Only update the pane frame if it has changed, as each update is observed and causes the stylers to be updated
+    CGRect paneViewFrame = (CGRect){[self paneViewOriginForPaneState:paneState], self.paneView.frame.size};
+    if (!CGRectEqualToRect(self.paneView.frame, paneViewFrame)) {
+        self.paneView.frame = paneViewFrame;
+    }
     
-    if (self.dynamicAnimatorCompletion) {
-        self.dynamicAnimatorCompletion();
-        self.dynamicAnimatorCompletion = nil;
+    // Update `currentDirection` to `MSDynamicsDrawerDirectionNone` if the `paneState` is `MSDynamicsDrawerPaneStateClosed`
+    if (paneState == MSDynamicsDrawerPaneStateClosed) {
+        self.currentDrawerDirection = MSDynamicsDrawerDirectionNone;
+    }
+}
+
+- (CGPoint)paneViewOriginForPaneState:(MSDynamicsDrawerPaneState)paneState
+{
+    return MSDynamicsDrawerGeometryPaneViewOrigin([self geometryForDirection:self.currentDrawerDirection], paneState);
+}
+
+- (BOOL)paneViewIsPositionedInValidState:(inout MSDynamicsDrawerPaneState *)paneState
+{
+    return MSDynamicsDrawerGeometryPaneStateAtPaneViewOrigin([self geometryForDirection:self.currentDrawerDirection], self.paneView.frame.origin, paneState);
+}
+
+- (MSDynamicsDrawerPaneState)nearestPaneState
+{
+    return [self nearestPaneStateForPaneViewOrigin:self.paneView.frame.origin];
+}
+
+- (MSDynamicsDrawerPaneState)nearestPaneStateForPaneViewOrigin:(CGPoint)paneViewOrigin
+{
+    return MSDynamicsDrawerGeometryNearestPaneState([self geometryForDirection:self.currentDrawerDirection], paneViewOrigin);
+}
+
+#pragma mark Geometry
+
+- (MSDynamicsDrawerGeometry)geometryForDirection:(MSDynamicsDrawerDirection)direction
+{
+    NSAssert(MSDynamicsDrawerDirectionIsNonMasked(direction), @"Only accepts non-masked directions when querying for geometry");
+    return MSDynamicsDrawerGeometryMake(direction, self.paneView.frame.size, [self revealWidthForDirection:direction], self.paneStateOpenWideEdgeOffset);
+}
+
+#pragma mark Current Reveal Direction
+
+- (void)setCurrentDrawerDirection:(MSDynamicsDrawerDirection)currentDrawerDirection
+{
+    NSAssert(MSDynamicsDrawerDirectionIsNonMasked(currentDrawerDirection), @"Only accepts non-masked directions as current reveal direction");
+    NSAssert(!((currentDrawerDirection == MSDynamicsDrawerDirectionNone) && (self.paneState != MSDynamicsDrawerPaneStateClosed)), @"Can't set direction to none while we have a non-closed pane state");
+    
+    if (_currentDrawerDirection == currentDrawerDirection) return;
+    
+    // The stylers are updated from different tables in each direction, so the layouts that each table last delivered are no longer representative
+    [self invalidateStylerDeliveries];
+    
+    // Inform stylers about the transition between directions when directly transitioning
+    if (_currentDrawerDirection != MSDynamicsDrawerDirectionNone) {
+        MSDynamicsDrawerLayout closedLayout = [self layoutForPaneViewFrame:self.paneView.frame direction:MSDynamicsDrawerDirectionNone];
+        [self updateStylerTable:_allStylerTable withLayout:closedLayout];
+    }
+    
+    // Snapshots are specific to the direction and drawer view controller that they were taken for
+    [self endTransitionSnapshots];
+    
+    _currentDrawerDirection = currentDrawerDirection;
+    _currentDirectionKernel = MSDynamicsDrawerDirectionKernelForDirection(currentDrawerDirection);
+    
+    self.drawerViewController = ((currentDrawerDirection != MSDynamicsDrawerDirectionNone) ? [self drawerViewControllerForDirection:currentDrawerDirection] : nil);
+    
+    // Disable pane view interaction when not closed
+    [self setPaneViewControllerViewUserInteractionEnabled:(currentDrawerDirection == MSDynamicsDrawerDirectionNone)];
+    
+    if (self.paneUpdateCoalescingEnabled) {
+        [self setNeedsPaneViewUpdate];
+    } else {
+        [self updateStylers];
+    }
+}
+
+#pragma mark Possible Reveal Direction
+
+- (void)setPossibleDrawerDirection:(MSDynamicsDrawerDirection)possibleDrawerDirection
+{
+    NSAssert(MSDynamicsDrawerDirectionIsValid(possibleDrawerDirection), @"Only accepts valid reveal directions as possible reveal direction");
+    _possibleDrawerDirection = possibleDrawerDirection;
+    // Possible directions always share an axis, so the kernel of any of them describes the axis of a pan
+    _possibleDirectionKernel = MSDynamicsDrawerDirectionKernelForDirection(possibleDrawerDirection & -possibleDrawerDirection);
+}
+
+#pragma mark Reveal Width
+
+- (CGFloat)revealWidthForDirection:(MSDynamicsDrawerDirection)direction;
+{
+    NSAssert(MSDynamicsDrawerDirectionIsValid(direction), @"Only accepts cardinal directions when querying for reveal width");
+    if (!MSDynamicsDrawerDirectionIsCardinal(direction)) {
+        return MSDynamicsDrawerDefaultRevealWidthForDirection(direction);
+    }
+    return _directionConfigurations[MSDynamicsDrawerCardinalDirectionIndex(direction)].revealWidth;
+}
+
+- (void)setRevealWidth:(CGFloat)revealWidth forDirection:(MSDynamicsDrawerDirection)direction
+{
+    NSAssert((self.paneState == MSDynamicsDrawerPaneStateClosed), @"Only able to update the reveal width while the pane view is closed");
+    MSDynamicsDrawerDirectionActionForMaskedValues(direction, ^(MSDynamicsDrawerDirection maskedValue){
+        // A reveal width of zero restores the default for the direction
+        self->_directionConfigurations[MSDynamicsDrawerCardinalDirectionIndex(maskedValue)].revealWidth = ((revealWidth != 0.0) ? revealWidth : MSDynamicsDrawerDefaultRevealWidthForDirection(maskedValue));
+    });
+}
+
+- (CGFloat)openStateRevealWidth
+{
+    return [self revealWidthForDirection:self.currentDrawerDirection];
+}
+
+- (CGFloat)currentRevealWidth
+{
+    return MSDynamicsDrawerGeometryCurrentRevealWidth([self geometryForDirection:self.currentDrawerDirection], self.paneView.frame.origin);
+}
+
+#pragma mark Gestures
+
+- (void)setPaneDragPredictionEnabled:(BOOL)paneDragPredictionEnabled
+{
+    _paneDragPredictionEnabled = paneDragPredictionEnabled;
+    self.panePanGestureRecognizer.capturesCoalescedAndPredictedTouches = paneDragPredictionEnabled;
+}
+
+- (void)setPaneDragPredictionInterval:(NSTimeInterval)paneDragPredictionInterval
+{
+    NSAssert((paneDragPredictionInterval >= 0.0), @"Pane drag prediction interval must be non-negative");
+    _paneDragPredictionInterval = MAX(paneDragPredictionInterval, 0.0);
+}
+
+- (void)setPaneDragRevealEnabled:(BOOL)paneDraggingEnabled forDirection:(MSDynamicsDrawerDirection)direction
+{
+    MSDynamicsDrawerDirectionActionForMaskedValues(direction, ^(MSDynamicsDrawerDirection maskedValue){
+        self->_directionConfigurations[MSDynamicsDrawerCardinalDirectionIndex(maskedValue)].paneDragRevealEnabled = paneDraggingEnabled;
+    });
+}
+
+- (void)setScreenEdgePanThreshold:(CGFloat)screenEdgePanThreshold forDirection:(MSDynamicsDrawerDirection)direction
+{
+    NSParameterAssert(screenEdgePanThreshold >= 0.0);
+    MSDynamicsDrawerDirectionActionForMaskedValues(direction, ^(MSDynamicsDrawerDirection maskedValue){
+        self->_directionConfigurations[MSDynamicsDrawerCardinalDirectionIndex(maskedValue)].screenEdgePanThreshold = screenEdgePanThreshold;
+    });
+}
+
+- (CGFloat)screenEdgePanThresholdForDirection:(MSDynamicsDrawerDirection)direction
+{
+    NSAssert(MSDynamicsDrawerDirectionIsCardinal(direction), @"Only accepts singular directions when querying for the screen edge pan threshold");
+    return _directionConfigurations[MSDynamicsDrawerCardinalDirectionIndex(direction)].screenEdgePanThreshold;
+}
+
+- (BOOL)paneDragRevealEnabledForDirection:(MSDynamicsDrawerDirection)direction
+{
+    NSAssert(MSDynamicsDrawerDirectionIsCardinal(direction), @"Only accepts singular directions when querying for drag reveal enabled");
+    return _directionConfigurations[MSDynamicsDrawerCardinalDirectionIndex(direction)].paneDragRevealEnabled;
+}
+
+- (void)setPaneTapToCloseEnabled:(BOOL)paneTapToCloseEnabled forDirection:(MSDynamicsDrawerDirection)direction
+{
+    MSDynamicsDrawerDirectionActionForMaskedValues(direction, ^(MSDynamicsDrawerDirection maskedValue){
+        self->_directionConfigurations[MSDynamicsDrawerCardinalDirectionIndex(maskedValue)].paneTapToCloseEnabled = paneTapToCloseEnabled;
+    });
+}
+
+- (BOOL)paneTapToCloseEnabledForDirection:(MSDynamicsDrawerDirection)direction
+{
+    NSAssert(MSDynamicsDrawerDirectionIsCardinal(direction), @"Only accepts singular directions when querying for drag reveal enabled");
+    return _directionConfigurations[MSDynamicsDrawerCardinalDirectionIndex(direction)].paneTapToCloseEnabled;
+}
+
+- (BOOL)viewClassIsTouchForwarding:(Class)viewClass
+{
+    // Cache a verdict per view class, so that admitting a touch is a single lookup per superview once the classes in the pane's hierarchy have been seen
+    NSNumber *verdict = self.touchForwardingClassVerdicts[viewClass];
+    if (!verdict) {
+        BOOL touchForwarding = NO;
+        for (Class touchForwardingClass in self.touchForwardingClasses) {
+            if ([viewClass isSubclassOfClass:touchForwardingClass]) {
+                touchForwarding = YES;
+                break;
+            }
+        }
+        verdict = @(touchForwarding);
+        self.touchForwardingClassVerdicts[(id <NSCopying>)viewClass] = verdict;
+    }
+    return [verdict boolValue];
+}
+
+- (void)registerTouchForwardingClass:(Class)touchForwardingClass
+{
+    NSAssert([touchForwardingClass isSubclassOfClass:[UIView class]], @"Registered touch forwarding classes must be a subclass of UIView");
+    [self.touchForwardingClasses addObject:touchForwardingClass];
+    // Verdicts are derived from the registered classes, so they must be recomputed
+    [self.touchForwardingClassVerdicts removeAllObjects];
+}
+
+- (CGFloat)deltaForPanWithStartLocation:(CGPoint)startLocation currentLocation:(CGPoint)currentLocation
+{
+    const MSDynamicsDrawerDirectionKernel *kernel = _possibleDirectionKernel;
+    return (kernel ? MSDynamicsDrawerDirectionKernelAxisComponent(kernel, (CGPoint){(currentLocation.x - startLocation.x), (currentLocation.y - startLocation.y)}) : 0.0);
+}
+
+- (MSDynamicsDrawerDirection)directionForPanWithStartLocation:(CGPoint)startLocation currentLocation:(CGPoint)currentLocation
+{
+    CGFloat delta = [self deltaForPanWithStartLocation:startLocation currentLocation:currentLocation];
+    MSDynamicsDrawerDirection direction = MSDynamicsDrawerDirectionNone;
+    if (self.possibleDrawerDirection & MSDynamicsDrawerDirectionHorizontal) {
+        if (delta > 0.0) {
+            direction = MSDynamicsDrawerDirectionLeft;
+        } else if (delta < 0.0) {
+            direction = MSDynamicsDrawerDirectionRight;
+        }
+    } else if (self.possibleDrawerDirection & MSDynamicsDrawerDirectionVertical) {
+        if (delta > 0.0) {
+            direction = MSDynamicsDrawerDirectionTop;
+        } else if (delta < 0.0) {
+            direction = MSDynamicsDrawerDirectionBottom;
+        }
+    }
+    return direction;
+}
+
+- (CGRect)paneViewFrameForPanWithStartLocation:(CGPoint)startLocation currentLocation:(CGPoint)currentLocation bounded:(inout BOOL *)bounded
+{
+    // Track the pane frame to the pan gesture
+    CGRect paneFrame = self.paneView.frame;
+    const MSDynamicsDrawerDirectionKernel *possibleKernel = _possibleDirectionKernel;
+    if (possibleKernel) {
+        CGPoint panOffset = MSDynamicsDrawerDirectionKernelPointAlongAxis(possibleKernel, [self deltaForPanWithStartLocation:startLocation currentLocation:currentLocation]);
+        paneFrame.origin.x += panOffset.x;
+        paneFrame.origin.y += panOffset.y;
+    }
+    // Pane view edge bounding, between the closed location and the open location of the current direction
+    const MSDynamicsDrawerDirectionKernel *kernel = _currentDirectionKernel;
+    if (!kernel) {
+        *bounded = NO;
+        return paneFrame;
+    }
+    CGFloat paneBoundOpenLocation = (kernel->sign * [self openStateRevealWidth]);
+    CGFloat paneBoundMinimumLocation = MIN(paneBoundOpenLocation, 0.0);
+    CGFloat paneBoundMaximumLocation = MAX(paneBoundOpenLocation, 0.0);
+    CGFloat paneLocation = MSDynamicsDrawerDirectionKernelAxisComponent(kernel, paneFrame.origin);
+    CGFloat boundedPaneLocation = MIN(MAX(paneLocation, paneBoundMinimumLocation), paneBoundMaximumLocation);
+    *bounded = ((paneLocation <= paneBoundMinimumLocation) || (paneLocation >= paneBoundMaximumLocation));
+    CGPoint boundingOffset = MSDynamicsDrawerDirectionKernelPointAlongAxis(kernel, (boundedPaneLocation - paneLocation));
+    paneFrame.origin.x += boundingOffset.x;
+    paneFrame.origin.y += boundingOffset.y;
+    return paneFrame;
+}
+
+- (CGFloat)velocityForPanVelocity:(CGPoint)panVelocity
+{
+    const MSDynamicsDrawerDirectionKernel *kernel = _possibleDirectionKernel;
+    CGFloat velocity = (kernel ? MSDynamicsDrawerDirectionKernelAxisComponent(kernel, panVelocity) : 0.0);
+    // Express the velocity in points per reference interval, which the velocity threshold and multiplier are tuned to
+    return (velocity * MSPaneViewVelocityReferenceInterval);
+}
+
+- (CGPoint)predictedPaneViewOriginForPanTracker:(const MSPanTracker *)panTracker
+{
+    // Extrapolate the pan slightly past the release, so that a slow release resolves to the state that the user is moving towards
+    CGPoint paneViewOrigin = self.paneView.frame.origin;
+    if (panTracker->sampleCount == 0) {
+        return paneViewOrigin;
+    }
+    CGPoint latestLocation = MSPanTrackerSampleAtAge(panTracker, 0).location;
+    CGPoint predictedLocation = MSPanTrackerPredictedLocation(panTracker, MSPanTrackerReleasePredictionInterval);
+    const MSDynamicsDrawerDirectionKernel *kernel = _possibleDirectionKernel;
+    if (kernel) {
+        CGPoint predictedOffset = MSDynamicsDrawerDirectionKernelPointAlongAxis(kernel, [self deltaForPanWithStartLocation:latestLocation currentLocation:predictedLocation]);
+        paneViewOrigin.x += predictedOffset.x;
+        paneViewOrigin.y += predictedOffset.y;
+    }
+    return paneViewOrigin;
+}
+
+- (MSDynamicsDrawerPaneState)paneStateForPanVelocity:(CGFloat)panVelocity
+{
+    // A velocity along the current direction's signed axis opens the pane
+    const MSDynamicsDrawerDirectionKernel *kernel = _currentDirectionKernel;
+    return ((kernel && ((kernel->sign * panVelocity) > 0.0)) ? MSDynamicsDrawerPaneStateOpen : MSDynamicsDrawerPaneStateClosed);
+}
+
+- (UIRectEdge)edgesOfView:(UIView *)view forPanStartLocation:(CGPoint)startLocation
+{
+    UIEdgeInsets distanceToEdges = UIEdgeInsetsMake(startLocation.y, startLocation.x, (view.bounds.size.height - startLocation.y), (view.bounds.size.width - startLocation.x));
+    UIRectEdge rectEdge = UIRectEdgeNone;
+    if (distanceToEdges.top < [self screenEdgePanThresholdForDirection:MSDynamicsDrawerDirectionTop]) {
+        rectEdge |= UIRectEdgeTop;
+    }
+    if (distanceToEdges.left < [self screenEdgePanThresholdForDirection:MSDynamicsDrawerDirectionLeft]) {
+        rectEdge |= UIRectEdgeLeft;
+    }
+    if (distanceToEdges.right < [self screenEdgePanThresholdForDirection:MSDynamicsDrawerDirectionRight]) {
+        rectEdge |= UIRectEdgeRight;
+    }
+    if (distanceToEdges.bottom < [self screenEdgePanThresholdForDirection:MSDynamicsDrawerDirectionBottom]) {
+        rectEdge |= UIRectEdgeBottom;
+    }
+    return rectEdge;
+}
+
+- (const MSPanEdgeArbitration *)resolvedPanEdgeArbitration
+{
+    MSPanEdgeArbitration *arbitration = &_panEdgeArbitration;
+    if (arbitration->resolved) {
+        return arbitration;
+    }
+    if (!arbitration->started) {
+        // Arbitration that wasn't preceded by a touch falls back to the start location of the pan, which is kept for the rest of the arbitration
+        CGPoint translation = [self.panePanGestureRecognizer translationInView:self.paneView];
+        CGPoint currentLocation = [self.panePanGestureRecognizer locationInView:self.paneView];
+        arbitration->startLocation = (CGPoint){(currentLocation.x - translation.x), (currentLocation.y - translation.y)};
+    }
+    // `UIRectEdge` and `MSDynamicsDrawerDirection` share their bit values, so the edges can be masked by directions
+    arbitration->edges = [self edgesOfView:self.paneView forPanStartLocation:arbitration->startLocation];
+    arbitration->revealableDirection = MSDynamicsDrawerDirectionNone;
+    MSDynamicsDrawerDirectionActionForMaskedValues((arbitration->edges & self.possibleDrawerDirection), ^(MSDynamicsDrawerDirection maskedValue){
+        if ([self paneDragRevealEnabledForDirection:maskedValue]) {
+            arbitration->revealableDirection |= maskedValue;
+        }
+    });
+    arbitration->resolved = YES;
+    return arbitration;
+}
+
+- (NSTimeInterval)timestampForPanGestureRecognizer:(MSDynamicsDrawerPanGestureRecognizer *)gestureRecognizer
+{
+    // Prefer the timestamp of the touch that drove the pan, falling back to the current time if there is none (e.g. a programmatically driven recognizer)
+    NSTimeInterval timestamp = gestureRecognizer.latestTouchTimestamp;
+    return ((timestamp > 0.0) ? timestamp : CACurrentMediaTime());
+}
+
+- (void)addSamplesForPanGestureRecognizer:(MSDynamicsDrawerPanGestureRecognizer *)gestureRecognizer toPanTracker:(MSPanTracker *)panTracker
+{
+    // Sample in a coordinate space that doesn't move with the pane. Coalesced touches report the intermediate touch locations that were received since the last event.
+    NSArray *coalescedTouches = gestureRecognizer.coalescedTouches;
+    if (coalescedTouches.count != 0) {
+        for (UITouch *touch in coalescedTouches) {
+            MSPanTrackerAddSample(panTracker, [touch locationInView:self.view], touch.timestamp);
+        }
+    } else {
+        MSPanTrackerAddSample(panTracker, [gestureRecognizer locationInView:self.view], [self timestampForPanGestureRecognizer:gestureRecognizer]);
+    }
+}
+
+- (CGPoint)predictedPanOffsetForPanGestureRecognizer:(MSDynamicsDrawerPanGestureRecognizer *)gestureRecognizer panTracker:(const MSPanTracker *)panTracker
+{
+    if (panTracker->sampleCount == 0) {
+        return CGPointZero;
+    }
+    MSPanTrackerSample latestSample = MSPanTrackerSampleAtAge(panTracker, 0);
+    CFTimeInterval horizonTimestamp = (latestSample.timestamp + self.paneDragPredictionInterval);
+    // Use the furthest predicted touch that falls within the prediction horizon
+    UITouch *predictedTouch;
+    for (UITouch *touch in gestureRecognizer.predictedTouches) {
+        if (touch.timestamp > horizonTimestamp) {
+            break;
+        }
+        predictedTouch = touch;
+    }
+    // If the system doesn't provide predicted touches, extrapolate the tracked samples
+    CGPoint predictedLocation = (predictedTouch ? [predictedTouch locationInView:self.view] : MSPanTrackerPredictedLocation(panTracker, self.paneDragPredictionInterval));
+    return (CGPoint){(predictedLocation.x - latestSample.location.x), (predictedLocation.y - latestSample.location.y)};
+}
+
+#pragma mark User Interaction
+
+- (void)setViewUserInteractionEnabled:(BOOL)enabled
+{
+    if (!enabled) {
+        _viewUserInteractionDisableCount++;
+    } else {
+        _viewUserInteractionDisableCount = MAX((_viewUserInteractionDisableCount - 1), 0);
+    }
+    self.view.userInteractionEnabled = (_viewUserInteractionDisableCount == 0);
+}
+
+#pragma mark Nested Drawers
+
+- (MSDynamicsDrawerViewController *)enclosingDynamicsDrawerViewController
+{
+    for (UIViewController *viewController = self.parentViewController; viewController; viewController = viewController.parentViewController) {
+        if ([viewController isKindOfClass:[MSDynamicsDrawerViewController class]]) {
+            return (MSDynamicsDrawerViewController *)viewController;
+        }
+    }
+    return nil;
+}
+
+- (MSDynamicsDrawerViewController *)nestedDynamicsDrawerViewControllerForGestureRecognizer:(UIGestureRecognizer *)gestureRecognizer
+{
+    // Only the pane pan of a drawer nested directly within this one (with arbitration enabled) is arbitrated against
+    if (![gestureRecognizer isKindOfClass:[MSDynamicsDrawerPanGestureRecognizer class]] || ![gestureRecognizer.delegate isKindOfClass:[MSDynamicsDrawerViewController class]]) {
+        return nil;
+    }
+    MSDynamicsDrawerViewController *nestedDynamicsDrawerViewController = (MSDynamicsDrawerViewController *)gestureRecognizer.delegate;
+    if ((nestedDynamicsDrawerViewController == self) || !nestedDynamicsDrawerViewController.nestedDrawerGestureArbitrationEnabled) {
+        return nil;
+    }
+    if (gestureRecognizer != nestedDynamicsDrawerViewController.panePanGestureRecognizer) {
+        return nil;
+    }
+    return ((nestedDynamicsDrawerViewController.enclosingDynamicsDrawerViewController == self) ? nestedDynamicsDrawerViewController : nil);
+}
+
+- (BOOL)panePanCanBeHandledForNestedDrawerArbitration
+{
+    MSDynamicsDrawerPaneState paneState;
+    // An opened pane always handles the pan, as it can be closed in either direction
+    if (![self paneViewIsPositionedInValidState:&paneState] || (paneState != MSDynamicsDrawerPaneStateClosed)) {
+        return YES;
+    }
+    // When closed, yield pans that can't reveal one of this drawer's directions to the enclosing drawer. The start location is the one that the touch sequence's edge arbitration resolved, in the coordinate space of the `paneView`.
+    CGPoint startLocation = [self resolvedPanEdgeArbitration]->startLocation;
+    CGPoint currentLocation = [self.panePanGestureRecognizer locationInView:self.paneView];
+    MSDynamicsDrawerDirection direction = [self directionForPanWithStartLocation:startLocation currentLocation:currentLocation];
+    return ((direction & self.possibleDrawerDirection) && [self paneDragRevealEnabledForDirection:direction]);
+}
+
+- (void)setPaneViewControllerViewUserInteractionEnabled:(BOOL)enabled
+{
+    self.paneViewController.view.userInteractionEnabled = enabled;
+}
+
+#pragma mark UIGestureRecognizer Callbacks
+
+- (void)paneTapped:(UIPanGestureRecognizer *)gestureRecognizer
+{
+    if ([self paneTapToCloseEnabledForDirection:self.currentDrawerDirection]) {
+        if (![self paneMotionCoalescesWithPaneState:MSDynamicsDrawerPaneStateClosed pushMagnitude:0.0]) {
+            [self beginTransitionWithKind:MSDynamicsDrawerTransitionKindTapToClose];
+        }
+        [self addDynamicsBehaviorsToCreatePaneState:MSDynamicsDrawerPaneStateClosed];
+    }
+}
+
+- (void)panePanned:(MSDynamicsDrawerPanGestureRecognizer *)gestureRecognizer
+{
+    MSPanTracker *panTracker = &_panTracker;
+    
+    // Record the delivery before it's handled, as handling it can cancel the gesture
+    MSDynamicsDrawerGestureRecorder *gestureRecorder = self.gestureRecorder;
+    if (gestureRecorder.isRecording) {
+        [gestureRecorder recordSampleWithState:gestureRecognizer.state location:[gestureRecognizer locationInView:self.view] timestamp:[self timestampForPanGestureRecognizer:gestureRecognizer] ofDynamicsDrawerViewController:self];
+    }
+    
+    switch (gestureRecognizer.state) {
+        case UIGestureRecognizerStateBegan: {
+            // Catch the pane if it's in a Core Animation transition
+            [self cancelCoreAnimationTransition];
+            // Initialize the per-gesture pan state
+            MSPanTrackerBegin(panTracker, [gestureRecognizer locationInView:self.paneView], self.currentDrawerDirection);
+            [self addSamplesForPanGestureRecognizer:gestureRecognizer toPanTracker:panTracker];
+            break;
+        }
+        case UIGestureRecognizerStateChanged: {
+            CGPoint currentPanLocation = [gestureRecognizer locationInView:self.paneView];
+            MSDynamicsDrawerDirection currentPanDirection = [self directionForPanWithStartLocation:panTracker->startLocation currentLocation:currentPanLocation];
+            // If there's no current direction, try to determine it
+            if (self.currentDrawerDirection == MSDynamicsDrawerDirectionNone) {
+                MSDynamicsDrawerDirection currentDrawerDirection = MSDynamicsDrawerDirectionNone;
+                // If a direction has not yet been previousy determined, use the pan direction
+                if (panTracker->direction == MSDynamicsDrawerDirectionNone) {
+                    currentDrawerDirection = currentPanDirection;
+                } else {
+                    // Only allow a new direction to be in the same direction as before to prevent swiping between drawers in one gesture
+                    if (currentPanDirection == panTracker->direction) {
+                        currentDrawerDirection = panTracker->direction;
+                    }
+                }
+                // If the new direction is still none, don't continue
+                if (currentDrawerDirection == MSDynamicsDrawerDirectionNone) {
+                    return;
+                }
+                // Ensure that the new current direction is:
+                if ((self.possibleDrawerDirection & currentDrawerDirection) &&         // Possible
+                    ([self paneDragRevealEnabledForDirection:currentDrawerDirection])) // Has drag to reveal enabled
+                {
+                    self.currentDrawerDirection = currentDrawerDirection;
+                    // Establish the initial drawer direction if there was none
+                    if (panTracker->direction == MSDynamicsDrawerDirectionNone) {
+                        panTracker->direction = self.currentDrawerDirection;
+                    }
+                }
+                // If these criteria aren't met, cancel the gesture
+                else {
+                    gestureRecognizer.enabled = NO;
+                    gestureRecognizer.enabled = YES;
+                    return;
+                }
+            }
+            // If the current reveal direction's pane drag reveal is disabled, cancel the gesture
+            else if (![self paneDragRevealEnabledForDirection:self.currentDrawerDirection]) {
+                gestureRecognizer.enabled = NO;
+                gestureRecognizer.enabled = YES;
+                return;
+            }
+            // At this point, panning is able to move the pane independently from the motion engine, so stop it to prevent conflicting frames
+            [self.paneMotionEngine stopMotion];
+            [self beginTransitionSnapshotsIfNeeded];
+            if (!panTracker->movedPane) {
+                panTracker->movedPane = YES;
+                [self beginTransitionWithKind:MSDynamicsDrawerTransitionKindGesture];
+            }
+            // Sample the pan location for the release velocity (and the prediction, if enabled)
+            [self addSamplesForPanGestureRecognizer:gestureRecognizer toPanTracker:panTracker];
+            // Place the pane ahead of the touch by the predicted offset. As the pan frame is derived from the touch location within the pane, the previous offset is cancelled out, and the pan frame bounding clamps the predicted frame.
+            CGPoint paneFramePanLocation = currentPanLocation;
+            if (self.paneDragPredictionEnabled) {
+                CGPoint predictedPanOffset = [self predictedPanOffsetForPanGestureRecognizer:gestureRecognizer panTracker:panTracker];
+                paneFramePanLocation.x += predictedPanOffset.x;
+                paneFramePanLocation.y += predictedPanOffset.y;
+            }
+            // Update the pane frame based on the pan gesture
+            BOOL paneViewFrameBounded;
+            CGRect paneViewFrame = [self paneViewFrameForPanWithStartLocation:panTracker->startLocation currentLocation:paneFramePanLocation bounded:&paneViewFrameBounded];
+            // A bounded pan at the reveal limit repeatedly produces the same frame, which doesn't need to be observed again
+            if (!CGRectEqualToRect(self.paneView.frame, paneViewFrame)) {
+                self.paneView.frame = paneViewFrame;
+            }
+            // If the drawer is being swiped into the closed state, set the direciton to none and the state to closed since the user is manually doing so
+            if ((self.currentDrawerDirection != MSDynamicsDrawerDirectionNone) &&
+                (currentPanDirection != MSDynamicsDrawerDirectionNone) &&
+                CGPointEqualToPoint(self.paneView.frame.origin, [self paneViewOriginForPaneState:MSDynamicsDrawerPaneStateClosed])) {
+                [self _setPaneState:MSDynamicsDrawerPaneStateClosed];
+                self.currentDrawerDirection = MSDynamicsDrawerDirectionNone;
+            }
+            break;
+        }
+        case UIGestureRecognizerStateEnded: {
+            if (self.currentDrawerDirection != MSDynamicsDrawerDirectionNone) {
+                CGFloat paneVelocity = [self velocityForPanVelocity:MSPanTrackerVelocity(panTracker, [self timestampForPanGestureRecognizer:gestureRecognizer])];
+                // If the user released the pane over the velocity threshold
+                if (fabs(paneVelocity) > MSPaneViewVelocityThreshold) {
+                    MSDynamicsDrawerPaneState state = [self paneStateForPanVelocity:paneVelocity];
+                    [self addDynamicsBehaviorsToCreatePaneState:state pushMagnitude:(fabs(paneVelocity) * MSPaneViewVelocityMultiplier) pushAngle:[self gravityAngleForState:state direction:self.currentDrawerDirection] pushElasticity:self.elasticity];
+                }
+                // If not released with a velocity over the threhold, update to nearest `paneState`
+                else {
+                    [self addDynamicsBehaviorsToCreatePaneState:[self nearestPaneStateForPaneViewOrigin:[self predictedPaneViewOriginForPanTracker:panTracker]]];
+                }
+            }
+            // If the pan didn't result in a motion towards rest, there's nothing left to snapshot for and the stylers can be given a resting layout
+            if (!self.paneMotionEngine.isRunning) {
+                [self endTransitionSnapshots];
+                [self updateStylers];
+                [self finishTransitionMetricsInterrupted:NO];
+                [self finishPaneMotionCompletions];
+            }
+            break;
+        }
+        case UIGestureRecognizerStateCancelled: {
+            if (!self.paneMotionEngine.isRunning) {
+                [self endTransitionSnapshots];
+                [self updateStylers];
+                [self finishTransitionMetricsInterrupted:NO];
+                [self finishPaneMotionCompletions];
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+#pragma mark - NSKeyValueObserving
+
+- (void)observeValueForKeyPath:(NSString *)keyPath ofObject:(id)object change:(NSDictionary *)change context:(void *)context
+{
+    if ([keyPath isEqualToString:NSStringFromSelector(@selector(frame))] && (object == self.paneView)) {
+        if ([object valueForKeyPath:keyPath] != [NSNull null]) {
+            [self setNeedsPaneViewUpdate];
+        }
+    }
+}
+
+#pragma mark - UIGestureRecognizerDelegate
+
+- (BOOL)gestureRecognizerShouldBegin:(UIGestureRecognizer *)gestureRecognizer
+{
+    if (gestureRecognizer == self.panePanGestureRecognizer) {
+        if ([self.delegate respondsToSelector:@selector(dynamicsDrawerViewController:shouldBeginPanePan:)]) {
+            if (![self.delegate dynamicsDrawerViewController:self shouldBeginPanePan:self.panePanGestureRecognizer]) {
+                return NO;
+            }
+        }
+        if (self.paneDragRequiresScreenEdgePan) {
+            MSDynamicsDrawerPaneState paneState;
+            if ([self paneViewIsPositionedInValidState:&paneState] && (paneState == MSDynamicsDrawerPaneStateClosed)) {
+                // Only begin if the pan started on an edge with a drawer that can be revealed by dragging
+                return ([self resolvedPanEdgeArbitration]->revealableDirection != MSDynamicsDrawerDirectionNone);
+            }
+        }
+        if (self.nestedDrawerGestureArbitrationEnabled && self.enclosingDynamicsDrawerViewController && ![self panePanCanBeHandledForNestedDrawerArbitration]) {
+            return NO;
+        }
+    }
+	return YES;
+}
+
+- (BOOL)gestureRecognizer:(UIGestureRecognizer *)gestureRecognizer shouldReceiveTouch:(UITouch *)touch
+{
+    if (gestureRecognizer == self.panePanGestureRecognizer) {
+        // The first touch of a sequence starts a new pan, so the previous pan's edge arbitration no longer applies
+        if ((self.panePanGestureRecognizer.state == UIGestureRecognizerStatePossible) && (self.panePanGestureRecognizer.numberOfTouches == 0)) {
+            _panEdgeArbitration = (MSPanEdgeArbitration){
+                .started = YES,
+                .resolved = NO,
+                .startLocation = [touch locationInView:self.paneView]
+            };
+        }
+        // Walk the view's superviews up to the pane view. If the touch was in a touch forwarding view, don't handle the gesture.
+        for (UIView *view = touch.view; (view && (view != self.paneView)); view = view.superview) {
+            if ([self viewClassIsTouchForwarding:[view class]]) {
+                return NO;
+            }
+        }
+        return YES;
+    } else if (gestureRecognizer == self.paneTapGestureRecognizer) {
+        MSDynamicsDrawerPaneState paneState;
+        if ([self paneViewIsPositionedInValidState:&paneState]) {
+            return (paneState != MSDynamicsDrawerPaneStateClosed);
+        }
+    }
+    return YES;
+}
+
+- (BOOL)gestureRecognizer:(UIGestureRecognizer *)gestureRecognizer shouldBeRequiredToFailByGestureRecognizer:(UIGestureRecognizer *)otherGestureRecognizer
+{
+    if ((gestureRecognizer == self.panePanGestureRecognizer) && self.screenEdgePanCancelsConflictingGestures) {
+        // A nested drawer's pane pan takes precedence over this one, so it can't also be required to wait on it
+        if ([self nestedDynamicsDrawerViewControllerForGestureRecognizer:otherGestureRecognizer]) {
+            return NO;
+        }
+        // The decision only depends on the pan's start, so it's resolved once and shared by every other gesture recognizer that's arbitrated against
+        return ([self resolvedPanEdgeArbitration]->revealableDirection != MSDynamicsDrawerDirectionNone);
+    }
+    return NO;
+}
+
+- (BOOL)gestureRecognizer:(UIGestureRecognizer *)gestureRecognizer shouldRequireFailureOfGestureRecognizer:(UIGestureRecognizer *)otherGestureRecognizer
+{
+    // A nested drawer's pane pan is given the first chance to handle the pan, and fails if it can't reveal a drawer in its direction
+    if ((gestureRecognizer == self.panePanGestureRecognizer) && [self nestedDynamicsDrawerViewControllerForGestureRecognizer:otherGestureRecognizer]) {
+        return YES;
+    }
+    // If the other gesture recognizer's view is a `UITableViewCell` instance's internal `UIScrollView`, require failure
+    if ([[otherGestureRecognizer.view nextResponder] isKindOfClass:[UITableViewCell class]] && [otherGestureRecognizer.view isKindOfClass:[UIScrollView class]]) {
+        return YES;
+    }
+    return NO;
+}
+
+#pragma mark - MSDynamicsDrawerPaneMotionEngineDelegate
+
+- (void)paneMotionEngineDidUpdatePaneView:(id <MSDynamicsDrawerPaneMotionEngine>)paneMotionEngine
+{
+    [self setNeedsPaneViewUpdate];
+}
+
+- (void)paneMotionEngineDidComeToRest:(id <MSDynamicsDrawerPaneMotionEngine>)paneMotionEngine
+{
+    [self paneViewDidComeToRest];
+}
+
+#pragma mark - CAAnimationDelegate
+
+- (void)animationDidStop:(CAAnimation *)animation finished:(BOOL)finished
+{
+    // Animations that were removed by cancelling the transition aren't resting states
+    if (!finished || !self.coreAnimationTransitionAnimation) {
+        return;
+    }
+    [self finishCoreAnimationTransition];
+    [self paneViewDidComeToRest];
+}
+
+#pragma mark - Resting
+
+- (void)paneViewDidComeToRest
+{
+    // If the motion engine has come to rest while the `panePanGestureRecognizer` is active, ignore it as it's a side effect of stopping the motion, not a resting state
+    if (self.panePanGestureRecognizer.state != UIGestureRecognizerStatePossible) return;
+    
+    // Since a resting pane state has been reached, we can stop the motion
+    [self.paneMotionEngine stopMotion];
+    
+    // Update the pane state to the nearest pane state
+    [self _setPaneState:[self nearestPaneState]];
+    
+    // Update pane user interaction appropriately
+    [self setPaneViewControllerViewUserInteractionEnabled:(self.paneState == MSDynamicsDrawerPaneStateClosed)];
+    
+    // Restore the live views now that the pane is no longer moving
+    [self endTransitionSnapshots];
+    
+    // Deliver a resting layout to the stylers, so that they can perform any work deferred while the pane was moving
+    [self updateStylers];
+    
+    [self finishTransitionMetricsInterrupted:NO];
+    
+    // Since rotation is disabled while the motion engine is running, we invoke this method to cause rotation to happen (if device rotation has occured during state transition)
+    [UIViewController attemptRotationToDeviceOrientation];
+    
+    [self finishPaneMotionCompletions];
+}
+
+- (void)addPaneMotionCompletion:(void (^)(void))completion
+{
+    [self.paneMotionCompletions addObject:[completion copy]];
+}
+
+- (void)finishPaneMotionCompletions
+{
+    // A motion that was retargeted shares the resting state of the motion that replaced it, so all of their completions are invoked together. Copied first, as completions can begin new motions.
+    NSArray *paneMotionCompletions = [self.paneMotionCompletions copy];
+    [self.paneMotionCompletions removeAllObjects];
+    for (void (^completion)(void) in paneMotionCompletions) {
+        completion();
+    }
+}
+
+@end
+
+@interface MSDynamicsDrawerDynamicsMotionEngine () <UIDynamicAnimatorDelegate>
+{
+    // Boundary paths are cached per pane state and direction, and rebuilt only when the boundary for that pair changes
+    UIBezierPath *_boundaryPaths[MSDynamicsDrawerPaneStateCount][MSDynamicsDrawerCardinalDirectionCount];
+    CGRect _boundaryPathRects[MSDynamicsDrawerPaneStateCount][MSDynamicsDrawerCardinalDirectionCount];
+}
+
+@property (nonatomic, weak) UIView *paneView;
+@property (nonatomic, strong) UIDynamicAnimator *dynamicAnimator;
+@property (nonatomic, strong) UIPushBehavior *panePushBehavior;
+@property (nonatomic, strong) UIDynamicItemBehavior *paneElasticityBehavior;
+@property (nonatomic, strong) UIGravityBehavior *paneGravityBehavior;
+@property (nonatomic, strong) UICollisionBehavior *paneBoundaryCollisionBehavior;
+@property (nonatomic, weak) UIBezierPath *installedBoundaryPath;
+
+@end
+
+@implementation MSDynamicsDrawerDynamicsMotionEngine
+
+@synthesize delegate = _delegate;
+
+#pragma mark - NSObject
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        self.idleTeardownInterval = 5.0;
+    }
+    return self;
+}
+
+#pragma mark - MSDynamicsDrawerPaneMotionEngine
+
+- (BOOL)isRunning
+{
+    return self.dynamicAnimator.isRunning;
+}
+
+- (void)beginMotion:(MSDynamicsDrawerPaneMotion)motion ofPaneView:(UIView *)paneView inReferenceView:(UIView *)referenceView
+{
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(tearDownDynamicAnimator) object:nil];
+    [self prepareDynamicAnimatorForPaneView:paneView inReferenceView:referenceView];
+    
+    // Only replace the collision boundary when it differs from the one that's already installed
+    UIBezierPath *boundaryPath = [self boundaryPathForMotion:motion];
+    if (boundaryPath != self.installedBoundaryPath) {
+        [self.paneBoundaryCollisionBehavior removeAllBoundaries];
+        [self.paneBoundaryCollisionBehavior addBoundaryWithIdentifier:MSDynamicsDrawerBoundaryIdentifier forPath:boundaryPath];
+        self.installedBoundaryPath = boundaryPath;
+    }
+    [self.dynamicAnimator addBehavior:self.paneBoundaryCollisionBehavior];
+    
+    self.paneGravityBehavior.magnitude = motion.gravityMagnitude;
+    self.paneGravityBehavior.angle = motion.gravityAngle;
+    [self.dynamicAnimator addBehavior:self.paneGravityBehavior];
+    
+    // Always installed, so that a retargeted motion doesn't keep the elasticity of the motion it replaced, and so that the initial velocity can be applied through it
+    self.paneElasticityBehavior.elasticity = motion.elasticity;
+    [self.dynamicAnimator addBehavior:self.paneElasticityBehavior];
+    if (!CGPointEqualToPoint(motion.initialVelocity, CGPointZero)) {
+        [self.paneElasticityBehavior addLinearVelocity:motion.initialVelocity forItem:paneView];
+    }
+    
+    if (motion.pushMagnitude != 0.0) {
+        self.panePushBehavior.angle = motion.pushAngle;
+        self.panePushBehavior.magnitude = motion.pushMagnitude;
+        self.panePushBehavior.active = YES;
+        [self.dynamicAnimator addBehavior:self.panePushBehavior];
+    }
+}
+
+- (void)stopMotion
+{
+    [self.dynamicAnimator removeAllBehaviors];
+}
+
+#pragma mark - MSDynamicsDrawerDynamicsMotionEngine
+
+- (UIBezierPath *)boundaryPathForMotion:(MSDynamicsDrawerPaneMotion)motion
+{
+    if (!MSDynamicsDrawerDirectionIsCardinal(motion.direction)) {
+        return [UIBezierPath bezierPathWithRect:motion.boundary];
+    }
+    NSUInteger stateIndex = (NSUInteger)motion.paneState;
+    NSUInteger directionIndex = MSDynamicsDrawerCardinalDirectionIndex(motion.direction);
+    UIBezierPath *boundaryPath = _boundaryPaths[stateIndex][directionIndex];
+    // The boundary encodes the pane size, reveal width, and open wide edge offset, so a change in any of them invalidates the cached path
+    if (!boundaryPath || !CGRectEqualToRect(_boundaryPathRects[stateIndex][directionIndex], motion.boundary)) {
+        boundaryPath = [UIBezierPath bezierPathWithRect:motion.boundary];
+        _boundaryPaths[stateIndex][directionIndex] = boundaryPath;
+        _boundaryPathRects[stateIndex][directionIndex] = motion.boundary;
+    }
+    return boundaryPath;
+}
+
+- (void)prepareDynamicAnimatorForPaneView:(UIView *)paneView inReferenceView:(UIView *)referenceView
+{
+    if ((self.paneView == paneView) && (self.dynamicAnimator.referenceView == referenceView)) {
+        return;
+    }
+    
+    [self.dynamicAnimator removeAllBehaviors];
+    self.paneView = paneView;
+    
+    self.dynamicAnimator = [[UIDynamicAnimator alloc] initWithReferenceView:referenceView];
+    self.dynamicAnimator.delegate = self;
+    
+    self.paneBoundaryCollisionBehavior = [[UICollisionBehavior alloc] initWithItems:@[paneView]];
+    self.paneGravityBehavior = [[UIGravityBehavior alloc] initWithItems:@[paneView]];
+    self.panePushBehavior = [[UIPushBehavior alloc] initWithItems:@[paneView] mode:UIPushBehaviorModeInstantaneous];
+    self.paneElasticityBehavior = [[UIDynamicItemBehavior alloc] initWithItems:@[paneView]];
+    self.installedBoundaryPath = nil;
+    
+    __weak typeof(self) weakSelf = self;
+    self.paneGravityBehavior.action = ^{
+        [weakSelf.delegate paneMotionEngineDidUpdatePaneView:weakSelf];
+    };
+}
+
+- (void)tearDownDynamicAnimator
+{
+    // Recreated by `prepareDynamicAnimatorForPaneView:inReferenceView:` when the next motion begins
+    if (!self.dynamicAnimator || self.dynamicAnimator.isRunning) {
+        return;
+    }
+    [self.dynamicAnimator removeAllBehaviors];
+    self.dynamicAnimator.delegate = nil;
+    self.dynamicAnimator = nil;
+    self.paneBoundaryCollisionBehavior = nil;
+    self.paneGravityBehavior = nil;
+    self.panePushBehavior = nil;
+    self.paneElasticityBehavior = nil;
+    self.installedBoundaryPath = nil;
+    self.paneView = nil;
+    for (NSUInteger stateIndex = 0; stateIndex < MSDynamicsDrawerPaneStateCount; stateIndex++) {
+        for (NSUInteger directionIndex = 0; directionIndex < MSDynamicsDrawerCardinalDirectionCount; directionIndex++) {
+            _boundaryPaths[stateIndex][directionIndex] = nil;
+        }
+    }
+}
+
+- (NSDictionary *)memoryFootprintReport
+{
+    NSUInteger boundaryPathCount = 0;
+    for (NSUInteger stateIndex = 0; stateIndex < MSDynamicsDrawerPaneStateCount; stateIndex++) {
+        for (NSUInteger directionIndex = 0; directionIndex < MSDynamicsDrawerCardinalDirectionCount; directionIndex++) {
+            boundaryPathCount += (_boundaryPaths[stateIndex][directionIndex] ? 1 : 0);
+        }
+    }
+    return @{
+        @"dynamicAnimator" : @(self.dynamicAnimator ? 1 : 0),
+        @"behaviors" : @(self.dynamicAnimator.behaviors.count),
+        @"boundaryPaths" : @(boundaryPathCount)
+    };
+}
+
+#pragma mark - UIDynamicAnimatorDelegate
+
+- (void)dynamicAnimatorDidPause:(UIDynamicAnimator *)animator
+{
+    // The drawer is at rest most of the time, so release the physics world once it has been idle for long enough
+    if (self.idleTeardownInterval >= 0.0) {
+        [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(tearDownDynamicAnimator) object:nil];
+        [self performSelector:@selector(tearDownDynamicAnimator) withObject:nil afterDelay:self.idleTeardownInterval];
+    }
+    [self.delegate paneMotionEngineDidComeToRest:self];
+}
+
+@end
+
+@interface MSDynamicsDrawerSpringMotionEngine ()
+
+@property (nonatomic, assign, getter = isRunning) BOOL running;
+@property (nonatomic, weak) UIView *paneView;
+@property (nonatomic, assign) BOOL horizontal;
+@property (nonatomic, assign) CGPoint targetPaneViewOrigin;
+@property (nonatomic, assign) MSSpringMotionParameters parameters;
+@property (nonatomic, assign) CFTimeInterval startTimestamp;
+@property (nonatomic, assign) CFTimeInterval previousTimestamp;
+@property (nonatomic, assign) CGFloat previousDisplacement;
+@property (nonatomic, assign) CGFloat previousVelocity;
+
+@end
+
+@implementation MSDynamicsDrawerSpringMotionEngine
+
+@synthesize delegate = _delegate;
+
+#pragma mark - NSObject
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        self.response = 0.5;
+        self.dampingRatio = 1.0;
+    }
+    return self;
+}
+
+#pragma mark - MSDynamicsDrawerPaneMotionEngine
+
+- (void)beginMotion:(MSDynamicsDrawerPaneMotion)motion ofPaneView:(UIView *)paneView inReferenceView:(UIView *)referenceView
+{
+    // A motion that retargets a running one continues from the pane's current velocity along the same axis
+    BOOL horizontal = ((motion.direction & MSDynamicsDrawerDirectionHorizontal) != 0);
+    CGFloat retargetedVelocity = ((self.isRunning && (self.paneView == paneView) && (self.horizontal == horizontal)) ? self.previousVelocity : 0.0);
+    
+    self.paneView = paneView;
+    self.horizontal = horizontal;
+    self.targetPaneViewOrigin = motion.targetPaneViewOrigin;
+    MSSpringMotionParameters parameters = [self parametersForMotion:motion ofPaneView:paneView];
+    parameters.initialVelocity += retargetedVelocity;
+    self.parameters = parameters;
+    
+    self.startTimestamp = CACurrentMediaTime();
+    self.previousTimestamp = self.startTimestamp;
+    self.previousDisplacement = self.parameters.initialDisplacement;
+    self.previousVelocity = self.parameters.initialVelocity;
+    self.running = YES;
+}
+
+- (NSArray *)paneViewOriginsForMotion:(MSDynamicsDrawerPaneMotion)motion ofPaneView:(UIView *)paneView sampleInterval:(CFTimeInterval)sampleInterval
+{
+    NSParameterAssert(sampleInterval > 0.0);
+    BOOL horizontal = ((motion.direction & MSDynamicsDrawerDirectionHorizontal) != 0);
+    MSSpringMotionParameters parameters = [self parametersForMotion:motion ofPaneView:paneView];
+    NSMutableArray *paneViewOrigins = [NSMutableArray new];
+    // Sample the spring with the same rest detection as when stepping it, with an upper bound in case it never rests
+    CGFloat previousDisplacement = parameters.initialDisplacement;
+    for (NSUInteger sample = 0; ; sample++) {
+        CFTimeInterval time = (sample * sampleInterval);
+        CGFloat displacement = MSSpringMotionDisplacement(parameters, time);
+        CGFloat velocity = ((displacement - previousDisplacement) / sampleInterval);
+        BOOL resting = (((sample != 0) && MSSpringMotionIsResting(displacement, velocity)) || (time >= MSSpringMotionMaximumPredictedDuration));
+        if (resting) {
+            displacement = 0.0;
+        }
+        CGPoint paneViewOrigin = motion.targetPaneViewOrigin;
+        if (horizontal) {
+            paneViewOrigin.x += displacement;
+        } else {
+            paneViewOrigin.y += displacement;
+        }
+        [paneViewOrigins addObject:[NSValue valueWithCGPoint:paneViewOrigin]];
+        if (resting) {
+            break;
+        }
+        previousDisplacement = displacement;
+    }
+    return paneViewOrigins;
+}
+
+- (void)stopMotion
+{
+    if (!self.isRunning) {
+        return;
+    }
+    self.running = NO;
+    [self.delegate paneMotionEngineDidComeToRest:self];
+}
+
+- (void)stepMotionToTimestamp:(CFTimeInterval)timestamp
+{
+    if (!self.isRunning) {
+        return;
+    }
+    
+    CGFloat displacement = MSSpringMotionDisplacement(self.parameters, MAX((timestamp - self.startTimestamp), 0.0));
+    CFTimeInterval interval = (timestamp - self.previousTimestamp);
+    CGFloat velocity = ((interval > 0.0) ? ((displacement - self.previousDisplacement) / interval) : 0.0);
+    self.previousTimestamp = timestamp;
+    self.previousDisplacement = displacement;
+    self.previousVelocity = velocity;
+    
+    BOOL resting = MSSpringMotionIsResting(displacement, velocity);
+    if (resting) {
+        displacement = 0.0;
+    }
+    
+    [self positionPaneViewAtDisplacement:displacement];
+    [self.delegate paneMotionEngineDidUpdatePaneView:self];
+    
+    if (resting) {
+        self.running = NO;
+        [self.delegate paneMotionEngineDidComeToRest:self];
+    }
+}
+
+#pragma mark - MSDynamicsDrawerSpringMotionEngine
+
+- (MSSpringMotionParameters)parametersForMotion:(MSDynamicsDrawerPaneMotion)motion ofPaneView:(UIView *)paneView
+{
+    BOOL horizontal = ((motion.direction & MSDynamicsDrawerDirectionHorizontal) != 0);
+    MSSpringMotionParameters parameters;
+    
+    CGPoint paneViewOrigin = paneView.frame.origin;
+    parameters.initialDisplacement = (horizontal ? (paneViewOrigin.x - motion.targetPaneViewOrigin.x) : (paneViewOrigin.y - motion.targetPaneViewOrigin.y));
+    
+    // The pane bounces on the side of the target that it starts on, such as past an open target when moving from open wide. Only a pane that starts at its target takes its side from gravity, which pulls the pane towards the target from the opposite side (where the boundary is).
+    if (parameters.initialDisplacement != 0.0) {
+        parameters.displacementSide = copysign(1.0, parameters.initialDisplacement);
+    } else {
+        CGFloat gravityComponent = (horizontal ? cos(motion.gravityAngle) : sin(motion.gravityAngle));
+        parameters.displacementSide = ((gravityComponent > 0.0) ? -1.0 : 1.0);
+    }
+    
+    // An instantaneous push of magnitude 1.0 gives a 100 point x 100 point item a velocity of 100 points / second, as in UIKit Dynamics
+    CGFloat paneViewMass = MAX(((CGRectGetWidth(paneView.bounds) * CGRectGetHeight(paneView.bounds)) / (100.0 * 100.0)), 1.0);
+    CGFloat pushVelocity = ((motion.pushMagnitude * 100.0) / paneViewMass);
+    parameters.initialVelocity = ((pushVelocity * (horizontal ? cos(motion.pushAngle) : sin(motion.pushAngle))) + (horizontal ? motion.initialVelocity.x : motion.initialVelocity.y));
+    
+    parameters.angularFrequency = ((2.0 * M_PI) / MAX(self.response, 0.01));
+    parameters.dampingRatio = MAX((self.dampingRatio * (1.0 - motion.elasticity)), MSSpringMotionMinimumDampingRatio);
+    return parameters;
+}
+
+- (void)positionPaneViewAtDisplacement:(CGFloat)displacement
+{
+    CGPoint paneViewOrigin = self.targetPaneViewOrigin;
+    if (self.horizontal) {
+        paneViewOrigin.x += displacement;
+    } else {
+        paneViewOrigin.y += displacement;
+    }
+    CGSize paneViewSize = self.paneView.bounds.size;
+    // Move the pane view by its center, as UIKit Dynamics does
+    self.paneView.center = (CGPoint){(paneViewOrigin.x + (paneViewSize.width / 2.0)), (paneViewOrigin.y + (paneViewSize.height / 2.0))};
+}
+
+@end
+
+@interface MSDynamicsDrawerStatusBarTransformAligner ()
+
+@property (nonatomic, weak) UIView *statusBar;
+@property (nonatomic, assign) BOOL statusBarResolved;
+
+@end
+
+@implementation MSDynamicsDrawerStatusBarTransformAligner
+
+#pragma mark - MSDynamicsDrawerStatusBarAligner
+
+- (void)dynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController alignStatusBarToLayout:(MSDynamicsDrawerLayout)layout
+{
+    UIView *statusBar = [self resolvedStatusBar];
+    CGAffineTransform statusBarTransform = CGAffineTransformMakeTranslation(layout.paneViewFrame.origin.x, layout.paneViewFrame.origin.y);
+    if (statusBar && !CGAffineTransformEqualToTransform(statusBar.transform, statusBarTransform)) {
+        statusBar.transform = statusBarTransform;
+    }
+}
+
+- (void)restoreStatusBarForDynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController
+{
+    self.statusBar.transform = CGAffineTransformIdentity;
+}
+
+#pragma mark - MSDynamicsDrawerStatusBarTransformAligner
+
+- (UIView *)resolvedStatusBar
+{
+    // The status bar is looked up once, rather than for every frame
+    if (!self.statusBarResolved) {
+        self.statusBarResolved = YES;
+        // There's no status bar view to look up on iOS 13 and later, and attempting to do so raises an exception
+        if (@available(iOS 13.0, *)) {
+            return nil;
+        }
+        NSString *key = [[NSString alloc] initWithData:[NSData dataWithBytes:(unsigned char []){0x73, 0x74, 0x61, 0x74, 0x75, 0x73, 0x42, 0x61, 0x72} length:9] encoding:NSASCIIStringEncoding];
+        id object = [UIApplication sharedApplication];
+        if ([object respondsToSelector:NSSelectorFromString(key)]) {
+            self.statusBar = [object valueForKey:key];
+        }
+    }
+    return self.statusBar;
+}
+
+@end
+
+@interface MSDynamicsDrawerStatusBarSnapshotAligner ()
+
+@property (nonatomic, strong) UIView *statusBarSnapshotView;
+@property (nonatomic, assign) BOOL statusBarHidden;
+
+@end
+
+@implementation MSDynamicsDrawerStatusBarSnapshotAligner
+
+#pragma mark - MSDynamicsDrawerStatusBarAligner
+
+- (void)dynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController alignStatusBarToLayout:(MSDynamicsDrawerLayout)layout
+{
+    BOOL paneViewClosed = CGPointEqualToPoint(layout.paneViewFrame.origin, layout.closedPaneViewOrigin);
+    if (paneViewClosed) {
+        [self restoreStatusBarForDynamicsDrawerViewController:dynamicsDrawerViewController];
+        return;
+    }
+    if (!self.statusBarSnapshotView) {
+        [self snapshotStatusBarForDynamicsDrawerViewController:dynamicsDrawerViewController];
+    }
+    // Keep the snapshot above the pane view controller's view, which may have been replaced since the snapshot was added
+    UIView *paneView = dynamicsDrawerViewController.paneView;
+    if (self.statusBarSnapshotView && (paneView.subviews.lastObject != self.statusBarSnapshotView)) {
+        [paneView bringSubviewToFront:self.statusBarSnapshotView];
+    }
+}
+
+- (void)restoreStatusBarForDynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController
+{
+    [self.statusBarSnapshotView removeFromSuperview];
+    self.statusBarSnapshotView = nil;
+    if (self.statusBarHidden) {
+        self.statusBarHidden = NO;
+        [dynamicsDrawerViewController setNeedsStatusBarAppearanceUpdate];
+    }
+}
+
+- (BOOL)statusBarHiddenForDynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController
+{
+    return self.statusBarHidden;
+}
+
+#pragma mark - MSDynamicsDrawerStatusBarSnapshotAligner
+
+- (void)snapshotStatusBarForDynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController
+{
+    UIView *view = dynamicsDrawerViewController.view;
+    if (!view.window) {
+        return;
+    }
+    CGRect statusBarFrame;
+    if (@available(iOS 13.0, *)) {
+        statusBarFrame = view.window.windowScene.statusBarManager.statusBarFrame;
+    } else {
+        statusBarFrame = [UIApplication sharedApplication].statusBarFrame;
+    }
+    // A hidden status bar has no frame, so there's nothing to represent
+    if (CGRectIsEmpty(statusBarFrame)) {
+        return;
+    }
+    // The snapshot is placed where the status bar is when the pane is closed, so that it moves along with the pane from its closed position
+    UIView *statusBarSnapshotView = [[UIView alloc] initWithFrame:[view convertRect:statusBarFrame fromView:nil]];
+    statusBarSnapshotView.clipsToBounds = YES;
+    statusBarSnapshotView.userInteractionEnabled = NO;
+    // Snapshot the screen that the drawer is displayed on, which isn't necessarily the main screen
+    UIView *screenSnapshotView = [view.window.screen snapshotViewAfterScreenUpdates:NO];
+    screenSnapshotView.frame = (CGRect){{-CGRectGetMinX(statusBarFrame), -CGRectGetMinY(statusBarFrame)}, screenSnapshotView.frame.size};
+    [statusBarSnapshotView addSubview:screenSnapshotView];
+    [dynamicsDrawerViewController.paneView addSubview:statusBarSnapshotView];
+    self.statusBarSnapshotView = statusBarSnapshotView;
+    // Hide the real status bar now that it's represented by the snapshot
+    self.statusBarHidden = YES;
+    [dynamicsDrawerViewController setNeedsStatusBarAppearanceUpdate];
+}
+
+@end
+
+@implementation MSDynamicsDrawerStylerComposition
+
+#pragma mark - NSObject
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        [self reset];
+    }
+    return self;
+}
+
+#pragma mark - MSDynamicsDrawerStylerComposition
+
+- (void)translateDrawerViewBy:(CGPoint)translation
+{
+    _drawerViewTranslation.x += translation.x;
+    _drawerViewTranslation.y += translation.y;
+    _components |= MSDynamicsDrawerStylerCompositionComponentDrawerViewTranslation;
+}
+
+- (void)scaleDrawerViewBy:(CGFloat)scale
+{
+    _drawerViewScale *= scale;
+    _components |= MSDynamicsDrawerStylerCompositionComponentDrawerViewScale;
+}
+
+- (void)fadeDrawerViewBy:(CGFloat)alpha
+{
+    _drawerViewAlpha *= alpha;
+    _components |= MSDynamicsDrawerStylerCompositionComponentDrawerViewAlpha;
+}
+
+- (void)setDrawerViewControllerViewFrame:(CGRect)frame
+{
+    _drawerViewControllerViewFrame = frame;
+    _components |= MSDynamicsDrawerStylerCompositionComponentDrawerViewControllerViewFrame;
+}
+
+- (void)setPaneShadowLayer:(CALayer *)shadowLayer
+{
+    _paneShadowLayer = shadowLayer;
+    _components |= MSDynamicsDrawerStylerCompositionComponentPaneShadowLayer;
+}
+
+- (BOOL)hasContributions
+{
+    return (_components != 0);
+}
+
+- (BOOL)hasDrawerViewTransformContributions
+{
+    return ((_components & (MSDynamicsDrawerStylerCompositionComponentDrawerViewTranslation | MSDynamicsDrawerStylerCompositionComponentDrawerViewScale)) != 0);
+}
+
+- (BOOL)hasDrawerViewAlphaContributions
+{
+    return ((_components & MSDynamicsDrawerStylerCompositionComponentDrawerViewAlpha) != 0);
+}
+
+- (BOOL)hasDrawerViewControllerViewFrameContributions
+{
+    return ((_components & MSDynamicsDrawerStylerCompositionComponentDrawerViewControllerViewFrame) != 0);
+}
+
+- (BOOL)hasPaneShadowLayerContributions
+{
+    return ((_components & MSDynamicsDrawerStylerCompositionComponentPaneShadowLayer) != 0);
+}
+
+- (CGAffineTransform)drawerViewTransformByCompositingTransform:(CGAffineTransform)transform
+{
+    // Only replace the components of the transform that have been contributed to, leaving the rest to any non-compositing stylers
+    if (_components & MSDynamicsDrawerStylerCompositionComponentDrawerViewScale) {
+        transform.a = _drawerViewScale;
+        transform.d = _drawerViewScale;
+    }
+    if (_components & MSDynamicsDrawerStylerCompositionComponentDrawerViewTranslation) {
+        transform.tx = _drawerViewTranslation.x;
+        transform.ty = _drawerViewTranslation.y;
+    }
+    return transform;
+}
+
+- (CGFloat)drawerViewAlpha
+{
+    return _drawerViewAlpha;
+}
+
+- (CALayer *)paneShadowLayer
+{
+    return _paneShadowLayer;
+}
+
+- (void)reset
+{
+    _components = 0;
+    _drawerViewTranslation = CGPointZero;
+    _drawerViewScale = 1.0;
+    _drawerViewAlpha = 1.0;
+    _drawerViewControllerViewFrame = CGRectNull;
+    _paneShadowLayer = nil;
+}
+
+- (void)applyToDrawerView:(UIView *)drawerView drawerViewControllerView:(UIView *)drawerViewControllerView paneView:(UIView *)paneView
+{
+    if (self.hasDrawerViewTransformContributions) {
+        CGAffineTransform drawerViewTransform = [self drawerViewTransformByCompositingTransform:drawerView.transform];
+        if (!CGAffineTransformEqualToTransform(drawerViewTransform, drawerView.transform)) {
+            drawerView.transform = drawerViewTransform;
+        }
+    }
+    if (self.hasDrawerViewAlphaContributions && (drawerView.alpha != _drawerViewAlpha)) {
+        drawerView.alpha = _drawerViewAlpha;
+    }
+    if (self.hasDrawerViewControllerViewFrameContributions && !CGRectEqualToRect(drawerViewControllerView.frame, _drawerViewControllerViewFrame)) {
+        drawerViewControllerView.frame = _drawerViewControllerViewFrame;
+    }
+    [self applyPaneShadowLayerToPaneView:paneView];
+}
+
+- (void)applyPaneShadowLayerToPaneView:(UIView *)paneView
+{
+    if (!self.hasPaneShadowLayerContributions) {
+        return;
+    }
+    if (_appliedPaneShadowLayer != _paneShadowLayer) {
+        [_appliedPaneShadowLayer removeFromSuperlayer];
+        _appliedPaneShadowLayer = _paneShadowLayer;
+    }
+    if (_paneShadowLayer && (_paneShadowLayer.superlayer != paneView.layer)) {
+        [paneView.layer insertSublayer:_paneShadowLayer atIndex:0];
+    }
+}
+
+@end
+
+@implementation MSDynamicsDrawerTransitionMetrics
+
+#pragma mark - NSObject
+
+- (instancetype)initWithKind:(MSDynamicsDrawerTransitionKind)kind direction:(MSDynamicsDrawerDirection)direction startTimestamp:(CFTimeInterval)startTimestamp
+{
+    self = [super init];
+    if (self) {
+        _stylerClassDurations = [NSMutableDictionary new];
+        self.kind = kind;
+        self.direction = direction;
+        self.startTimestamp = startTimestamp;
+        self.endTimestamp = startTimestamp;
+    }
+    return self;
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; kind = %s; duration = %.3f; frames = %lu; dropped = %lu; fps = %.1f; hitch ratio = %.1f ms/s; interrupted = %@>", NSStringFromClass([self class]), self, MSDynamicsDrawerTransitionKindName(self.kind), self.duration, (unsigned long)self.framesRendered, (unsigned long)self.framesDropped, self.achievedFrameRate, self.hitchTimeRatio, (self.isInterrupted ? @"YES" : @"NO")];
+}
+
+#pragma mark - MSDynamicsDrawerTransitionMetrics
+
+- (CFTimeInterval)duration
+{
+    return (self.endTimestamp - self.startTimestamp);
+}
+
+- (double)achievedFrameRate
+{
+    // The rate between the first and last serviced refreshes, as the transition can begin and end between refreshes
+    CFTimeInterval frameDuration = (_lastFrameTimestamp - _firstFrameTimestamp);
+    if ((self.framesRendered < 2) || (frameDuration <= 0.0)) {
+        return 0.0;
+    }
+    return ((self.framesRendered - 1) / frameDuration);
+}
+
+- (double)hitchTimeRatio
+{
+    CFTimeInterval frameDuration = (_lastFrameTimestamp - _firstFrameTimestamp);
+    if ((self.framesRendered < 2) || (frameDuration <= 0.0)) {
+        return 0.0;
+    }
+    return ((self.hitchDuration * 1000.0) / frameDuration);
+}
+
+- (NSDictionary *)stylerClassUpdateDurations
+{
+    NSMutableDictionary *stylerClassUpdateDurations = [NSMutableDictionary dictionaryWithCapacity:_stylerClassDurations.count];
+    [_stylerClassDurations enumerateKeysAndObjectsUsingBlock:^(Class stylerClass, NSNumber *duration, BOOL *stop) {
+        stylerClassUpdateDurations[NSStringFromClass(stylerClass)] = duration;
+    }];
+    return [stylerClassUpdateDurations copy];
+}
+
+- (void)recordFrameAtTimestamp:(CFTimeInterval)timestamp refreshInterval:(CFTimeInterval)refreshInterval
+{
+    // Each refresh that elapsed between two serviced refreshes was dropped
+    if ((self.framesRendered != 0) && (refreshInterval > 0.0)) {
+        NSUInteger elapsedRefreshes = (NSUInteger)round((timestamp - _lastFrameTimestamp) / refreshInterval);
+        if (elapsedRefreshes > 1) {
+            self.framesDropped += (elapsedRefreshes - 1);
+            // The serviced refresh was late by the refresh intervals that were dropped before it
+            CFTimeInterval hitchDuration = ((elapsedRefreshes - 1) * refreshInterval);
+            self.hitchDuration += hitchDuration;
+            self.longestHitchDuration = MAX(self.longestHitchDuration, hitchDuration);
+            if (self.emitsSignposts) {
+                if (@available(iOS 12.0, *)) {
+                    os_signpost_event_emit(MSDynamicsDrawerTransitionsLog(), self.signpostIdentifier, "Hitch", "duration: %.1f ms, dropped: %lu", (hitchDuration * 1000.0), (unsigned long)(elapsedRefreshes - 1));
+                }
+            }
+        }
+    }
+    _lastFrameTimestamp = timestamp;
+    if (self.framesRendered == 0) {
+        _firstFrameTimestamp = timestamp;
+    }
+    self.refreshInterval = refreshInterval;
+    self.framesRendered++;
+}
+
+- (void)recordUpdateDuration:(CFTimeInterval)duration forStylerClass:(Class)stylerClass
+{
+    // Only called once per styler entry when the transition finishes, as the durations are accumulated by the styler tables
+    id <NSCopying> key = (id <NSCopying>)stylerClass;
+    _stylerClassDurations[key] = @([_stylerClassDurations[key] doubleValue] + duration);
+}
+
+- (void)finishWithPaneState:(MSDynamicsDrawerPaneState)paneState interrupted:(BOOL)interrupted endTimestamp:(CFTimeInterval)endTimestamp
+{
+    self.paneState = paneState;
+    self.interrupted = interrupted;
+    self.endTimestamp = endTimestamp;
+}
+
+@end
+
+@implementation MSDynamicsDrawerGestureRecorder
+
+#pragma mark - MSDynamicsDrawerGestureRecorder
+
+- (void)beginRecording
+{
+    // The reference fields of the header are written with the first sample, and the sample count once the recording ends
+    _trace = [NSMutableData dataWithLength:MSGestureTraceHeaderSize];
+    uint8_t *headerBytes = _trace.mutableBytes;
+    memcpy(headerBytes, MSGestureTraceMagic, sizeof(MSGestureTraceMagic));
+    MSGestureTraceWriteUInt16((headerBytes + 4), MSGestureTraceVersion);
+    MSGestureTraceWriteUInt16((headerBytes + 6), (uint16_t)MSGestureTraceSampleSize);
+    _sampleCount = 0;
+    self.recording = YES;
+}
+
+- (NSData *)endRecording
+{
+    if (!self.recording) {
+        return nil;
+    }
+    self.recording = NO;
+    MSGestureTraceWriteUInt32(((uint8_t *)_trace.mutableBytes + 20), (uint32_t)_sampleCount);
+    NSData *trace = [_trace copy];
+    _trace = nil;
+    return trace;
+}
+
+- (void)recordSampleWithState:(UIGestureRecognizerState)state location:(CGPoint)location timestamp:(NSTimeInterval)timestamp ofDynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController
+{
+    NSAssert(self.recording, @"Unable to record a sample when not recording");
+    if (_sampleCount == 0) {
+        uint8_t *headerBytes = _trace.mutableBytes;
+        CGSize referenceSize = dynamicsDrawerViewController.view.bounds.size;
+        MSGestureTraceWriteFloat32((headerBytes + 8), (float)referenceSize.width);
+        MSGestureTraceWriteFloat32((headerBytes + 12), (float)referenceSize.height);
+        headerBytes[16] = (uint8_t)dynamicsDrawerViewController.paneState;
+        headerBytes[17] = (uint8_t)dynamicsDrawerViewController.currentDrawerDirection;
+        _firstSampleTimestamp = timestamp;
+    }
+    // Relative timestamps in microseconds cover traces of over an hour
+    double relativeTimestamp = round((timestamp - _firstSampleTimestamp) * 1000000.0);
+    uint8_t sampleBytes[MSGestureTraceSampleSize] = {0};
+    MSGestureTraceWriteUInt32(sampleBytes, (uint32_t)MIN(MAX(relativeTimestamp, 0.0), (double)UINT32_MAX));
+    sampleBytes[4] = (uint8_t)state;
+    MSGestureTraceWriteFloat32((sampleBytes + 8), (float)location.x);
+    MSGestureTraceWriteFloat32((sampleBytes + 12), (float)location.y);
+    [_trace appendBytes:sampleBytes length:sizeof(sampleBytes)];
+    _sampleCount++;
+}
+
++ (BOOL)enumerateSamplesOfTrace:(NSData *)trace header:(MSDynamicsDrawerGestureTraceHeader *)header usingBlock:(void (^)(MSDynamicsDrawerGestureTraceSample sample, BOOL *stop))block
+{
+    const uint8_t *bytes = trace.bytes;
+    if ((trace.length < MSGestureTraceHeaderSize) || (memcmp(bytes, MSGestureTraceMagic, sizeof(MSGestureTraceMagic)) != 0) || (MSGestureTraceReadUInt16(bytes + 4) != MSGestureTraceVersion)) {
+        return NO;
+    }
+    // Fields can be appended to the samples, but the ones read here are always present
+    NSUInteger sampleSize = MSGestureTraceReadUInt16(bytes + 6);
+    NSUInteger sampleCount = MSGestureTraceReadUInt32(bytes + 20);
+    if ((sampleSize < MSGestureTraceSampleSize) || (((trace.length - MSGestureTraceHeaderSize) / sampleSize) < sampleCount)) {
+        return NO;
+    }
+    if (header) {
+        *header = (MSDynamicsDrawerGestureTraceHeader){
+            .referenceSize = {MSGestureTraceReadFloat32(bytes + 8), MSGestureTraceReadFloat32(bytes + 12)},
+            .paneState = bytes[16],
+            .direction = bytes[17],
+            .sampleCount = sampleCount
+        };
+    }
+    BOOL stop = NO;
+    for (NSUInteger sampleIndex = 0; (block && (sampleIndex < sampleCount) && !stop); sampleIndex++) {
+        const uint8_t *sampleBytes = (bytes + MSGestureTraceHeaderSize + (sampleIndex * sampleSize));
+        MSDynamicsDrawerGestureTraceSample sample = {
+            .state = sampleBytes[4],
+            .timestamp = (MSGestureTraceReadUInt32(sampleBytes) / 1000000.0),
+            .location = {MSGestureTraceReadFloat32(sampleBytes + 8), MSGestureTraceReadFloat32(sampleBytes + 12)}
+        };
+        block(sample, &stop);
+    }
+    return YES;
+}
+
+@end
+
+@implementation MSDynamicsDrawerStylerTable
+
+#pragma mark - NSObject
+
+- (instancetype)initWithStylers:(NSArray *)stylers dynamicsDrawerViewController:(MSDynamicsDrawerViewController *)dynamicsDrawerViewController
+{
+    self = [super init];
+    if (self) {
+        _stylers = [stylers copy];
+        _count = _stylers.count;
+        _entries = calloc(MAX(_count, (NSUInteger)1), sizeof(MSDynamicsDrawerStylerEntry));
+        [_stylers enumerateObjectsUsingBlock:^(id <MSDynamicsDrawerStyler> styler, NSUInteger index, BOOL *stop) {
+            MSDynamicsDrawerStylerEntry *entry = &self->_entries[index];
+            entry->styler = styler;
+            entry->stylerClass = [styler class];
+            // Prefer the richest update method that the styler implements
+            if ([styler respondsToSelector:@selector(dynamicsDrawerViewController:didUpdateLayout:composition:)]) {
+                entry->dispatch = MSDynamicsDrawerStylerDispatchComposition;
+                entry->selector = @selector(dynamicsDrawerViewController:didUpdateLayout:composition:);
+            } else if ([styler respondsToSelector:@selector(dynamicsDrawerViewController:didUpdateLayout:)]) {
+                entry->dispatch = MSDynamicsDrawerStylerDispatchLayout;
+                entry->selector = @selector(dynamicsDrawerViewController:didUpdateLayout:);
+            } else {
+                entry->dispatch = MSDynamicsDrawerStylerDispatchPaneClosedFraction;
+                entry->selector = @selector(dynamicsDrawerViewController:didUpdatePaneClosedFraction:forDirection:);
+            }
+            entry->implementation = [(NSObject *)styler methodForSelector:entry->selector];
+            entry->updateGranularity = MSDynamicsDrawerStylerUpdateGranularityContinuous;
+            if ([styler respondsToSelector:@selector(updateGranularityForDynamicsDrawerViewController:)]) {
+                entry->updateGranularity = [styler updateGranularityForDynamicsDrawerViewController:dynamicsDrawerViewController];
+            }
+            if ([styler respondsToSelector:@selector(updateDistanceForDynamicsDrawerViewController:)]) {
+                entry->updateDistance = [styler updateDistanceForDynamicsDrawerViewController:dynamicsDrawerViewController];
+            }
+        }];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_entries);
+}
+
+#pragma mark - MSDynamicsDrawerStylerTable
+
+- (void)invalidateDeliveries
+{
+    _compositionDelivery.delivered = NO;
+    for (NSUInteger index = 0; index < _count; index++) {
+        _entries[index].delivery.delivered = NO;
     }
 }
 